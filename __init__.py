@@ -14,37 +14,52 @@ from esphome.components import number as number_comp
 from esphome.components import text as text_comp
 from esphome.components import button as button_comp
 from esphome.components import text_sensor
+from esphome.components import web_server_base
+from esphome.components.web_server_base import CONF_WEB_SERVER_BASE_ID
 from esphome.const import (
     CONF_ID,
     CONF_TIME_ID,
     CONF_UPDATE_INTERVAL,
     CONF_FILE,
     CONF_RAW_DATA_ID,
+    CONF_INTERVAL,
+    CONF_PORT,
+    CONF_PROTOCOL,
+    CONF_TIMEOUT,
 )
 from esphome import automation
 from esphome.core import CORE, HexInt, EsphomeError
+from .settings_table import SETTINGS_BY_ID, header_is_current
 
 _LOGGER = logging.getLogger(__name__)
 
 # CRITICAL: Set entity counts at module level (import time) so ESPHome sizes StaticVectors correctly.
 # Entity counts from this component:
-#   - 11 switches (8 screen + 3 config)  — LMSwitch IS a Component (registered via register_component)
-#   - 10 selects, 12 numbers, 11 text, 1 button, 2 text sensors — NOT Components (no register_component)
+#   - 14 switches (9 screen + 5 config)  — LMSwitch IS a Component (registered via register_component)
+#   - 10 selects, 13 numbers, 13 text, 1 button, 2 text sensors — NOT Components (no register_component)
 # ESPHOME_COMPONENT_COUNT is auto-generated by ESPHome (~38 total); no override needed.
 cg.add_define("USE_SWITCH")
-cg.add_define("ESPHOME_ENTITY_SWITCH_COUNT", 11)
+cg.add_define("ESPHOME_ENTITY_SWITCH_COUNT", 14)
 cg.add_define("USE_SELECT")
 cg.add_define("ESPHOME_ENTITY_SELECT_COUNT", 10)
 cg.add_define("USE_NUMBER")
-cg.add_define("ESPHOME_ENTITY_NUMBER_COUNT", 12)
+cg.add_define("ESPHOME_ENTITY_NUMBER_COUNT", 13)
 cg.add_define("USE_TEXT")
-cg.add_define("ESPHOME_ENTITY_TEXT_COUNT", 11)
+cg.add_define("ESPHOME_ENTITY_TEXT_COUNT", 13)
 cg.add_define("USE_BUTTON")
 cg.add_define("ESPHOME_ENTITY_BUTTON_COUNT", 1)
 cg.add_define("USE_TEXT_SENSOR")
 cg.add_define("ESPHOME_ENTITY_TEXT_SENSOR_COUNT", 2)
 
-AUTO_LOAD = ["switch", "select", "number", "text", "button", "text_sensor"]
+
+def AUTO_LOAD():
+    # socket is only needed by the live: UDP receiver, so other builds don't pull it in
+    load = ["switch", "select", "number", "text", "button", "text_sensor"]
+    conf = (CORE.raw_config or {}).get("life_matrix")
+    if isinstance(conf, dict) and CONF_LIVE in conf:
+        load.append("socket")
+    return load
+
 
 CONF_DISPLAY = "display"
 CONF_STATUS_LED = "status_led"
@@ -55,6 +70,24 @@ CONF_GRID_HEIGHT = "grid_height"
 CONF_SCREEN_CYCLE_TIME = "screen_cycle_time"
 CONF_GOL_FINAL_GENERATION_SENSOR = "gol_final_generation_sensor"
 CONF_GOL_FINAL_POPULATION_SENSOR = "gol_final_population_sensor"
+CONF_GOL_SOUP_RATE_SENSOR = "gol_soup_rate_sensor"
+CONF_INPUT_LATENCY_SENSOR = "input_latency_sensor"
+CONF_SLEEP_CPU_SAVED_SENSOR = "sleep_cpu_saved_sensor"
+CONF_HEAP_FRAGMENTATION_SENSOR = "heap_fragmentation_sensor"
+CONF_SLEEP_SCHEDULE = "sleep_schedule"
+CONF_POWER_LIMIT = "power_limit"
+CONF_MAX_CURRENT = "max_current"
+CONF_CHANNEL_CURRENT = "channel_current"
+CONF_IDLE_CURRENT = "idle_current"
+CONF_CURRENT_SENSOR = "current_sensor"
+CONF_SNAPSHOT = "snapshot"
+CONF_LIVE = "live"
+CONF_SOAK = "soak"
+CONF_STEP_INTERVAL = "step_interval"
+CONF_REPORT_INTERVAL = "report_interval"
+CONF_UNIVERSE = "universe"
+CONF_LATENCY_SENSOR = "latency_sensor"
+CONF_DROPPED_SENSOR = "dropped_sensor"
 CONF_SCREENS = "screens"
 CONF_YEAR = "year"
 CONF_MONTH = "month"
@@ -64,24 +97,54 @@ CONF_HABITS = "habits"
 CONF_GAME_OF_LIFE = "game_of_life"
 CONF_CONWAY = "conway"
 CONF_POMODORO = "pomodoro"
+CONF_SENSORS = "sensors"
 CONF_LIFESPAN = "lifespan"
 CONF_ENABLED = "enabled"
+CONF_INCLUDE = "include"
 CONF_COMPLEX_PATTERNS = "complex_patterns"
 CONF_AUTO_RESET_ON_STABLE = "auto_reset_on_stable"
 CONF_STABILITY_TIMEOUT = "stability_timeout"
 CONF_DEMO_MODE = "demo_mode"
+CONF_SOUP_SEARCH = "soup_search"
+CONF_REWIND_MEMORY = "rewind_memory"
+CONF_PATTERNS = "patterns"
+CONF_RLE = "rle"
+CONF_X = "x"
+CONF_Y = "y"
 CONF_TIME_SEGMENTS = "time_segments"
 CONF_BED_TIME_HOUR = "bed_time_hour"
+CONF_WAKE_TIME_HOUR = "wake_time_hour"
 CONF_WORK_START_HOUR = "work_start_hour"
 CONF_WORK_END_HOUR = "work_end_hour"
 CONF_STYLE = "style"
 CONF_GRADIENT_TYPE = "gradient_type"
 CONF_TEXT_AREA_POSITION = "text_area_position"
 CONF_FILL_DIRECTION = "fill_direction"
+CONF_PALETTE_RENDER = "palette_render"
+CONF_NATIVE_CANVAS = "native_canvas"
+CONF_PREWARM_SCREENS = "prewarm_screens"
+CONF_CELEBRATION = "celebration"
+CONF_TRANSITION = "transition"
+CONF_DURATION = "duration"
+CONF_EASING = "easing"
 CONF_YEAR_EVENTS = "year_events"
 CONF_EXERCISE_LIST = "exercise_list"
+CONF_HABIT_LIST = "habit_list"
 CONF_POMO_EVENT_SENSOR = "pomo_event_sensor"
 CONF_POMO_EX_SENSOR = "pomo_exercise_sensor"
+CONF_POMODORO_HEATMAP = "pomodoro_heatmap"
+CONF_SENSOR_GRAPHS = "sensor_graphs"
+CONF_SENSOR = "sensor"
+CONF_LABEL = "label"
+CONF_SAMPLES = "samples"
+CONF_SAMPLE_INTERVAL = "sample_interval"
+CONF_LIMITS = "limits"
+CONF_DATES = "dates"
+CONF_RANGES = "ranges"
+CONF_MILESTONES_LIMIT = "milestones"
+CONF_CUSTOM_PHASES_LIMIT = "custom_phases"
+CONF_EXERCISES = "exercises"
+CONF_LABEL_LENGTH = "label_length"
 
 # Icon configuration keys
 CONF_ICONS = "icons"
@@ -103,6 +166,7 @@ CONF_LS_PARENTS         = "parents"
 CONF_LS_SIBLINGS        = "siblings"
 CONF_LS_PARTNER_RANGES  = "partner_ranges"
 CONF_LS_MARRIAGE_RANGES = "marriage_ranges"
+CONF_LS_CUSTOM_PHASES   = "custom_phases"
 CONF_LS_MILESTONES      = "milestones"
 CONF_LS_RETIREMENT      = "retirement"
 CONF_LS_LIFE_EXPECTANCY = "life_expectancy_age"
@@ -127,33 +191,136 @@ NumberMode        = number_ns.enum("NumberMode")
 text_ns           = cg.esphome_ns.namespace("text")
 TextMode          = text_ns.enum("TextMode")
 
+
+
+def setting_options(setting_id):
+    """HA option strings of a select row of settings_table.SETTINGS."""
+    return list(SETTINGS_BY_ID[setting_id].options)
+
+
 # Enums
 DisplayStyle = life_matrix_ns.enum("DisplayStyle")
-DISPLAY_STYLES = {
-    "Single Color": 0,
-    "Gradient": 1,
-    "Time Segments": 2,
-    "Rainbow": 3,
-}
+DISPLAY_STYLES = {name: i for i, name in enumerate(setting_options("SET_STYLE"))}
 
+# enabled: initial state of the screen's switch. include: false leaves the view's code,
+# buffers and assets out of the firmware (and drops its switch and entities).
 SCREEN_SCHEMA = cv.Schema({
     cv.Optional(CONF_ENABLED, default=True): cv.boolean,
+    cv.Optional(CONF_INCLUDE, default=True): cv.boolean,
+})
+
+# screens: key -> define that compiles the view out
+SCREEN_EXCLUDE_DEFINES = {
+    CONF_YEAR:     "LIFE_MATRIX_NO_YEAR",
+    CONF_MONTH:    "LIFE_MATRIX_NO_MONTH",
+    CONF_DAY:      "LIFE_MATRIX_NO_DAY",
+    CONF_HOUR:     "LIFE_MATRIX_NO_HOUR",
+    CONF_HABITS:   "LIFE_MATRIX_NO_HABITS",
+    CONF_LIFESPAN: "LIFE_MATRIX_NO_LIFESPAN",
+    CONF_CONWAY:   "LIFE_MATRIX_NO_GOL",
+    CONF_POMODORO: "LIFE_MATRIX_NO_POMODORO",
+    CONF_SENSORS:  "LIFE_MATRIX_NO_SENSORS",
+}
+
+# CelebrationStyle values; effects left out of `celebration` are compiled out
+CELEBRATION_STYLES = {
+    "Sparkle": 0,
+    "Plasma": 1,
+    "Fireworks": 2,
+    "Hue Cycle": 3,
+}
+CELEBRATION_EXCLUDE_DEFINES = {
+    "Plasma":    "LIFE_MATRIX_NO_PLASMA",
+    "Fireworks": "LIFE_MATRIX_NO_FIREWORKS",
+}
+
+# One graphed sensor: `samples` of history folded into up to 120 min/max bins (8 B each);
+# sample_interval 0 records every state update instead of polling
+SENSOR_GRAPH_SCHEMA = cv.Schema({
+    cv.Required(CONF_SENSOR): cv.use_id(sensor.Sensor),
+    cv.Optional(CONF_LABEL, default=""): cv.string,
+    cv.Optional(CONF_SAMPLES, default=240): cv.int_range(min=8, max=4096),
+    cv.Optional(CONF_SAMPLE_INTERVAL, default="60s"): cv.positive_time_period_milliseconds,
 })
 
+# Panel current budget in mA. channel_current is one fully lit R, G or B channel at full
+# brightness (HUB75 1/16-scan: ~0.6 mA); idle_current covers the panel's drivers and logic.
+POWER_LIMIT_SCHEMA = cv.Schema({
+    cv.Required(CONF_MAX_CURRENT): cv.int_range(min=100, max=100000),
+    cv.Optional(CONF_CHANNEL_CURRENT, default=0.6): cv.positive_float,
+    cv.Optional(CONF_IDLE_CURRENT, default=100): cv.int_range(min=0, max=10000),
+    cv.Optional(CONF_CURRENT_SENSOR): cv.use_id(sensor.Sensor),
+})
+
+# GET /snapshot.png on the device's web server: the presented frame at 4x. Encoded at
+# most once per interval, and only while someone keeps fetching it.
+SNAPSHOT_SCHEMA = cv.All(
+    cv.Schema({
+        cv.GenerateID(CONF_WEB_SERVER_BASE_ID): cv.use_id(web_server_base.WebServerBase),
+        cv.Optional(CONF_INTERVAL, default="5s"): cv.positive_time_period_milliseconds,
+    }),
+    cv.requires_component("web_server_base"),
+)
+
+LIVE_PROTOCOLS = {
+    "ddp": 0,
+    "e131": 1,
+}
+LIVE_DEFAULT_PORTS = {"ddp": 4048, "e131": 5568}
+
+# Raw RGB frames over UDP take over the panel; screens resume `timeout` after the last packet
+LIVE_SCHEMA = cv.Schema({
+    cv.Optional(CONF_PROTOCOL, default="ddp"): cv.one_of(*LIVE_PROTOCOLS, lower=True),
+    cv.Optional(CONF_PORT): cv.port,
+    cv.Optional(CONF_TIMEOUT, default="2s"): cv.positive_time_period_milliseconds,
+    cv.Optional(CONF_UNIVERSE, default=1): cv.int_range(min=1, max=63999),  # E1.31 first universe
+    cv.Optional(CONF_LATENCY_SENSOR): cv.use_id(sensor.Sensor),
+    cv.Optional(CONF_DROPPED_SENSOR): cv.use_id(sensor.Sensor),
+})
+
+# Test firmware only: scripted churn of screens, settings, config text, celebrations and
+# pomodoro, with heap and p99 timing logged per report window. NVS writes are disabled.
+SOAK_SCHEMA = cv.Schema({
+    cv.Optional(CONF_STEP_INTERVAL, default="1s"): cv.positive_time_period_milliseconds,
+    cv.Optional(CONF_REPORT_INTERVAL, default="60s"): cv.positive_time_period_milliseconds,
+})
+
+# RLE pattern (file or inline), packed into a flash bitmap; x/y default to the grid centre
+PATTERN_SCHEMA = cv.All(cv.Schema({
+    cv.Exclusive(CONF_FILE, "source"): cv.file_,
+    cv.Exclusive(CONF_RLE, "source"): cv.string,
+    cv.Optional(CONF_X): cv.int_range(min=0, max=255),
+    cv.Optional(CONF_Y): cv.int_range(min=0, max=4095),
+    cv.GenerateID(CONF_RAW_DATA_ID): cv.declare_id(cg.uint8),
+}), cv.has_exactly_one_key(CONF_FILE, CONF_RLE))
+
 GAME_OF_LIFE_SCHEMA = cv.Schema({
     cv.Optional(CONF_UPDATE_INTERVAL, default="200ms"): cv.positive_time_period_milliseconds,
     cv.Optional(CONF_COMPLEX_PATTERNS, default=False): cv.boolean,
     cv.Optional(CONF_AUTO_RESET_ON_STABLE, default=True): cv.boolean,
     cv.Optional(CONF_STABILITY_TIMEOUT, default="60s"): cv.positive_time_period_milliseconds,
     cv.Optional(CONF_DEMO_MODE, default=False): cv.boolean,
+    cv.Optional(CONF_SOUP_SEARCH, default=False): cv.boolean,  # background search for long-lived seeds
+    cv.Optional(CONF_REWIND_MEMORY, default=16384): cv.int_range(min=0, max=262144),  # bytes, 0 = off
+    # Replaces the built-in complex_patterns layout when given
+    cv.Optional(CONF_PATTERNS): cv.All(cv.ensure_list(PATTERN_SCHEMA), cv.Length(max=16)),
 })
 
 TIME_SEGMENTS_SCHEMA = cv.Schema({
     cv.Optional(CONF_BED_TIME_HOUR, default=22): cv.int_range(min=0, max=23),
+    cv.Optional(CONF_WAKE_TIME_HOUR, default=6): cv.int_range(min=0, max=23),
     cv.Optional(CONF_WORK_START_HOUR, default=9): cv.int_range(min=0, max=23),
     cv.Optional(CONF_WORK_END_HOUR, default=17): cv.int_range(min=0, max=23),
 })
 
+TRANSITION_SCHEMA = cv.Schema({
+    cv.Optional(CONF_STYLE, default="None"): cv.one_of("None", "Crossfade", "Slide", upper=False),
+    cv.Optional(CONF_DURATION, default="400ms"): cv.positive_time_period_milliseconds,
+    cv.Optional(CONF_EASING, default="Ease In-Out"): cv.one_of("Linear", "Ease In-Out", "Ease Out", upper=False),
+})
+
+# Ages are calendar-year offsets from the birth year. Date ranges (partner, marriage,
+# custom phases) fill whole years in the decade/year views and exact days when zoomed.
 LIFESPAN_SCHEMA = cv.Schema({
     cv.Required(CONF_LS_BIRTHDAY):                          cv.string,
     cv.Optional(CONF_LS_MOVED_OUT):                         cv.int_range(min=14, max=40),
@@ -163,6 +330,7 @@ LIFESPAN_SCHEMA = cv.Schema({
     cv.Optional(CONF_LS_SIBLINGS):                          cv.string,
     cv.Optional(CONF_LS_PARTNER_RANGES):                    cv.string,
     cv.Optional(CONF_LS_MARRIAGE_RANGES):                   cv.string,
+    cv.Optional(CONF_LS_CUSTOM_PHASES):                     cv.string,
     cv.Optional(CONF_LS_MILESTONES):                        cv.string,
     cv.Optional(CONF_LS_RETIREMENT):                        cv.int_range(min=50, max=90),
     cv.Optional(CONF_LS_LIFE_EXPECTANCY, default=90):       cv.int_range(min=40, max=110),
@@ -171,13 +339,35 @@ LIFESPAN_SCHEMA = cv.Schema({
 })
 
 ICON_SCHEMA = cv.Schema({
-    cv.Required(CONF_ICON_ID): cv.string,
+    cv.Required(CONF_ICON_ID): cv.All(cv.string, cv.Length(min=1, max=23)),
     cv.Exclusive(CONF_FILE, "source"): cv.file_,
     cv.Exclusive(CONF_URL, "source"): cv.url,
     cv.Exclusive(CONF_LAMEID, "source"): cv.string,
     cv.GenerateID(CONF_RAW_DATA_ID): cv.declare_id(cg.uint16),
 })
 
+# Capacities of the inline config tables. Entries past a limit are dropped with a warning;
+# raising one costs RAM for its whole table, used or not.
+LIMITS_SCHEMA = cv.Schema({
+    cv.Optional(CONF_YEAR_EVENTS, default=48): cv.int_range(min=3, max=255),     # text + birthdays
+    cv.Optional(CONF_DATES, default=8): cv.int_range(min=1, max=32),             # kids, siblings
+    cv.Optional(CONF_RANGES, default=4): cv.int_range(min=1, max=16),            # partner, marriage
+    cv.Optional(CONF_MILESTONES_LIMIT, default=16): cv.int_range(min=1, max=64),
+    cv.Optional(CONF_CUSTOM_PHASES_LIMIT, default=16): cv.int_range(min=1, max=55),
+    cv.Optional(CONF_EXERCISES, default=16): cv.int_range(min=1, max=64),
+    cv.Optional(CONF_LABEL_LENGTH, default=16): cv.int_range(min=8, max=64),     # incl. NUL
+})
+
+LIMIT_DEFINES = {
+    CONF_YEAR_EVENTS:         "LIFE_MATRIX_MAX_YEAR_EVENTS",
+    CONF_DATES:               "LIFE_MATRIX_MAX_LIFE_DATES",
+    CONF_RANGES:              "LIFE_MATRIX_MAX_LIFE_RANGES",
+    CONF_MILESTONES_LIMIT:    "LIFE_MATRIX_MAX_MILESTONES",
+    CONF_CUSTOM_PHASES_LIMIT: "LIFE_MATRIX_MAX_CUSTOM_PHASES",
+    CONF_EXERCISES:           "LIFE_MATRIX_MAX_EXERCISES",
+    CONF_LABEL_LENGTH:        "LIFE_MATRIX_LABEL_LEN",
+}
+
 CONFIG_SCHEMA = cv.Schema({
     cv.GenerateID(): cv.declare_id(LifeMatrix),
     cv.Optional(CONF_DISPLAY): cv.use_id(display.Display),
@@ -191,6 +381,10 @@ CONFIG_SCHEMA = cv.Schema({
     # Optional sensors
     cv.Optional(CONF_GOL_FINAL_GENERATION_SENSOR): cv.use_id(sensor.Sensor),
     cv.Optional(CONF_GOL_FINAL_POPULATION_SENSOR): cv.use_id(sensor.Sensor),
+    cv.Optional(CONF_GOL_SOUP_RATE_SENSOR): cv.use_id(sensor.Sensor),
+    cv.Optional(CONF_INPUT_LATENCY_SENSOR): cv.use_id(sensor.Sensor),
+    cv.Optional(CONF_SLEEP_CPU_SAVED_SENSOR): cv.use_id(sensor.Sensor),
+    cv.Optional(CONF_HEAP_FRAGMENTATION_SENSOR): cv.use_id(sensor.Sensor),
 
     # Grid dimensions
     cv.Optional(CONF_GRID_WIDTH, default=32): cv.int_range(min=8, max=256),
@@ -207,6 +401,7 @@ CONFIG_SCHEMA = cv.Schema({
         cv.Optional(CONF_LIFESPAN): SCREEN_SCHEMA,
         cv.Optional(CONF_CONWAY):  SCREEN_SCHEMA,
         cv.Optional(CONF_POMODORO): SCREEN_SCHEMA,
+        cv.Optional(CONF_SENSORS): SCREEN_SCHEMA,
     }),
 
     # Game of Life settings
@@ -214,30 +409,60 @@ CONFIG_SCHEMA = cv.Schema({
 
     # Time segments
     cv.Optional(CONF_TIME_SEGMENTS): TIME_SEGMENTS_SCHEMA,
+    # Blank the panel and idle between bed_time_hour and wake_time_hour
+    cv.Optional(CONF_SLEEP_SCHEDULE, default=False): cv.boolean,
+
+    # Scale brightness down when the estimated panel current exceeds the budget (needs display)
+    cv.Optional(CONF_POWER_LIMIT): POWER_LIMIT_SCHEMA,
+    cv.Optional(CONF_SNAPSHOT): SNAPSHOT_SCHEMA,
+    cv.Optional(CONF_LIVE): LIVE_SCHEMA,
+    cv.Optional(CONF_SOAK): SOAK_SCHEMA,
 
     # Lifespan view (biographical data — YAML only, not exposed to HA dashboard)
     cv.Optional(CONF_LIFESPAN): LIFESPAN_SCHEMA,
 
     # Visual styling
     cv.Optional(CONF_STYLE, default="Single Color"): cv.enum(DISPLAY_STYLES, upper=False),
-    cv.Optional(CONF_GRADIENT_TYPE, default="Red-Blue"): cv.string,
-    cv.Optional(CONF_TEXT_AREA_POSITION, default="Top"): cv.one_of("Top", "Bottom", "None", upper=False),
-    cv.Optional(CONF_FILL_DIRECTION, default="Bottom to Top"): cv.one_of("Bottom to Top", "Top to Bottom", upper=False),
+    cv.Optional(CONF_GRADIENT_TYPE, default="Red-Blue"): cv.one_of(*setting_options("SET_GRADIENT"), upper=False),
+    cv.Optional(CONF_TEXT_AREA_POSITION, default="Top"): cv.one_of(*setting_options("SET_TEXT_AREA"), upper=False),
+    cv.Optional(CONF_FILL_DIRECTION, default="Bottom to Top"):
+        cv.one_of(*setting_options("SET_FILL_DIRECTION"), upper=False),
+    cv.Optional(CONF_PALETTE_RENDER, default=False): cv.boolean,
+    cv.Optional(CONF_NATIVE_CANVAS, default=True): cv.boolean,
+    cv.Optional(CONF_PREWARM_SCREENS, default=True): cv.boolean,
+    cv.Optional(CONF_TRANSITION): TRANSITION_SCHEMA,
+    # Event celebration: effects played in order (up to 4)
+    cv.Optional(CONF_CELEBRATION, default=["Hue Cycle"]): cv.All(
+        cv.ensure_list(cv.one_of(*CELEBRATION_STYLES, upper=False)),
+        cv.Length(min=1, max=4),
+    ),
     
-    cv.Optional("marker_style", default="Single Dot"): cv.string,
-    cv.Optional("marker_color", default="Blue"): cv.string,
-    cv.Optional("day_fill", default="Shaded"): cv.string,
-    cv.Optional("year_event_style", default="Markers"): cv.string,
-    cv.Optional("conway_speed", default="Normal (200ms)"): cv.string,
-    cv.Optional("pomodoro_preset", default="Classic (25/5)"): cv.string,
+    cv.Optional("marker_style", default="Single Dot"): cv.one_of(*setting_options("SET_MARKER_STYLE"), upper=False),
+    cv.Optional("marker_color", default="Blue"): cv.one_of(*setting_options("SET_MARKER_COLOR"), upper=False),
+    cv.Optional("day_fill", default="Shaded"): cv.one_of(*setting_options("SET_DAY_FILL"), upper=False),
+    cv.Optional("year_event_style", default="Markers"): cv.one_of(*setting_options("SET_YEAR_EVENTS"), upper=False),
+    cv.Optional("conway_speed", default="Normal (200ms)"): cv.one_of(*setting_options("SET_GOL_SPEED"), upper=False),
+    cv.Optional("pomodoro_preset", default="Classic (25/5)"):
+        cv.one_of(*setting_options("SET_POMO_PRESET"), upper=False),
 
     # Initial values for auto-generated text entities
     cv.Optional(CONF_YEAR_EVENTS, default=""): cv.string,
     cv.Optional(CONF_EXERCISE_LIST, default=""): cv.string,
 
+    # Habits screen: comma-separated habit names (max 8); history is kept in NVS
+    cv.Optional(CONF_HABIT_LIST, default=""): cv.string,
+
     # Pomodoro text sensor wiring
     cv.Optional(CONF_POMO_EVENT_SENSOR): cv.use_id(text_sensor.TextSensor),
     cv.Optional(CONF_POMO_EX_SENSOR): cv.use_id(text_sensor.TextSensor),
+    # Sensor graph screen (up to 4 series)
+    cv.Optional(CONF_SENSOR_GRAPHS): cv.All(
+        cv.ensure_list(SENSOR_GRAPH_SCHEMA),
+        cv.Length(max=4),
+    ),
+
+    # Overlay logged focus time on the year and month views
+    cv.Optional(CONF_POMODORO_HEATMAP, default=False): cv.boolean,
 
     # Icon configuration
     cv.Optional(CONF_ICONS): cv.All(
@@ -245,6 +470,8 @@ CONFIG_SCHEMA = cv.Schema({
         cv.Length(max=MAX_ICONS),
     ),
     cv.Optional(CONF_ICON_CACHE, default=True): cv.boolean,
+
+    cv.Optional(CONF_LIMITS, default={}): LIMITS_SCHEMA,
 }).extend(cv.COMPONENT_SCHEMA)
 
 # ---------------------------------------------------------------------------
@@ -280,6 +507,56 @@ def _fnv1_hash(s: str) -> int:
     return h
 
 
+def _parse_rle(text: str, default_name: str):
+    """Decode a Life RLE pattern → (name, width, height, set of (x, y) live cells)."""
+    name = default_name
+    width = height = None
+    body = []
+    for line in text.splitlines():
+        line = line.strip()
+        if not line:
+            continue
+        if line.startswith("#"):
+            if line[:2] in ("#N", "#n") and line[2:].strip():
+                name = line[2:].strip()
+            continue
+        if width is None and line.replace(" ", "").startswith("x="):
+            fields = dict(f.split("=", 1) for f in line.replace(" ", "").split(",") if "=" in f)
+            width, height = int(fields["x"]), int(fields["y"])
+            rule = fields.get("rule", "B3/S23").upper()
+            if rule not in ("B3/S23", "23/3"):
+                _LOGGER.warning("life_matrix: RLE '%s' uses rule %s; it will run as B3/S23", name, rule)
+            continue
+        body.append(line)
+
+    cells = set()
+    x = y = 0
+    run = ""
+    for c in "".join(body):
+        if c == "!":
+            break
+        if c.isdigit():
+            run += c
+            continue
+        n = int(run) if run else 1
+        run = ""
+        if c in "b.":
+            x += n
+        elif c == "$":
+            x = 0
+            y += n
+        elif c.isalpha():
+            cells.update((x + i, y) for i in range(n))
+            x += n
+        elif not c.isspace():
+            raise EsphomeError(f"life_matrix: RLE '{name}': unexpected character '{c}'")
+    if not cells:
+        raise EsphomeError(f"life_matrix: RLE '{name}' has no live cells")
+    width = max(width or 0, max(cx for cx, _ in cells) + 1)
+    height = max(height or 0, max(cy for _, cy in cells) + 1)
+    return name, width, height, cells
+
+
 def _configure_text_sensor(var, name: str, internal: bool = False) -> None:
     """Emit configure_entity_() on a raw TextSensor (called inside setup() which is a friend)."""
     oid = _make_object_id(name)
@@ -306,6 +583,14 @@ async def gen_switch(obj_id, name, icon, restore_on=True):
     return var
 
 
+def bind_entity(var, setter, entity):
+    """Wire a generated entity: SettingID names bind a settings row, others call the setter."""
+    if setter.startswith("SET_"):
+        cg.add(var.bind_setting(cg.RawExpression(f"life_matrix::{setter}"), entity))
+    else:
+        cg.add(getattr(var, setter)(entity))
+
+
 async def gen_select(obj_id, name, icon, options, initial):
     """Generate an LMSelect with the given parameters."""
     id_ = cv.declare_id(LMSelect)(obj_id)
@@ -401,46 +686,37 @@ SCREEN_SWITCHES = [
     (5, "Screens: Lifespan View", "show_lifespan", "mdi:timeline-clock",     True),
     (6, "Screens: Game of Life",  "show_conway",   "mdi:grid",               True),
     (7, "Screens: Pomodoro",      "show_pomodoro", "mdi:timer",              False),
+    (8, "Screens: Sensor Graphs", "show_sensors",  "mdi:chart-line",         False),
 ]
 
-# (obj_id, name, icon, options, conf_key, setter)
+# Game of Life entities, left out with the conway screen
+GOL_ENTITIES = {"conway_speed", "gol_complex_patterns", "gol_rle"}
+# Pomodoro entities, left out with the pomodoro screen
+POMODORO_ENTITIES = {"pomodoro_preset", "exercise_snacks", "pomodoro_rounds", "exercise_list", "pomo_test_phase"}
+
+# Entities named by a SettingID bind to that row of settings_table.SETTINGS (generated into
+# SETTING_TABLE in settings_table.h), which owns the object id, options, range and NVS key.
+
+# (setting, name, icon, conf_key)
 SELECTS = [
-    ("text_area_position", "Appearance: Text Area",      "mdi:format-align-top",
-     ["Top", "Bottom", "None"], CONF_TEXT_AREA_POSITION,
-     "set_ha_text_area_position"),
-    ("fill_direction", "Appearance: Fill Direction", "mdi:arrow-up-down",
-     ["Bottom to Top", "Top to Bottom"], CONF_FILL_DIRECTION,
-     "set_ha_fill_direction"),
-    ("gradient_type", "Appearance: Gradient Type", "mdi:gradient-vertical",
-     ["Red-Blue", "Green-Yellow", "Cyan-Magenta", "Purple-Orange", "Blue-Yellow"],
-     CONF_GRADIENT_TYPE,
-     "set_ha_gradient_type"),
-    ("marker_style", "Appearance: Marker Style", "mdi:marker",
-     ["None", "Single Dot", "Gradient Peak"], "marker_style",
-     "set_ha_marker_style"),
-    ("marker_color", "Appearance: Marker Color", "mdi:palette",
-     ["Blue", "White", "Yellow", "Red", "Green", "Cyan", "Magenta"],
-     "marker_color",
-     "set_ha_marker_color"),
-    ("day_fill", "Appearance: Day Fill", "mdi:calendar-blank",
-     ["Fixed", "Flat", "Shaded"], "day_fill",
-     "set_ha_day_fill"),
-    ("year_event_style", "Appearance: Year Events", "mdi:calendar-star",
-     ["None", "Pulse", "Markers"], "year_event_style",
-     "set_ha_year_event_style"),
-    ("conway_speed", "Game of Life: Speed", "mdi:speedometer",
-     ["Fast (50ms)", "Normal (200ms)", "Slow (1000ms)"], "conway_speed",
-     "set_ha_conway_speed"),
-    ("pomodoro_preset", "Pomodoro: Preset", "mdi:timer-outline",
-     ["Classic (25/5)", "Deep Work (50/10)", "Ultradian (90/20)"], "pomodoro_preset",
-     "set_ha_pomo_preset"),
+    ("SET_TEXT_AREA",      "Appearance: Text Area",      "mdi:format-align-top",   CONF_TEXT_AREA_POSITION),
+    ("SET_FILL_DIRECTION", "Appearance: Fill Direction", "mdi:arrow-up-down",      CONF_FILL_DIRECTION),
+    ("SET_GRADIENT",       "Appearance: Gradient Type",  "mdi:gradient-vertical",  CONF_GRADIENT_TYPE),
+    ("SET_MARKER_STYLE",   "Appearance: Marker Style",   "mdi:marker",             "marker_style"),
+    ("SET_MARKER_COLOR",   "Appearance: Marker Color",   "mdi:palette",            "marker_color"),
+    ("SET_DAY_FILL",       "Appearance: Day Fill",       "mdi:calendar-blank",     "day_fill"),
+    ("SET_YEAR_EVENTS",    "Appearance: Year Events",    "mdi:calendar-star",      "year_event_style"),
+    ("SET_GOL_SPEED",      "Game of Life: Speed",        "mdi:speedometer",        "conway_speed"),
+    ("SET_POMO_PRESET",    "Pomodoro: Preset",           "mdi:timer-outline",      "pomodoro_preset"),
 ]
 
-# (obj_id, name, icon, default_restore_on, conf_key, setter)
+# (setting, name, icon, default_restore_on, conf_key)
 CONFIG_SWITCHES = [
-    ("show_future",          "Appearance: Show Future",        "mdi:eye-outline", True,  None, "set_ha_show_future"),
-    ("gol_complex_patterns", "Game of Life: Complex Patterns", "mdi:puzzle",      False, None, "set_ha_complex_patterns"),
-    ("exercise_snacks",      "Pomodoro: Exercise Snacks",      "mdi:run",         True,  None, "set_ha_exercise_snacks"),
+    ("SET_SHOW_FUTURE",     "Appearance: Show Future",        "mdi:eye-outline", True,  None),
+    ("SET_GOL_COMPLEX",     "Game of Life: Complex Patterns", "mdi:puzzle",      False, None),
+    ("SET_EXERCISE_SNACKS", "Pomodoro: Exercise Snacks",      "mdi:run",         True,  None),
+    ("SET_SLEEP_SCHEDULE",  "Display: Sleep Schedule",        "mdi:sleep",       False, CONF_SLEEP_SCHEDULE),
+    ("SET_SLEEP_NOW",       "Display: Sleep",                 "mdi:power-sleep", False, None),
 ]
 
 
@@ -450,9 +726,37 @@ async def to_code(config):
     # NOTE: These defines are now set at module level (above) to ensure they're
     # set before ESPHome calculates component counts.
     
+    if not header_is_current():
+        raise EsphomeError("life_matrix: settings_table.h does not match settings_table.py; "
+                           "run python3 settings_table.py in the component directory")
+
     var = cg.new_Pvariable(config[CONF_ID])
     await cg.register_component(var, config)
 
+    # Screens with include: false are compiled out; options that feed only them are errors
+    screens_cfg = config.get(CONF_SCREENS) or {}
+    excluded = {key for key, entry in screens_cfg.items() if not entry[CONF_INCLUDE]}
+    for key in sorted(excluded):
+        cg.add_define(SCREEN_EXCLUDE_DEFINES[key])
+    if CONF_CONWAY in excluded:
+        for opt in (CONF_GAME_OF_LIFE, CONF_GOL_FINAL_GENERATION_SENSOR,
+                    CONF_GOL_FINAL_POPULATION_SENSOR, CONF_GOL_SOUP_RATE_SENSOR):
+            if opt in config:
+                raise EsphomeError(f"life_matrix: {opt} needs the conway screen (screens: conway: include: true)")
+    if CONF_SENSORS in excluded and CONF_SENSOR_GRAPHS in config:
+        raise EsphomeError("life_matrix: sensor_graphs needs the sensors screen (screens: sensors: include: true)")
+    if CONF_HABITS in excluded and config[CONF_HABIT_LIST]:
+        raise EsphomeError("life_matrix: habit_list needs the habits screen (screens: habits: include: true)")
+    if CONF_POMODORO in excluded:
+        for opt in (CONF_EXERCISE_LIST, CONF_POMODORO_HEATMAP, CONF_POMO_EVENT_SENSOR, CONF_POMO_EX_SENSOR):
+            if config.get(opt):
+                raise EsphomeError(f"life_matrix: {opt} needs the pomodoro screen (screens: pomodoro: include: true)")
+    skip_entities = set()
+    if CONF_CONWAY in excluded:
+        skip_entities |= GOL_ENTITIES
+    if CONF_POMODORO in excluded:
+        skip_entities |= POMODORO_ENTITIES
+
     # Display reference (optional - component receives DisplayBuffer in render())
     if CONF_DISPLAY in config:
         disp = await cg.get_variable(config[CONF_DISPLAY])
@@ -477,6 +781,61 @@ async def to_code(config):
         sens = await cg.get_variable(config[CONF_GOL_FINAL_POPULATION_SENSOR])
         cg.add(var.set_gol_final_population_sensor(sens))
 
+    if CONF_GOL_SOUP_RATE_SENSOR in config:
+        sens = await cg.get_variable(config[CONF_GOL_SOUP_RATE_SENSOR])
+        cg.add(var.set_soup_rate_sensor(sens))
+
+    if CONF_INPUT_LATENCY_SENSOR in config:
+        sens = await cg.get_variable(config[CONF_INPUT_LATENCY_SENSOR])
+        cg.add(var.set_input_latency_sensor(sens))
+
+    if CONF_SLEEP_CPU_SAVED_SENSOR in config:
+        sens = await cg.get_variable(config[CONF_SLEEP_CPU_SAVED_SENSOR])
+        cg.add(var.set_sleep_cpu_saved_sensor(sens))
+
+    if CONF_HEAP_FRAGMENTATION_SENSOR in config:
+        sens = await cg.get_variable(config[CONF_HEAP_FRAGMENTATION_SENSOR])
+        cg.add(var.set_heap_fragmentation_sensor(sens))
+
+    # Inline config table capacities; the icon table is sized to the configured icons
+    for key, define in LIMIT_DEFINES.items():
+        cg.add_define(define, config[CONF_LIMITS][key])
+    cg.add_define("LIFE_MATRIX_MAX_ICONS", max(1, len(config.get(CONF_ICONS, []))))
+
+    if CONF_POWER_LIMIT in config:
+        pl = config[CONF_POWER_LIMIT]
+        cg.add(var.set_power_limit(pl[CONF_MAX_CURRENT], pl[CONF_CHANNEL_CURRENT], pl[CONF_IDLE_CURRENT]))
+        if CONF_CURRENT_SENSOR in pl:
+            sens = await cg.get_variable(pl[CONF_CURRENT_SENSOR])
+            cg.add(var.set_power_current_sensor(sens))
+
+    if CONF_SNAPSHOT in config:
+        snap = config[CONF_SNAPSHOT]
+        cg.add_define("USE_LIFE_MATRIX_SNAPSHOT")
+        base = await cg.get_variable(snap[CONF_WEB_SERVER_BASE_ID])
+        cg.add(var.set_snapshot_interval(snap[CONF_INTERVAL]))
+        cg.add(var.set_snapshot_web_server(base))
+
+    if CONF_LIVE in config:
+        live = config[CONF_LIVE]
+        if CONF_DISPLAY not in config:
+            raise EsphomeError("life_matrix live: requires display: (frames are blitted into it)")
+        cg.add_define("USE_LIFE_MATRIX_LIVE")
+        proto = live[CONF_PROTOCOL]
+        port = live.get(CONF_PORT, LIVE_DEFAULT_PORTS[proto])
+        cg.add(var.set_live_input(LIVE_PROTOCOLS[proto], port, live[CONF_TIMEOUT], live[CONF_UNIVERSE]))
+        if CONF_LATENCY_SENSOR in live:
+            sens = await cg.get_variable(live[CONF_LATENCY_SENSOR])
+            cg.add(var.set_live_latency_sensor(sens))
+        if CONF_DROPPED_SENSOR in live:
+            sens = await cg.get_variable(live[CONF_DROPPED_SENSOR])
+            cg.add(var.set_live_dropped_sensor(sens))
+
+    if CONF_SOAK in config:
+        soak = config[CONF_SOAK]
+        cg.add_define("USE_LIFE_MATRIX_SOAK")
+        cg.add(var.set_soak(soak[CONF_STEP_INTERVAL], soak[CONF_REPORT_INTERVAL]))
+
     # Optional fonts
     if CONF_FONT_SMALL in config:
         font_small = await cg.get_variable(config[CONF_FONT_SMALL])
@@ -497,11 +856,43 @@ async def to_code(config):
         gol_config = config[CONF_GAME_OF_LIFE]
         cg.add(var.set_game_update_interval(gol_config[CONF_UPDATE_INTERVAL]))
         cg.add(var.set_demo_mode(gol_config[CONF_DEMO_MODE]))
+        cg.add(var.set_gol_rewind_memory(gol_config[CONF_REWIND_MEMORY]))
+
+        # RLE library: each pattern becomes a packed bitmap in flash (bit 0 = leftmost cell)
+        grid_w, grid_h = config[CONF_GRID_WIDTH], config[CONF_GRID_HEIGHT]
+        for i, pat in enumerate(gol_config.get(CONF_PATTERNS, [])):
+            if CONF_FILE in pat:
+                path = CORE.relative_config_path(pat[CONF_FILE])
+                try:
+                    with open(path, encoding="utf-8") as f:
+                        text = f.read()
+                except OSError as e:
+                    raise EsphomeError(f"Could not read RLE file {path}: {e}")
+                default_name = os.path.splitext(os.path.basename(path))[0]
+            else:
+                text, default_name = pat[CONF_RLE], f"pattern {i + 1}"
+            name, w, h, cells = _parse_rle(text, default_name)
+            if w > grid_w or h > grid_h:
+                raise EsphomeError(f"life_matrix: pattern '{name}' ({w}x{h}) does not fit the {grid_w}x{grid_h} grid")
+            row_bytes = (w + 7) // 8
+            packed = [0] * (row_bytes * h)
+            for cx, cy in cells:
+                packed[cy * row_bytes + cx // 8] |= 1 << (cx % 8)
+            prog_arr = cg.progmem_array(pat[CONF_RAW_DATA_ID], [HexInt(b) for b in packed])
+            x = pat.get(CONF_X, (grid_w - w) // 2)
+            y = pat.get(CONF_Y, (grid_h - h) // 2)
+            cg.add(var.add_pattern(name, prog_arr, w, h, x, y))
+            _LOGGER.info(f"Compiled RLE pattern '{name}' ({w}x{h}, {len(packed)} bytes)")
+        if gol_config[CONF_SOUP_SEARCH]:
+            if config[CONF_GRID_WIDTH] > 32:
+                raise EsphomeError("life_matrix game_of_life: soup_search needs grid_width <= 32 (one 32-bit word per row)")
+            cg.add(var.set_soup_search(True))
 
     # Time segments (initial values; overridden at runtime via HA entity callbacks)
     if CONF_TIME_SEGMENTS in config:
         ts_config = config[CONF_TIME_SEGMENTS]
         cg.add(var.set_bed_time_hour(ts_config.get(CONF_BED_TIME_HOUR, 22)))
+        cg.add(var.set_wake_time_hour(ts_config.get(CONF_WAKE_TIME_HOUR, 6)))
         cg.add(var.set_work_start_hour(ts_config.get(CONF_WORK_START_HOUR, 9)))
         cg.add(var.set_work_end_hour(ts_config.get(CONF_WORK_END_HOUR, 17)))
 
@@ -523,6 +914,8 @@ async def to_code(config):
             cg.add(var.set_lifespan_partner_ranges(ls[CONF_LS_PARTNER_RANGES]))
         if CONF_LS_MARRIAGE_RANGES in ls:
             cg.add(var.set_lifespan_marriage_ranges(ls[CONF_LS_MARRIAGE_RANGES]))
+        if CONF_LS_CUSTOM_PHASES in ls:
+            cg.add(var.set_lifespan_custom_phases(ls[CONF_LS_CUSTOM_PHASES]))
         if CONF_LS_MILESTONES in ls:
             cg.add(var.set_lifespan_milestones(ls[CONF_LS_MILESTONES]))
         if CONF_LS_RETIREMENT in ls:
@@ -535,14 +928,46 @@ async def to_code(config):
     cg.add(var.set_text_area_position(config[CONF_TEXT_AREA_POSITION]))
     cg.add(var.set_fill_direction(config[CONF_FILL_DIRECTION]))
     cg.add(var.set_gradient_type(config[CONF_GRADIENT_TYPE]))
+    cg.add(var.set_palette_render(config[CONF_PALETTE_RENDER]))
+    cg.add(var.set_native_canvas(config[CONF_NATIVE_CANVAS]))
+    cg.add(var.set_prewarm_screens(config[CONF_PREWARM_SCREENS]))
+
+    # Celebration sequence
+    celebration = config[CONF_CELEBRATION]
+    cg.add(var.set_celebration_sequence([CELEBRATION_STYLES[c] for c in celebration]))
+    for effect, define in CELEBRATION_EXCLUDE_DEFINES.items():
+        if effect not in celebration:
+            cg.add_define(define)
+
+    # Screen transitions
+    if CONF_TRANSITION in config:
+        tr = config[CONF_TRANSITION]
+        cg.add(var.set_transition_style(tr[CONF_STYLE]))
+        cg.add(var.set_transition_duration(tr[CONF_DURATION]))
+        cg.add(var.set_transition_easing(tr[CONF_EASING]))
+
+    # Pomodoro session log heatmap
+    if CONF_POMODORO not in excluded:
+        cg.add(var.set_pomo_heatmap(config[CONF_POMODORO_HEATMAP]))
+
+    # Sensor graphs
+    for graph in config.get(CONF_SENSOR_GRAPHS, []):
+        sens = await cg.get_variable(graph[CONF_SENSOR])
+        cg.add(var.add_sensor_graph(sens, graph[CONF_LABEL], graph[CONF_SAMPLES],
+                                    graph[CONF_SAMPLE_INTERVAL]))
+
+    # Habit tracker
+    if config[CONF_HABIT_LIST]:
+        cg.add(var.set_habit_list_csv(config[CONF_HABIT_LIST]))
 
 
     # -----------------------------------------------------------------------
     # Auto-generate screen switches
     # -----------------------------------------------------------------------
-    screens_cfg = config.get(CONF_SCREENS) or {}
     for screen_id, name, obj_id, icon, default_on in SCREEN_SWITCHES:
         screen_key = obj_id.replace("show_", "")
+        if screen_key in excluded:
+            continue
         screen_entry = screens_cfg.get(screen_key)
         restore_on = screen_entry[CONF_ENABLED] if screen_entry is not None else default_on
         sw = await gen_switch(obj_id, name, icon, restore_on)
@@ -552,43 +977,37 @@ async def to_code(config):
     # Auto-generate appearance / config select entities
     # -----------------------------------------------------------------------
     # style select: initial comes from CONF_STYLE in config
-    style_names = {v: k for k, v in DISPLAY_STYLES.items()}
-    style_initial = style_names.get(config[CONF_STYLE], "Single Color")
     style_sel = await gen_select(
-        "style", "Appearance: Style", "mdi:palette",
-        ["Single Color", "Gradient", "Time Segments", "Rainbow"],
-        style_initial,
+        SETTINGS_BY_ID["SET_STYLE"].object_id, "Appearance: Style", "mdi:palette",
+        setting_options("SET_STYLE"),
+        str(config[CONF_STYLE]),
     )
-    cg.add(var.set_ha_style(style_sel))
+    bind_entity(var, "SET_STYLE", style_sel)
 
-    for obj_id, name, icon, options, conf_key, setter in SELECTS:
-        initial = options[0]  # Default fallback
-        if conf_key and conf_key in config:
-            initial = config[conf_key]
-        elif conf_key == None:
-            # For items without a specific conf_key mapping yet, try to find a default
-            if "day_fill" in obj_id: initial = "Shaded"
-            elif "marker_style" in obj_id: initial = "Single Dot"
-            elif "marker_color" in obj_id: initial = "Blue"
-            elif "year_event_style" in obj_id: initial = "Markers"
-            elif "conway_speed" in obj_id: initial = "Normal (200ms)"
-            elif "pomodoro_preset" in obj_id: initial = "Classic (25/5)"
-        sel = await gen_select(obj_id, name, icon, options, initial)
-        cg.add(getattr(var, setter)(sel))
+    for setting, name, icon, conf_key in SELECTS:
+        row = SETTINGS_BY_ID[setting]
+        if row.object_id in skip_entities:
+            continue
+        initial = config.get(conf_key, row.options[0])
+        sel = await gen_select(row.object_id, name, icon, list(row.options), initial)
+        bind_entity(var, setting, sel)
 
     # -----------------------------------------------------------------------
-    # Auto-generate config switches (show_future, complex_patterns, exercise_snacks)
+    # Auto-generate config switches (show_future, complex_patterns, exercise_snacks, sleep)
     # -----------------------------------------------------------------------
-    for obj_id, name, icon, default_restore_on, conf_key, setter in CONFIG_SWITCHES:
+    for setting, name, icon, default_restore_on, conf_key in CONFIG_SWITCHES:
+        obj_id = SETTINGS_BY_ID[setting].object_id
+        if obj_id in skip_entities:
+            continue
         restore_on = default_restore_on
         if conf_key and conf_key in config:
             restore_on = config[conf_key]
         # Handle special cases nested in config dicts
-        if obj_id == "gol_complex_patterns" and CONF_GAME_OF_LIFE in config:
+        if setting == "SET_GOL_COMPLEX" and CONF_GAME_OF_LIFE in config:
             restore_on = config[CONF_GAME_OF_LIFE].get(CONF_COMPLEX_PATTERNS, restore_on)
             
         sw = await gen_switch(obj_id, name, icon, restore_on)
-        cg.add(getattr(var, setter)(sw))
+        bind_entity(var, setting, sw)
 
     # -----------------------------------------------------------------------
     # Auto-generate number entities
@@ -596,21 +1015,26 @@ async def to_code(config):
     ts = config.get(CONF_TIME_SEGMENTS) or {}
     ls = config.get(CONF_LIFESPAN) or {}
 
+    # Settings rows: range from the table, HA step 1 (the table step is the encoder detent)
+    SETTING_NUMBERS = [
+        ("SET_BRIGHTNESS", "Display: Brightness",       "mdi:brightness-6",      20, "%"),
+        ("SET_NIGHT_MODE", "Display: Night Mode",        "mdi:weather-night",     3,  "lvl"),
+        ("SET_CYCLE_TIME", "Display: Screen Cycle Time", "mdi:timer",
+         int(config[CONF_SCREEN_CYCLE_TIME].total_seconds), "s"),
+        ("SET_BED_HOUR",   "Time Segments: Bed Hour",    "mdi:bed",               ts.get(CONF_BED_TIME_HOUR, 22), "h"),
+        ("SET_WAKE_HOUR",  "Time Segments: Wake Hour",   "mdi:weather-sunset-up", ts.get(CONF_WAKE_TIME_HOUR, 6), "h"),
+        ("SET_WORK_START", "Time Segments: Work Start",  "mdi:briefcase",         ts.get(CONF_WORK_START_HOUR, 9), "h"),
+        ("SET_WORK_END",   "Time Segments: Work End",    "mdi:briefcase-clock",   ts.get(CONF_WORK_END_HOUR, 17), "h"),
+        ("SET_POMO_ROUNDS", "Pomodoro: Rounds",          "mdi:repeat",            4,  ""),
+    ]
+    for setting, name, icon, initial, unit in SETTING_NUMBERS:
+        row = SETTINGS_BY_ID[setting]
+        if row.object_id in skip_entities:
+            continue
+        n = await gen_number(row.object_id, name, icon, row.min_value, row.max_value, 1, initial, unit)
+        bind_entity(var, setting, n)
+
     NUMBERS = [
-        ("display_brightness", "Display: Brightness",       "mdi:brightness-6",
-         1, 100, 1, 20, "%",  ENTITY_CATEGORY_CONFIG, "set_ha_display_brightness"),
-        ("night_mode_level",   "Display: Night Mode",        "mdi:weather-night",
-         0, 3,   1, 3,  "lvl", ENTITY_CATEGORY_CONFIG, "set_ha_night_mode_level"),
-        ("cycle_time_s",       "Display: Screen Cycle Time", "mdi:timer",
-         1, 60,  1, int(config[CONF_SCREEN_CYCLE_TIME].total_seconds), "s", ENTITY_CATEGORY_CONFIG, "set_ha_cycle_time"),
-        ("bed_time_hour",      "Time Segments: Bed Hour",    "mdi:bed",
-         0, 23,  1, ts.get(CONF_BED_TIME_HOUR, 22), "h", ENTITY_CATEGORY_CONFIG, "set_ha_bed_time_hour"),
-        ("work_start_hour",    "Time Segments: Work Start",  "mdi:briefcase",
-         0, 23,  1, ts.get(CONF_WORK_START_HOUR, 9), "h", ENTITY_CATEGORY_CONFIG, "set_ha_work_start_hour"),
-        ("work_end_hour",      "Time Segments: Work End",    "mdi:briefcase-clock",
-         0, 23,  1, ts.get(CONF_WORK_END_HOUR, 17), "h", ENTITY_CATEGORY_CONFIG, "set_ha_work_end_hour"),
-        ("pomodoro_rounds",    "Pomodoro: Rounds",           "mdi:repeat",
-         2, 8,   1, 4, "", ENTITY_CATEGORY_CONFIG, "set_ha_pomo_rounds"),
         ("ls_moved_out",       "Lifespan: Moved Out Age",    "mdi:home-export-outline",
          14, 40, 1, ls.get(CONF_LS_MOVED_OUT, 18),   "yr", ENTITY_CATEGORY_DIAGNOSTIC, "set_ls_moved_out_entity"),
         ("ls_school_years",    "Lifespan: School Years",     "mdi:school",
@@ -624,7 +1048,7 @@ async def to_code(config):
     ]
     for obj_id, name, icon, mn, mx, step, initial, unit, category, setter in NUMBERS:
         n = await gen_number(obj_id, name, icon, mn, mx, step, initial, unit, category)
-        cg.add(getattr(var, setter)(n))
+        bind_entity(var, setter, n)
 
     # -----------------------------------------------------------------------
     # Auto-generate text input entities
@@ -638,6 +1062,8 @@ async def to_code(config):
         # DIAGNOSTIC — testing/debug, accessible but not shown in main config
         ("time_override",      "Time Override",        "mdi:clock-edit-outline",
          "",                                  "set_time_override_entity",      ENTITY_CATEGORY_DIAGNOSTIC, False),
+        ("gol_rle",            "Game of Life: RLE",    "mdi:grid",
+         "",                                  "set_gol_rle_entity",            ENTITY_CATEGORY_DIAGNOSTIC, False),
         ("pomo_test_phase",    "Pomodoro Test Phase",  "mdi:bug",
          "",                                  "set_pomo_test_phase_entity",    ENTITY_CATEGORY_DIAGNOSTIC, False),
         # DIAGNOSTIC — biographical data, rarely changed
@@ -655,31 +1081,37 @@ async def to_code(config):
          ls.get(CONF_LS_PARTNER_RANGES, ""),  "set_ls_partner_ranges_entity",  ENTITY_CATEGORY_DIAGNOSTIC, False),
         ("ls_marriage_ranges", "Lifespan: Marriage",   "mdi:ring",
          ls.get(CONF_LS_MARRIAGE_RANGES, ""), "set_ls_marriage_ranges_entity", ENTITY_CATEGORY_DIAGNOSTIC, False),
+        ("ls_custom_phases",   "Lifespan: Custom Phases", "mdi:timeline-text",
+         ls.get(CONF_LS_CUSTOM_PHASES, ""),   "set_ls_custom_phases_entity",   ENTITY_CATEGORY_DIAGNOSTIC, False),
     ]
     for obj_id, name, icon, initial, setter, category, internal in TEXTS:
+        if obj_id in skip_entities:
+            continue
         t = await gen_text(obj_id, name, icon, initial, category, internal)
         cg.add(getattr(var, setter)(t))
 
     # -----------------------------------------------------------------------
     # Auto-generate Pomodoro Start button
     # -----------------------------------------------------------------------
-    btn = await gen_button("pomo_start_btn", "Pomodoro: Start", "mdi:timer-play")
-    cg.add(var.set_ha_pomo_start_button(btn))
+    if CONF_POMODORO not in excluded:
+        btn = await gen_button("pomo_start_btn", "Pomodoro: Start", "mdi:timer-play")
+        cg.add(var.set_ha_pomo_start_button(btn))
 
     # -----------------------------------------------------------------------
     # Auto-generate Pomodoro Event Sensors
     # ESPHome 2026+ removed runtime set_name/set_icon/set_internal from EntityBase.
     # configure_entity_() is accessible here because setup() is a friend of EntityBase.
     # -----------------------------------------------------------------------
-    pomo_event = cg.new_Pvariable(cv.declare_id(text_sensor.TextSensor)("pomo_event"))
-    _configure_text_sensor(pomo_event, "Pomodoro Event", internal=True)
-    cg.add(cg.App.register_text_sensor(pomo_event))
-    cg.add(var.set_pomo_event_sensor(pomo_event))
-
-    pomo_exercise = cg.new_Pvariable(cv.declare_id(text_sensor.TextSensor)("pomo_exercise"))
-    _configure_text_sensor(pomo_exercise, "Pomodoro Exercise", internal=True)
-    cg.add(cg.App.register_text_sensor(pomo_exercise))
-    cg.add(var.set_pomo_exercise_sensor(pomo_exercise))
+    if CONF_POMODORO not in excluded:
+        pomo_event = cg.new_Pvariable(cv.declare_id(text_sensor.TextSensor)("pomo_event"))
+        _configure_text_sensor(pomo_event, "Pomodoro Event", internal=True)
+        cg.add(cg.App.register_text_sensor(pomo_event))
+        cg.add(var.set_pomo_event_sensor(pomo_event))
+
+        pomo_exercise = cg.new_Pvariable(cv.declare_id(text_sensor.TextSensor)("pomo_exercise"))
+        _configure_text_sensor(pomo_exercise, "Pomodoro Exercise", internal=True)
+        cg.add(cg.App.register_text_sensor(pomo_exercise))
+        cg.add(var.set_pomo_exercise_sensor(pomo_exercise))
 
 
     # -----------------------------------------------------------------------
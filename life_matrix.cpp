@@ -1,7 +1,13 @@
 #include "life_matrix.h"
 #include "esphome/core/log.h"
 #include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_heap_caps.h"
+#include "esp_memory_utils.h"
 #include <cstdlib>
+#include <cstring>
 #include <ctime>
 
 namespace esphome {
@@ -9,21 +15,110 @@ namespace life_matrix {
 
 static const char *const TAG = "life_matrix";
 
+// Session log aggregate layout version, and the heatmap color (pomodoro tomato, 0xFA2A)
+static const uint16_t POMO_AGG_VERSION = 2;
+static const Color POMO_FOCUS_COLOR(255, 69, 82);
+static const uint32_t SLEEP_INPUT_HOLD_MS = 5 * 60 * 1000;  // input keeps a scheduled sleep away this long
+static const uint32_t BUSY_WINDOW_MS = 10000;
+static const uint32_t HEAP_REPORT_MS = 60000;
+
+// ============================================================================
+// MEMORY PLACEMENT
+// ============================================================================
+
+static const uint32_t CAPS_INTERNAL = MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT;
+static const uint32_t CAPS_PSRAM = MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT;
+
+// Without PSRAM the SPIRAM request just fails and cold buffers land in internal RAM.
+// Running out of both pools aborts, as the default allocator would without exceptions.
+void *placed_alloc(size_t bytes, MemPlacement where) {
+  bool hot = where == MemPlacement::HOT;
+  void *ptr = heap_caps_malloc(bytes, hot ? CAPS_INTERNAL : CAPS_PSRAM);
+  if (ptr == nullptr) ptr = heap_caps_malloc(bytes, hot ? CAPS_PSRAM : CAPS_INTERNAL);
+  if (ptr == nullptr) {
+    ESP_LOGE(TAG, "Out of memory: %u B (%s)", (unsigned)bytes, hot ? "hot" : "cold");
+    abort();
+  }
+  return ptr;
+}
+
+void placed_free(void *ptr) { heap_caps_free(ptr); }
+
+bool placed_in_psram(const void *ptr) { return ptr != nullptr && esp_ptr_external_ram(ptr); }
+
+// Adds the wall time of a scope to a µs counter (loop + render busy time)
+struct BusyScope {
+  uint64_t &acc;
+  uint32_t start_us;
+  explicit BusyScope(uint64_t &a) : acc(a), start_us(micros()) {}
+  ~BusyScope() { acc += (uint32_t)(micros() - start_us); }
+};
+
+#ifdef USE_LIFE_MATRIX_SOAK
+static const int SOAK_MINUTES_PER_STEP = 37;  // coprime with 60: every minute of the day comes round
+
+struct HistogramScope {
+  LatencyHistogram &hist;
+  uint32_t start_us;
+  explicit HistogramScope(LatencyHistogram &h) : hist(h), start_us(micros()) {}
+  ~HistogramScope() { hist.record(micros() - start_us); }
+};
+
+void LatencyHistogram::record(uint32_t us) {
+  int b = (int)us;
+  if (us >= 16) {
+    int octave = 31 - __builtin_clz(us);
+    b = 16 + (octave - 4) * 8 + (int)((us >> (octave - 3)) & 7);
+  }
+  counts[std::min(b, BUCKETS - 1)]++;
+  total++;
+  if (us > max_us) max_us = us;
+}
+
+uint32_t LatencyHistogram::percentile(float p) const {
+  if (total == 0) return 0;
+  uint32_t rank = std::max<uint32_t>(1, (uint32_t)ceilf(p * (float)total));
+  uint32_t seen = 0;
+  for (int b = 0; b < BUCKETS; b++) {
+    seen += counts[b];
+    if (seen < rank) continue;
+    if (b < 16) return (uint32_t)b;
+    uint32_t width = 1u << ((b - 16) / 8 + 1);
+    return std::min(max_us, (uint32_t)(8 + (b - 16) % 8) * width + width - 1);
+  }
+  return max_us;
+}
+#endif
+
 void LifeMatrix::setup() {
   ESP_LOGD(TAG, "Setting up Life Matrix component");
+  // Power limit and snapshot read the presented frame, which only the palette canvas holds
+  if (power_limit_enabled_ || snapshot_enabled_) palette_render_ = true;
   // Seed random number generator for Game of Life
   std::srand(std::time(nullptr));
 
+#ifndef LIFE_MATRIX_NO_GOL
   // Initialize Game of Life with default pattern
   initialize_game_of_life(game_config_.complex_patterns ? PATTERN_MIXED : PATTERN_RANDOM);
 
   // Enable demo mode on startup
   game_demo_mode_ = true;
   game_demo_start_time_ = millis();
+#endif
 
   // Set initial status LED state
   update_status_led();
 
+#ifndef LIFE_MATRIX_NO_SENSORS
+  // Sensor graphs with a fixed sample period poll the sensor's last state on a timer
+  for (size_t i = 0; i < graphs_.size(); i++) {
+    if (graphs_[i].interval_ms == 0) continue;
+    this->set_interval("graph_" + std::to_string(i), graphs_[i].interval_ms, [this, i]() {
+      if (graphs_[i].sensor->has_state()) graphs_[i].push(graphs_[i].sensor->state);
+    });
+  }
+#endif
+
   // Defer restoration until after all entity setters have been called
   this->defer([this]() {
     // Restore lifespan entities from NVS (overwrites initial values if found)
@@ -31,52 +126,78 @@ void LifeMatrix::setup() {
     // Lifespan: extract birthdays into lifespan_year_events_ and precompute active phases
     apply_lifespan_year_events();
     precompute_lifespan_phases();
+#ifndef LIFE_MATRIX_NO_POMODORO
+    // Pomodoro session log: loaded up front only for the heatmap, otherwise on first use
+    if (pomo_heatmap_) pomo_log_();
+#endif
+#ifndef LIFE_MATRIX_NO_GOL
+    // Soup search: stored best seeds, then the idle-priority task that extends them
+    if (soup_search_) soup_search_start_();
+#endif
+    report_placement_();
   });
 }
 
 void LifeMatrix::loop() {
+  BusyScope busy(busy_us_);
+#ifdef USE_LIFE_MATRIX_SOAK
+  HistogramScope soak_loop(soak_loop_hist_);
+#endif
+  if (live_port_ != 0) poll_live_();
+#ifndef LIFE_MATRIX_NO_GOL
+  if (soup_search_) update_soup_search_();
+#endif
+  if (update_sleep_()) return;
+  if (live_active_) {
+    // The stream owns the panel; screens, GoL and out-of-band redraws wait for the timeout
+#ifndef LIFE_MATRIX_NO_POMODORO
+    update_pomodoro();
+#endif
+    return;
+  }
+
+#ifdef USE_LIFE_MATRIX_SOAK
+  if (millis() - soak_step_at_ms_ >= soak_step_ms_) {
+    soak_step_at_ms_ = millis();
+    soak_step_();
+  }
+#endif
+
+#ifndef LIFE_MATRIX_NO_GOL
   bool gol_visible = (get_current_screen_id() == SCREEN_GAME_OF_LIFE);
 
-  // Handle GoL screen visibility changes (pause/resume timer)
+  // GoL keeps logical time while hidden: nothing runs then, and the missed generations are
+  // caught up in one bounded burst when the screen comes back (the stability timer just
+  // keeps running, since the soup would have kept running too)
   if (gol_visible != gol_was_visible_) {
     if (!gol_visible && gol_was_visible_) {
-      // Switching away from GoL - pause the stability timer
-      if (game_is_stable_ && game_stable_since_ > 0) {
-        game_stable_paused_elapsed_ = millis() - game_stable_since_;
-        ESP_LOGD(TAG, "Pausing GoL timer at %lu ms", game_stable_paused_elapsed_);
-      }
+      rewind_gen_ = -1;  // leaving the screen ends a scrub
+      gol_hidden_ms_ = millis();
     } else if (gol_visible && !gol_was_visible_) {
-      // Switching back to GoL - resume the stability timer
-      if (game_is_stable_ && game_stable_paused_elapsed_ > 0) {
-        game_stable_since_ = millis() - game_stable_paused_elapsed_;
-        ESP_LOGD(TAG, "Resuming GoL timer from %lu ms", game_stable_paused_elapsed_);
+      if (game_initialized_ && !game_reset_animation_ && !game_demo_mode_) {
+        catch_up_game_of_life_(millis() - gol_hidden_ms_);
       }
     }
     gol_was_visible_ = gol_visible;
   }
+#endif
 
-  // Update Game of Life only when visible and not in reset/demo state
-  if (game_initialized_ && gol_visible && !game_reset_animation_ && !game_demo_mode_) {
-    update_game_of_life();
-
-    // Check for long-standing stability and reset if needed
-    if (game_is_stable_ && game_config_.auto_reset_on_stable) {
-      unsigned long elapsed = millis() - game_stable_since_;
-      if (elapsed >= (unsigned long)game_config_.stability_timeout_ms) {
-        ESP_LOGD(TAG, "Auto-resetting Game of Life after %lu ms of stability", elapsed);
-        reset_game_of_life();
-      }
-    }
-  }
+  // Only the visible screen steps (GoL generations), and only once its next change is due
+  Screen *visible = find_screen_(get_current_screen_id());
+  uint32_t step_ms = millis();
+  if (visible != nullptr && (int32_t)(step_ms - visible->next_change_time(step_ms)) >= 0) visible->step(step_ms);
 
+#ifndef LIFE_MATRIX_NO_POMODORO
   // Update Pomodoro timer
   update_pomodoro();
+#endif
 
   // Update icon animations
   update_icon_animations();
 
   // Update screen cycling
   update_screen_cycle();
+  if (prewarm_screens_) update_prewarm_();
 
   // Check for UI timeouts
   check_ui_timeout();
@@ -89,21 +210,146 @@ void LifeMatrix::loop() {
       apply_brightness();
     }
   }
+
+  // Input arrived this iteration: draw now rather than on the display's next 50 ms poll.
+  // At most one out-of-band frame per loop() pass, however fast the encoder spins.
+  if (redraw_requested_ && display_ != nullptr) {
+    redraw_requested_ = false;
+    oob_redraws_++;
+    display_->update();
+  }
+
+  if (snapshot_enabled_) update_snapshot_();
+
+  // Switch-frame report: one summary per 8 screen switches
+  if (switch_frames_ >= 8) {
+    ESP_LOGD(TAG, "Screen switch frames: avg %u us, max %u us, steady %u us (%u/%u pre-warmed)",
+             (unsigned)(switch_frame_sum_us_ / switch_frames_), (unsigned)switch_frame_max_us_,
+             (unsigned)steady_frame_us_, switch_frames_warm_, switch_frames_);
+    switch_frame_sum_us_ = 0;
+    switch_frame_max_us_ = 0;
+    switch_frames_ = 0;
+    switch_frames_warm_ = 0;
+  }
+
+  // Latency report: one summary per 10 s window that saw input
+  uint32_t now_ms = millis();
+  if (input_latency_samples_ > 0 && now_ms - input_latency_window_ms_ >= 10000) {
+    float avg_ms = (float)input_latency_sum_us_ / (float)input_latency_samples_ / 1000.0f;
+    float max_ms = (float)input_latency_max_us_ / 1000.0f;
+    ESP_LOGD(TAG, "Input latency: %u events, avg %.1f ms, max %.1f ms (%u out-of-band frames)",
+             input_latency_samples_, avg_ms, max_ms, oob_redraws_);
+    if (input_latency_sensor_) input_latency_sensor_->publish_state(max_ms);
+    input_latency_sum_us_ = 0;
+    input_latency_max_us_ = 0;
+    input_latency_samples_ = 0;
+    oob_redraws_ = 0;
+    input_latency_window_ms_ = now_ms;
+  } else if (input_latency_samples_ == 0) {
+    input_latency_window_ms_ = now_ms;
+  }
+
+  if (now_ms - heap_report_ms_ >= HEAP_REPORT_MS) {
+    heap_report_ms_ = now_ms;
+    report_heap_();
+  }
+
+#ifdef USE_LIFE_MATRIX_SOAK
+  if (now_ms - soak_window_ms_ >= soak_report_ms_) {
+    soak_window_ms_ = now_ms;
+    soak_report_();
+  }
+#endif
+}
+
+// Fragmentation = share of the free internal heap that no single allocation can use.
+// Flat over weeks of uptime means config updates are not carving up the heap.
+void LifeMatrix::report_heap_() {
+  const uint32_t caps = MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT;
+  size_t free_b = heap_caps_get_free_size(caps);
+  size_t largest = heap_caps_get_largest_free_block(caps);
+  float frag = free_b > 0 ? 100.0f * (1.0f - (float)largest / (float)free_b) : 0.0f;
+  ESP_LOGD(TAG, "Heap: %u B free, largest block %u B (%.1f%% fragmented), low-water %u B", (unsigned)free_b,
+           (unsigned)largest, frag, (unsigned)heap_caps_get_minimum_free_size(caps));
+  if (heap_fragmentation_sensor_) heap_fragmentation_sensor_->publish_state(frag);
+}
+
+// Boot report of the large buffers: bytes held and the pool each one landed in.
+// Buffers of disabled screens and idle features show 0 B until first use.
+void LifeMatrix::report_placement_() {
+  size_t pool_bytes[2] = {0, 0};  // internal, PSRAM
+  auto row = [&](const char *name, MemPlacement want, size_t bytes, const void *ptr) {
+    bool psram = placed_in_psram(ptr);
+    if (bytes > 0) pool_bytes[psram ? 1 : 0] += bytes;
+    ESP_LOGD(TAG, "  %-18s %6u B  %s -> %s", name, (unsigned)bytes, want == MemPlacement::HOT ? "hot " : "cold",
+             bytes == 0 ? "-" : (psram ? "PSRAM" : "internal"));
+  };
+
+  ESP_LOGD(TAG, "Memory placement (PSRAM %u B total, %u B free):", (unsigned)heap_caps_get_total_size(CAPS_PSRAM),
+           (unsigned)heap_caps_get_free_size(CAPS_PSRAM));
+  row("component", MemPlacement::HOT, sizeof(LifeMatrix), this);
+  row("palette canvas", MemPlacement::HOT, palette_index_buf_.capacity(), palette_index_buf_.data());
+  row("transition frames", MemPlacement::HOT, transition_from_.bytes() + transition_to_.bytes(),
+      transition_from_.pixels());
+#ifndef LIFE_MATRIX_NO_GOL
+  row("GoL grids", MemPlacement::HOT, game_grid_.capacity() + game_grid_back_.capacity(), game_grid_.data());
+  row("GoL rewind work", MemPlacement::HOT,
+      rewind_last_.capacity() + rewind_pack_.capacity() + rewind_view_.capacity() + rewind_ages_.capacity(),
+      rewind_last_.data());
+  size_t rewind_bytes = 0;
+  const void *rewind_ptr = nullptr;
+  for (auto &seg : rewind_segments_) {
+    rewind_bytes += seg.data.capacity();
+    if (rewind_ptr == nullptr) rewind_ptr = seg.data.data();
+  }
+  row("GoL rewind", MemPlacement::COLD, rewind_bytes, rewind_ptr);
+#endif
+#ifndef LIFE_MATRIX_NO_LIFESPAN
+  size_t zoom_bytes = 0;
+  const void *zoom_ptr = nullptr;
+  for (auto &tab : lifespan_zoom_tables_) {
+    zoom_bytes += tab.marks.capacity() + tab.seg.capacity();
+    if (zoom_ptr == nullptr) zoom_ptr = tab.marks.data();
+  }
+  row("lifespan zoom", MemPlacement::COLD, zoom_bytes, zoom_ptr);
+#endif
+#ifndef LIFE_MATRIX_NO_POMODORO
+  row("pomodoro spiral", MemPlacement::COLD,
+      (pomo_spiral_x_.capacity() + pomo_spiral_y_.capacity()) * sizeof(uint16_t), pomo_spiral_x_.data());
+#endif
+  row("snapshot PNGs", MemPlacement::COLD, snapshot_png_[0].capacity() + snapshot_png_[1].capacity(),
+      snapshot_png_[0].data());
+  ESP_LOGD(TAG, "  total %u B internal, %u B PSRAM", (unsigned)pool_bytes[0], (unsigned)pool_bytes[1]);
+}
+
+// Grid size is also the canvas size of views drawn cell by cell, so it stays with GoL off
+void LifeMatrix::set_grid_dimensions(int width, int height) {
+  grid_width_ = width;
+  grid_height_ = height;
+#ifndef LIFE_MATRIX_NO_GOL
+  if (!game_grid_.empty()) {
+    game_grid_.assign((size_t)width * height, 0);
+    game_grid_back_.assign((size_t)width * height, 0);
+    game_initialized_ = false;
+  }
+#endif
+  ESP_LOGD(TAG, "Grid dimensions set to %dx%d", width, height);
 }
 
+#ifndef LIFE_MATRIX_NO_GOL
 // ============================================================================
 // GAME OF LIFE IMPLEMENTATION
 // ============================================================================
 
 uint8_t LifeMatrix::get_cell(int x, int y) {
-  if (x < 0 || x >= grid_width_ || y < 0 || y >= grid_height_) {
+  if (x < 0 || x >= grid_width_ || y < 0 || y >= grid_height_ || game_grid_.empty()) {
     return 0;
   }
   return game_grid_[y * grid_width_ + x];
 }
 
 void LifeMatrix::set_cell(int x, int y, uint8_t value) {
-  if (x < 0 || x >= grid_width_ || y < 0 || y >= grid_height_) {
+  if (x < 0 || x >= grid_width_ || y < 0 || y >= grid_height_ || game_grid_.empty()) {
     return;
   }
   game_grid_[y * grid_width_ + x] = value;
@@ -127,69 +373,147 @@ int LifeMatrix::count_neighbors(int x, int y) {
   return count;
 }
 
-void LifeMatrix::set_grid_dimensions(int width, int height) {
-  grid_width_ = width;
-  grid_height_ = height;
-  ESP_LOGD(TAG, "Grid dimensions set to %dx%d", width, height);
-}
+// Built-in patterns, packed like the compiled RLE library (bit 0 = leftmost cell)
+static const uint8_t R_PENTOMINO_BITS[] = {0x06, 0x03, 0x02};  // famous methuselah
+static const uint8_t ACORN_BITS[] = {0x02, 0x08, 0x73};        // methuselah, stabilizes after 5206 generations
+static const uint8_t GLIDER_BITS[] = {0x02, 0x04, 0x07};       // moves diagonally
+static const uint8_t DIEHARD_BITS[] = {0x40, 0x03, 0xE2};      // vanishes after 130 generations
+static const LifePattern BUILTIN_PATTERNS[] = {
+    {"R-pentomino", R_PENTOMINO_BITS, 3, 3},
+    {"Acorn", ACORN_BITS, 7, 3},
+    {"Glider", GLIDER_BITS, 3, 3},
+    {"Diehard", DIEHARD_BITS, 8, 3},
+};
 
 void LifeMatrix::place_pattern(int x, int y, PatternType pattern) {
-  switch (pattern) {
-    case PATTERN_R_PENTOMINO:
-      // R-pentomino: famous methuselah pattern
-      //  XX
-      // XX
-      //  X
-      set_cell(x + 1, y, 1);
-      set_cell(x + 2, y, 1);
-      set_cell(x, y + 1, 1);
-      set_cell(x + 1, y + 1, 1);
-      set_cell(x + 1, y + 2, 1);
-      break;
+  if (pattern < PATTERN_R_PENTOMINO || pattern > PATTERN_DIEHARD) return;
+  place_pattern(x, y, BUILTIN_PATTERNS[pattern - PATTERN_R_PENTOMINO]);
+}
+
+void LifeMatrix::place_pattern(int x, int y, const LifePattern &pattern) {
+  const int row_bytes = (pattern.width + 7) / 8;
+  for (int row = 0; row < pattern.height; row++) {
+    const uint8_t *bits = pattern.bits + row * row_bytes;
+    for (int b = 0; b < row_bytes; b++) {
+      uint8_t v = bits[b];
+      while (v) {
+        int bit = __builtin_ctz(v);
+        set_cell(x + b * 8 + bit, y + row, 1);
+        v &= v - 1;
+      }
+    }
+  }
+}
 
-    case PATTERN_ACORN:
-      // Acorn: another methuselah (takes 5206 generations to stabilize)
-      //  X
-      //    X
-      // XX  XXX
-      set_cell(x + 1, y, 1);
-      set_cell(x + 3, y + 1, 1);
-      set_cell(x, y + 2, 1);
-      set_cell(x + 1, y + 2, 1);
-      set_cell(x + 4, y + 2, 1);
-      set_cell(x + 5, y + 2, 1);
-      set_cell(x + 6, y + 2, 1);
-      break;
+void LifeMatrix::add_pattern(const char *name, const uint8_t *bits, uint16_t width, uint16_t height, int x, int y) {
+  pattern_library_.push_back(PatternPlacement{LifePattern{name, bits, width, height}, (int16_t)x, (int16_t)y});
+  ESP_LOGD(TAG, "Pattern library: '%s' %ux%u at (%d, %d)", name, width, height, x, y);
+}
 
-    case PATTERN_GLIDER:
-      // Glider: moves diagonally
-      //  X
-      //   X
-      // XXX
-      set_cell(x + 1, y, 1);
-      set_cell(x + 2, y + 1, 1);
-      set_cell(x, y + 2, 1);
-      set_cell(x + 1, y + 2, 1);
-      set_cell(x + 2, y + 2, 1);
-      break;
+// Reads an unsigned decimal, advancing p; -1 if there is none
+static int rle_number(const char *&p) {
+  while (*p == ' ' || *p == '\t') p++;
+  if (*p < '0' || *p > '9') return -1;
+  int v = 0;
+  while (*p >= '0' && *p <= '9') v = std::min(v * 10 + (*p++ - '0'), 1 << 20);
+  return v;
+}
 
-    case PATTERN_DIEHARD:
-      // Diehard: vanishes after 130 generations
-      //       X
-      // XX
-      //  X   XXX
-      set_cell(x + 6, y, 1);
-      set_cell(x, y + 1, 1);
-      set_cell(x + 1, y + 1, 1);
-      set_cell(x + 1, y + 2, 1);
-      set_cell(x + 5, y + 2, 1);
-      set_cell(x + 6, y + 2, 1);
-      set_cell(x + 7, y + 2, 1);
-      break;
+// Matches "<key> =" (whitespace allowed around both), advancing p only on success
+static bool rle_key(const char *&p, const char *key) {
+  const char *q = p;
+  while (*q == ' ' || *q == '\t' || *q == ',') q++;
+  size_t n = strlen(key);
+  if (strncmp(q, key, n) != 0) return false;
+  q += n;
+  while (*q == ' ' || *q == '\t') q++;
+  if (*q != '=') return false;
+  p = q + 1;
+  return true;
+}
 
-    default:
+// B3/S23 in either notation, case-insensitive
+static bool rle_rule_is_life(const char *rule, size_t n) {
+  static const char *const LIFE_RULES[] = {"b3/s23", "23/3"};
+  for (const char *life : LIFE_RULES) {
+    if (strlen(life) != n) continue;
+    size_t i = 0;
+    while (i < n && tolower((unsigned char)rule[i]) == life[i]) i++;
+    if (i == n) return true;
+  }
+  return false;
+}
+
+bool LifeMatrix::load_rle(const char *rle) {
+  if (game_grid_.empty()) {
+    ESP_LOGW(TAG, "RLE: Game of Life screen is disabled");
+    return false;
+  }
+  uint32_t start_us = micros();
+  const char *p = rle;
+  int width = 0, height = 0;
+
+  // "#" comment lines, then an optional "x = m, y = n[, rule = B3/S23]" header. HA text
+  // entities are single-line, so the header may run straight into the pattern body.
+  for (;;) {
+    while (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n') p++;
+    if (*p != '#') break;
+    while (*p && *p != '\n') p++;
+  }
+  if (rle_key(p, "x")) {
+    width = rle_number(p);
+    if (!rle_key(p, "y") || (height = rle_number(p)) < 0) {
+      ESP_LOGW(TAG, "RLE: malformed header");
+      return false;
+    }
+    if (rle_key(p, "rule")) {
+      while (*p == ' ' || *p == '\t') p++;
+      const char *rule = p;
+      while (*p && *p != ' ' && *p != '\t' && *p != '\r' && *p != '\n') p++;
+      if (!rle_rule_is_life(rule, p - rule))
+        ESP_LOGW(TAG, "RLE: rule '%.*s' is not Life, running it as B3/S23 anyway", (int)(p - rule), rule);
+    }
+  }
+
+  // Body: [count]tag, b/. = dead, any other letter = alive, $ = end of row, ! = end.
+  // Decoded straight into the cleared grid; runs past the grid edge are clipped.
+  std::fill(game_grid_.begin(), game_grid_.end(), 0);
+  const int ox = std::max(0, (grid_width_ - width) / 2);
+  const int oy = std::max(0, (grid_height_ - height) / 2);
+  int x = 0, y = 0, run = 0;
+  bool ok = true;
+  for (; *p && *p != '!'; p++) {
+    char c = *p;
+    if (c >= '0' && c <= '9') {
+      run = std::min(run * 10 + (c - '0'), 1 << 20);
+      continue;
+    }
+    if (c == ' ' || c == '\t' || c == '\r' || c == '\n') continue;
+    int n = run ? run : 1;
+    run = 0;
+    if (c == 'b' || c == '.') {
+      x += n;
+    } else if (c == '$') {
+      x = 0;
+      y += n;
+    } else if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')) {
+      int end = std::min(x + n, grid_width_ - ox);
+      for (int i = x; i < end; i++) set_cell(ox + i, oy + y, 1);
+      x += n;
+    } else {
+      // Keep what was decoded so far rather than leaving an empty world
+      ESP_LOGW(TAG, "RLE: unexpected '%c' at offset %d, pattern truncated", c, (int)(p - rle));
+      ok = false;
       break;
+    }
   }
+
+  begin_world_();
+  game_demo_mode_ = false;
+  game_reset_animation_ = false;
+  ESP_LOGD(TAG, "RLE: %dx%d pattern, %d live cells, decoded in %u us", width, height, get_population(),
+           (unsigned)(micros() - start_us));
+  return ok;
 }
 
 void LifeMatrix::randomize_cells(int density_percent) {
@@ -203,12 +527,16 @@ void LifeMatrix::randomize_cells(int density_percent) {
 }
 
 void LifeMatrix::initialize_game_of_life(PatternType pattern) {
+  if (game_grid_.empty()) return;  // GoL screen disabled: nothing to seed
   ESP_LOGD(TAG, "Initializing Game of Life grid with pattern type %d", pattern);
 
   // Clear grid
-  game_grid_.fill(0);
+  std::fill(game_grid_.begin(), game_grid_.end(), 0);
 
-  if (pattern == PATTERN_MIXED && game_config_.complex_patterns) {
+  if (pattern == PATTERN_MIXED && game_config_.complex_patterns && !pattern_library_.empty()) {
+    // Configured layout: library patterns at their positions, no noise (guns need clean space)
+    for (const auto &pp : pattern_library_) place_pattern(pp.x, pp.y, pp.pattern);
+  } else if (pattern == PATTERN_MIXED && game_config_.complex_patterns) {
     // Place interesting methuselahs
     place_pattern(5, 15, PATTERN_R_PENTOMINO);
     place_pattern(10, 50, PATTERN_ACORN);
@@ -222,13 +550,17 @@ void LifeMatrix::initialize_game_of_life(PatternType pattern) {
     // Add 10% random noise
     randomize_cells(10);
   } else if (pattern == PATTERN_RANDOM) {
-    // Random initialization with ~30% density
-    randomize_cells(30);
+    // Random initialization with ~30% density, or a long-lived soup found by the search
+    if (!(soup_search_ && seed_soup_from_table_())) randomize_cells(30);
   } else {
     // Place a single pattern
     place_pattern(grid_width_ / 2 - 3, grid_height_ / 2 - 3, pattern);
   }
+  begin_world_();
+}
 
+// Generation/stability bookkeeping for a freshly populated game_grid_
+void LifeMatrix::begin_world_() {
   game_initialized_ = true;
   game_generation_ = 0;
   game_last_update_ = millis();
@@ -239,6 +571,12 @@ void LifeMatrix::initialize_game_of_life(PatternType pattern) {
   game_is_stable_ = false;
   game_stable_since_ = 0;
   game_stable_paused_elapsed_ = 0;
+
+  // New world: history restarts with this generation as its first keyframe
+  if (rewind_cap_ > 0) {
+    rewind_clear_();
+    rewind_push_();
+  }
 }
 
 void LifeMatrix::update_game_of_life() {
@@ -252,9 +590,13 @@ void LifeMatrix::update_game_of_life() {
   }
 
   game_last_update_ = now;
+  step_game_of_life_(now);
+}
 
+// One generation with age tracking, history and the stability/extinction checks
+void LifeMatrix::step_game_of_life_(unsigned long now) {
   // Use back buffer for next generation
-  game_grid_back_.fill(0);
+  std::fill(game_grid_back_.begin(), game_grid_back_.end(), 0);
 
   game_births_ = 0;
   game_deaths_ = 0;
@@ -268,9 +610,6 @@ void LifeMatrix::update_game_of_life() {
   // Apply Conway's rules with inlined neighbor counting
   // Precomputes row/col offsets to avoid per-cell function calls and bounds checks
   for (int y = 0; y < h; y++) {
-    // Yield every 30 rows to let WiFi stack process events
-    if (y > 0 && (y % 30) == 0) delay(0);
-
     int row_above = ((y == 0) ? h - 1 : y - 1) * w;
     int row_cur   = y * w;
     int row_below = ((y == h - 1) ? 0 : y + 1) * w;
@@ -311,6 +650,7 @@ void LifeMatrix::update_game_of_life() {
   // Swap buffers
   std::swap(game_grid_, game_grid_back_);
   game_generation_++;
+  if (rewind_cap_ > 0) rewind_push_();
   game_last_max_age_ = max_age;
   population_history_[history_idx_] = population;
   history_idx_ = (history_idx_ + 1) % 30;
@@ -366,6 +706,7 @@ void LifeMatrix::reset_game_of_life() {
   game_is_stable_ = false;
   game_stable_since_ = 0;
   game_stable_paused_elapsed_ = 0;
+  rewind_gen_ = -1;
 
   // Don't initialize world yet - wait until demo ends
 }
@@ -392,12 +733,472 @@ bool LifeMatrix::is_stable() {
 
 int LifeMatrix::get_population() {
   int count = 0;
-  for (int i = 0; i < GRID_SIZE; i++) {
-    if (game_grid_[i] > 0) count++;
+  for (uint8_t age : game_grid_) {
+    if (age > 0) count++;
   }
   return count;
 }
 
+// ============================================================================
+// GoL SOUP SEARCH
+// ============================================================================
+
+static const uint32_t SOUP_SAVE_INTERVAL_MS = 10 * 60 * 1000;  // NVS write at most this often
+static const uint32_t SOUP_REPORT_MS = 60000;
+
+// xorshift32: soups are generated from a 32-bit seed so a scored soup replays exactly
+static inline uint32_t soup_next(uint32_t &s) {
+  s ^= s << 13;
+  s ^= s >> 17;
+  s ^= s << 5;
+  return s;
+}
+
+// 30% soup (same density as randomize_cells(30)) as one w-bit mask per row
+static void soup_fill(uint32_t seed, uint32_t *rows, int w, int h) {
+  uint32_t s = seed ? seed : 0x9E3779B9u;
+  for (int y = 0; y < h; y++) {
+    uint32_t row = 0;
+    for (int x = 0; x < w; x++) {
+      if (soup_next(s) % 100 < 30) row |= 1u << x;
+    }
+    rows[y] = row;
+  }
+}
+
+// One toroidal generation over w-bit rows, 32 cells at a time: the eight neighbour
+// masks are summed with bitwise full adders into ones/twos/fours planes. Returns population.
+static int soup_step(const uint32_t *src, uint32_t *dst, int w, int h) {
+  const uint32_t mask = (w >= 32) ? 0xFFFFFFFFu : ((1u << w) - 1);
+  auto rot_l = [&](uint32_t r) { return ((r << 1) | (r >> (w - 1))) & mask; };
+  auto rot_r = [&](uint32_t r) { return ((r >> 1) | (r << (w - 1))) & mask; };
+  int population = 0;
+  for (int y = 0; y < h; y++) {
+    uint32_t a = src[(y == 0) ? h - 1 : y - 1];
+    uint32_t b = src[y];
+    uint32_t c = src[(y == h - 1) ? 0 : y + 1];
+    uint32_t al = rot_l(a), ar = rot_r(a), bl = rot_l(b), br = rot_r(b), cl = rot_l(c), cr = rot_r(c);
+
+    uint32_t sa = al ^ a ^ ar, ka = (al & a) | (al & ar) | (a & ar);  // row above: 0-3
+    uint32_t sb = bl ^ br, kb = bl & br;                              // own row: 0-2
+    uint32_t sc = cl ^ c ^ cr, kc = (cl & c) | (cl & cr) | (c & cr);  // row below: 0-3
+    uint32_t ones = sa ^ sb ^ sc, k1 = (sa & sb) | (sa & sc) | (sb & sc);
+    uint32_t t = ka ^ kb ^ kc, k2 = (ka & kb) | (ka & kc) | (kb & kc);
+    uint32_t twos = t ^ k1;
+    uint32_t fours = k2 | (t & k1);  // 4 or more neighbours
+
+    // Alive next: exactly 3, or exactly 2 and alive now
+    uint32_t next = twos & ~fours & (ones | b);
+    dst[y] = next;
+    population += __builtin_popcount(next);
+  }
+  return population;
+}
+
+// Lifetime first, final population as tie-break; an empty slot scores 0
+static inline uint32_t soup_score(const SoupSeed &s) { return ((uint32_t)s.lifetime << 16) | s.population; }
+
+void LifeMatrix::soup_task_(void *arg) { static_cast<LifeMatrix *>(arg)->soup_search_run_(); }
+
+void LifeMatrix::soup_search_run_() {
+  const int w = grid_width_;
+  const int h = grid_height_;
+  std::vector<uint32_t> cur(h), next(h);
+  int history[30];
+
+  for (;;) {
+    // Parked while the display sleeps / streams, or until loop() takes the last result
+    if (soup_paused_.load(std::memory_order_relaxed) || soup_result_ready_.load(std::memory_order_acquire)) {
+      vTaskDelay(pdMS_TO_TICKS(500));
+      continue;
+    }
+
+    SoupSeed r{random_uint32(), 0, 0};
+    soup_fill(r.seed, cur.data(), w, h);
+
+    // Same end conditions as update_game_of_life(), so the score predicts the visible run
+    int gen = 0, population = 0, idx = 0;
+    bool filled = false;
+    while (gen < SOUP_MAX_GENERATIONS) {
+      population = soup_step(cur.data(), next.data(), w, h);
+      std::swap(cur, next);
+      gen++;
+      if (population < 58) break;
+      history[idx] = population;
+      idx = (idx + 1) % 30;
+      if (idx == 0) filled = true;
+      if (filled && std::all_of(history + 1, history + 30, [&](int p) { return p == history[0]; })) break;
+    }
+    r.lifetime = (uint16_t)gen;
+    r.population = (uint16_t)std::min(population, 65535);
+    soups_tested_.fetch_add(1, std::memory_order_relaxed);
+
+    if (soup_score(r) > soup_floor_.load(std::memory_order_relaxed)) {
+      soup_result_ = r;
+      soup_result_ready_.store(true, std::memory_order_release);
+    }
+    // Priority 0 shares the core with the idle task; give it a tick between soups
+    vTaskDelay(1);
+  }
+}
+
+void LifeMatrix::soup_search_start_() {
+  if (soup_task_started_) return;
+  if (grid_width_ > 32) {
+    ESP_LOGW(TAG, "Soup search: grid_width %d is wider than a 32-bit row, search disabled", grid_width_);
+    soup_search_ = false;
+    return;
+  }
+
+  nvs_handle_t h;
+  if (lm_nvs_open(h, NVS_READONLY) == ESP_OK) {
+    SoupTable t{};
+    size_t len = sizeof(t);
+    if (nvs_get_blob(h, "gol_soups", &t, &len) == ESP_OK && len == sizeof(t) &&
+        t.grid_w == grid_width_ && t.grid_h == grid_height_) {
+      soup_table_ = t;
+    }
+    nvs_close(h);
+  }
+  soup_table_.grid_w = grid_width_;
+  soup_table_.grid_h = grid_height_;
+  soup_floor_.store(soup_score(soup_table_.seeds[SOUP_TABLE_SIZE - 1]), std::memory_order_relaxed);
+  ESP_LOGD(TAG, "Soup search: best stored seed lasts %u generations",
+           soup_table_.seeds[0].lifetime);
+
+  soup_report_ms_ = millis();
+  soup_report_count_ = soups_tested_.load(std::memory_order_relaxed);
+  if (xTaskCreate(soup_task_, "gol_soups", 3072, this, tskIDLE_PRIORITY, nullptr) != pdPASS) {
+    ESP_LOGW(TAG, "Soup search: task creation failed");
+    soup_search_ = false;
+    return;
+  }
+  soup_task_started_ = true;
+}
+
+void LifeMatrix::update_soup_search_() {
+  soup_paused_.store(sleeping_ || live_active_, std::memory_order_relaxed);
+  uint32_t now = millis();
+
+  if (soup_result_ready_.load(std::memory_order_acquire)) {
+    SoupSeed r = soup_result_;
+    soup_result_ready_.store(false, std::memory_order_release);
+    SoupSeed *seeds = soup_table_.seeds;
+    int pos = SOUP_TABLE_SIZE - 1;
+    if (soup_score(r) > soup_score(seeds[pos])) {
+      // Insertion into the sorted table, dropping the weakest
+      while (pos > 0 && soup_score(r) > soup_score(seeds[pos - 1])) {
+        seeds[pos] = seeds[pos - 1];
+        pos--;
+      }
+      seeds[pos] = r;
+      soup_table_dirty_ = true;
+      ESP_LOGD(TAG, "Soup search: seed %08x lasts %u generations (population %u), rank %d",
+               (unsigned)r.seed, r.lifetime, r.population, pos + 1);
+    }
+    soup_floor_.store(soup_score(seeds[SOUP_TABLE_SIZE - 1]), std::memory_order_relaxed);
+  }
+
+  if (soup_table_dirty_ && now - soup_saved_ms_ >= SOUP_SAVE_INTERVAL_MS) {
+    nvs_handle_t h;
+    if (lm_nvs_open(h, NVS_READWRITE) == ESP_OK) {
+      nvs_set_blob(h, "gol_soups", &soup_table_, sizeof(soup_table_));
+      nvs_commit(h);
+      nvs_close(h);
+    }
+    soup_table_dirty_ = false;
+    soup_saved_ms_ = now;
+  }
+
+  if (now - soup_report_ms_ >= SOUP_REPORT_MS) {
+    uint32_t tested = soups_tested_.load(std::memory_order_relaxed);
+    float per_min = (float)(tested - soup_report_count_) * 60000.0f / (float)(now - soup_report_ms_);
+    ESP_LOGD(TAG, "Soup search: %.0f soups/min, %u tested, best %u generations",
+             per_min, (unsigned)tested, soup_table_.seeds[0].lifetime);
+    if (soup_rate_sensor_) soup_rate_sensor_->publish_state(per_min);
+    soup_report_ms_ = now;
+    soup_report_count_ = tested;
+  }
+}
+
+bool LifeMatrix::seed_soup_from_table_() {
+  int n = 0;
+  while (n < SOUP_TABLE_SIZE && soup_table_.seeds[n].lifetime > 0) n++;
+  if (n == 0) return false;
+
+  const SoupSeed &s = soup_table_.seeds[std::rand() % n];
+  std::vector<uint32_t> rows(grid_height_);
+  soup_fill(s.seed, rows.data(), grid_width_, grid_height_);
+  for (int y = 0; y < grid_height_; y++) {
+    for (int x = 0; x < grid_width_; x++) {
+      if (rows[y] & (1u << x)) set_cell(x, y, 1);
+    }
+  }
+  ESP_LOGD(TAG, "Game of Life: soup %08x from the search table (%u generations)", (unsigned)s.seed, s.lifetime);
+  return true;
+}
+
+// ============================================================================
+// GoL CATCH-UP
+// ============================================================================
+
+static const uint32_t GOL_CATCHUP_BUDGET_US = 20000;  // catch-up burst limit per return
+static const int GOL_AGE_STEPS = 30;    // cell colors stop changing at age 30
+static const int GOL_CYCLE_WINDOW = 16; // exact repeats with period up to this are skipped
+
+static uint32_t soup_hash(const uint32_t *rows, int h) {
+  uint32_t hash = 2166136261UL;
+  for (int y = 0; y < h; y++) hash = (hash ^ rows[y]) * 16777619UL;
+  return hash;
+}
+
+void LifeMatrix::catch_up_game_of_life_(uint32_t hidden_ms) {
+  const uint32_t interval = std::max(1, game_config_.update_interval_ms);
+  uint32_t missed = hidden_ms / interval;
+  if (missed == 0 || rewind_gen_ >= 0) return;
+  const uint32_t start_us = micros();
+  const int start_gen = game_generation_;
+  const int w = grid_width_;
+  const int h = grid_height_;
+  uint32_t done = 0;
+  bool budget_hit = false;
+
+  // Bit kernel for everything but the last GOL_AGE_STEPS generations: ages are dropped
+  // here and rebuilt by the byte kernel below, which is all the renderer can tell apart
+  if (w <= 32 && missed > (uint32_t)GOL_AGE_STEPS) {
+    const uint32_t bit_gens = missed - GOL_AGE_STEPS;
+    std::vector<uint32_t> cur(h, 0), next(h);
+    for (int y = 0; y < h; y++) {
+      for (int x = 0; x < w; x++) {
+        if (game_grid_[y * w + x]) cur[y] |= 1u << x;
+      }
+    }
+    // The last GOL_CYCLE_WINDOW generations: a hash hit is confirmed row by row, so a
+    // collision can never fast-forward the soup into a state it would not reach
+    uint32_t hashes[GOL_CYCLE_WINDOW] = {};
+    std::vector<uint32_t> window((size_t)GOL_CYCLE_WINDOW * h);
+    int population = 0;
+    bool stable = game_is_stable_;
+    uint32_t stable_at = 0;  // burst generation the current stable stretch started at
+    auto advance = [&]() {
+      population = soup_step(cur.data(), next.data(), w, h);
+      std::swap(cur, next);
+      population_history_[history_idx_] = population;
+      history_idx_ = (history_idx_ + 1) % 30;
+      if (history_idx_ == 0) history_filled_ = true;
+    };
+
+    while (done < bit_gens) {
+      advance();
+      done++;
+
+      // Same stable/extinct rules as step_game_of_life_(), tracked in logical time
+      if (population == 0) break;
+      bool now_stable = (population < 58 && game_config_.auto_reset_on_stable) || is_stable();
+      if (now_stable && !stable) stable_at = done;
+      stable = now_stable;
+
+      // Exact cycle: the rest of the burst is a whole number of periods plus a remainder
+      uint32_t hash = soup_hash(cur.data(), h);
+      for (int p = 1; p <= GOL_CYCLE_WINDOW && (uint32_t)p < done; p++) {
+        uint32_t slot = (done - p) % GOL_CYCLE_WINDOW;
+        if (hashes[slot] != hash || memcmp(&window[slot * h], cur.data(), h * sizeof(uint32_t)) != 0) continue;
+        // The remainder is stepped for real, so population and its history end up current
+        uint32_t rest = (bit_gens - done) % p;
+        for (uint32_t i = 0; i < rest; i++) advance();
+        done = bit_gens;
+        break;
+      }
+      hashes[done % GOL_CYCLE_WINDOW] = hash;
+      memcpy(&window[(done % GOL_CYCLE_WINDOW) * h], cur.data(), h * sizeof(uint32_t));
+
+      if ((done & 63) == 0 && micros() - start_us > GOL_CATCHUP_BUDGET_US) {
+        budget_hit = true;
+        break;
+      }
+    }
+
+    for (int y = 0; y < h; y++) {
+      for (int x = 0; x < w; x++) game_grid_[y * w + x] = (cur[y] >> x) & 1;
+    }
+    game_generation_ += done;
+    if (stable && !game_is_stable_) {
+      // Back-dated by the generations actually simulated since the stretch began, not by
+      // the missed count, which overstates it when the budget cut the burst short
+      game_is_stable_ = true;
+      game_stable_since_ = millis() - (done - stable_at) * interval;
+      if (gol_final_generation_sensor_) gol_final_generation_sensor_->publish_state(start_gen + stable_at);
+      if (gol_final_population_sensor_) gol_final_population_sensor_->publish_state(population);
+    } else if (!stable) {
+      game_is_stable_ = false;
+    }
+    // The skipped generations can't be scrubbed; history restarts here
+    if (rewind_cap_ > 0) {
+      rewind_clear_();
+      rewind_push_();
+    }
+  }
+
+  // Byte kernel for the tail: exact ages, and the usual extinction reset / stability
+  // marking. It runs even when the bit kernel hit the budget, since the bit kernel left
+  // every live cell at age 1. Rows wider than 32 bits have no bit kernel, so there it runs
+  // the whole catch-up under the same budget.
+  unsigned long now = millis();
+  const uint32_t byte_end = w > 32 ? missed : std::min(missed, done + (uint32_t)GOL_AGE_STEPS);
+  while (done < byte_end && !(budget_hit && w > 32) && !game_demo_mode_) {
+    step_game_of_life_(now);
+    done++;
+    if (w > 32 && (done & 7) == 0 && micros() - start_us > GOL_CATCHUP_BUDGET_US) budget_hit = true;
+  }
+  game_last_update_ = now;
+
+  ESP_LOGD(TAG, "GoL catch-up: %u of %u missed generations (gen %d -> %d) in %u us%s", (unsigned)done,
+           (unsigned)missed, start_gen, game_generation_, (unsigned)(micros() - start_us),
+           budget_hit ? ", budget hit" : "");
+}
+
+// ============================================================================
+// GoL REWIND
+// ============================================================================
+
+static const uint32_t REWIND_REPORT_MS = 60000;
+
+void LifeMatrix::rewind_clear_() {
+  rewind_segments_.clear();
+  rewind_gen_ = -1;
+  rewind_view_gen_ = -1;
+}
+
+void LifeMatrix::rewind_push_() {
+  const int w = grid_width_;
+  const size_t row_bytes = (w + 7) / 8;
+  const size_t n = row_bytes * grid_height_;
+  const size_t bitmap_bytes = (n + 7) / 8;
+
+  rewind_pack_.assign(n, 0);
+  for (int y = 0; y < grid_height_; y++) {
+    const uint8_t *src = &game_grid_[y * w];
+    uint8_t *dst = &rewind_pack_[y * row_bytes];
+    for (int x = 0; x < w; x++) {
+      if (src[x]) dst[x >> 3] |= 1 << (x & 7);
+    }
+  }
+
+  // Over budget with a single segment left: close it early so the next eviction can drop it
+  bool keyframe = rewind_segments_.empty() || rewind_last_.size() != n ||
+                  rewind_segments_.back().count >= REWIND_KEYFRAME_INTERVAL || rewind_bytes_ > rewind_cap_;
+  if (keyframe) {
+    if (!rewind_segments_.empty()) rewind_segments_.back().data.shrink_to_fit();
+    rewind_segments_.push_back(
+        RewindSegment{game_generation_, 1, ColdVector<uint8_t>(rewind_pack_.begin(), rewind_pack_.end())});
+  } else {
+    RewindSegment &seg = rewind_segments_.back();
+    size_t changed = 0;
+    for (size_t i = 0; i < n; i++) changed += (rewind_pack_[i] != rewind_last_[i]);
+    size_t len = changed ? bitmap_bytes + changed : 0;
+    size_t at = seg.data.size();
+    seg.data.resize(at + 2 + len, 0);
+    seg.data[at] = len & 0xFF;
+    seg.data[at + 1] = len >> 8;
+    if (len) {
+      uint8_t *bitmap = &seg.data[at + 2];
+      uint8_t *out = bitmap + bitmap_bytes;
+      for (size_t i = 0; i < n; i++) {
+        uint8_t x = rewind_pack_[i] ^ rewind_last_[i];
+        if (!x) continue;
+        bitmap[i >> 3] |= 1 << (i & 7);
+        *out++ = x;
+      }
+    }
+    seg.count++;
+  }
+  std::swap(rewind_last_, rewind_pack_);
+
+  // Account everything the history owns, then drop whole segments from the old end
+  auto total = [&]() {
+    uint32_t bytes = rewind_last_.capacity() + rewind_pack_.capacity() + rewind_view_.capacity() +
+                     rewind_ages_.capacity() + rewind_segments_.capacity() * sizeof(RewindSegment);
+    for (const auto &seg : rewind_segments_) bytes += seg.data.capacity();
+    return bytes;
+  };
+  rewind_bytes_ = total();
+  bool evicted = false;
+  while (rewind_bytes_ > rewind_cap_ && rewind_segments_.size() > 1) {
+    rewind_segments_.erase(rewind_segments_.begin());
+    rewind_view_gen_ = -1;
+    rewind_bytes_ = total();
+    evicted = true;
+  }
+
+  uint32_t now = millis();
+  if (evicted && now - rewind_report_ms_ >= REWIND_REPORT_MS) {
+    rewind_report_ms_ = now;
+    ESP_LOGD(TAG, "GoL rewind: %d generations in %u B (cap %u B)",
+             game_generation_ - rewind_segments_.front().first_gen + 1, (unsigned)rewind_bytes_,
+             (unsigned)rewind_cap_);
+  }
+}
+
+bool LifeMatrix::rewind_seek_(int gen) {
+  auto seg_it = std::find_if(rewind_segments_.rbegin(), rewind_segments_.rend(),
+                             [gen](const RewindSegment &s) { return s.first_gen <= gen; });
+  if (seg_it == rewind_segments_.rend() || gen >= seg_it->first_gen + seg_it->count) return false;
+  const RewindSegment &seg = *seg_it;
+  const int w = grid_width_;
+  const size_t row_bytes = (w + 7) / 8;
+  const size_t n = row_bytes * grid_height_;
+  const size_t bitmap_bytes = (n + 7) / 8;
+
+  // Ages restart at the keyframe; each applied delta ages survivors by one
+  auto age_cells = [&]() {
+    for (int y = 0; y < grid_height_; y++) {
+      const uint8_t *bits = &rewind_view_[y * row_bytes];
+      uint8_t *ages = &rewind_ages_[y * w];
+      for (int x = 0; x < w; x++) {
+        bool alive = bits[x >> 3] & (1 << (x & 7));
+        ages[x] = alive ? (uint8_t)std::min(255, ages[x] + 1) : 0;
+      }
+    }
+  };
+
+  // Stepping forward inside the decoded segment only applies the deltas in between
+  if (rewind_view_gen_ < seg.first_gen || rewind_view_gen_ > gen) {
+    rewind_view_.assign(seg.data.begin(), seg.data.begin() + n);
+    rewind_ages_.assign((size_t)w * grid_height_, 0);
+    age_cells();
+    rewind_view_gen_ = seg.first_gen;
+    rewind_view_pos_ = n;
+  }
+  while (rewind_view_gen_ < gen) {
+    const uint8_t *rec = &seg.data[rewind_view_pos_];
+    size_t len = rec[0] | (rec[1] << 8);
+    if (len) {
+      const uint8_t *bitmap = rec + 2;
+      const uint8_t *xor_bytes = bitmap + bitmap_bytes;
+      for (size_t i = 0; i < n; i++) {
+        if (bitmap[i >> 3] & (1 << (i & 7))) rewind_view_[i] ^= *xor_bytes++;
+      }
+    }
+    rewind_view_pos_ += 2 + len;
+    rewind_view_gen_++;
+    age_cells();
+  }
+  return true;
+}
+
+void LifeMatrix::rewind_scrub_(int delta) {
+  if (rewind_segments_.empty()) return;
+  int target = (rewind_gen_ < 0 ? game_generation_ : rewind_gen_) + delta;
+  if (target >= game_generation_) {
+    rewind_gen_ = -1;  // back at the live generation; the simulation resumes
+    return;
+  }
+  target = std::max(target, rewind_segments_.front().first_gen);
+  if (rewind_seek_(target)) rewind_gen_ = target;
+  ESP_LOGD(TAG, "GoL rewind: showing generation %d of %d", rewind_gen_, game_generation_);
+}
+#endif  // LIFE_MATRIX_NO_GOL
+
 // ============================================================================
 // UI STATE MANAGEMENT
 // ============================================================================
@@ -434,10 +1235,35 @@ void LifeMatrix::check_ui_timeout() {
 
 void LifeMatrix::handle_input() {
   ui_last_input_ms_ = millis();
+  request_redraw();
+}
+
+void LifeMatrix::request_redraw() {
+  redraw_requested_ = true;
+}
+
+// Wake-on-input hook, called first by the hardware input handlers only. Holds a scheduled
+// sleep off and stamps the event for latency stats. While asleep the event just wakes the
+// panel and returns true, so the handler drops it instead of acting on a dark screen.
+bool LifeMatrix::note_user_input_() {
+  sleep_last_input_ms_ = millis();
+  if (sleeping_) {
+    sleep_wake_requested_ = true;
+    return true;
+  }
+  if (!input_pending_) {
+    input_pending_ = true;
+    input_event_us_ = micros();
+  }
+  request_redraw();
+  return false;
 }
 
 void LifeMatrix::toggle_pause() {
   ui_paused_ = !ui_paused_;
+#ifndef LIFE_MATRIX_NO_GOL
+  if (!ui_paused_) rewind_gen_ = -1;  // resuming returns GoL to the live generation
+#endif
   ESP_LOGD(TAG, "UI pause toggled: %s", ui_paused_ ? "paused" : "playing");
   update_status_led();  // Update LED for pause state
 }
@@ -472,441 +1298,425 @@ void LifeMatrix::update_status_led() {
   call.perform();
 }
 
+// ============================================================================
+// SETTINGS DESCRIPTORS
+// ============================================================================
+
+static constexpr int GOL_SPEEDS_MS[] = {50, 200, 1000};
+static constexpr YearEventStyle YEAR_EVENT_BY_INDEX[] = {YEAR_EVENT_NONE, YEAR_EVENT_PULSE, YEAR_EVENT_MARKERS};
+static_assert(sizeof(GOL_SPEEDS_MS) / sizeof(GOL_SPEEDS_MS[0]) == SETTING_TABLE[SET_GOL_SPEED].max_value + 1,
+              "one interval per conway_speed option");
+static_assert(sizeof(YEAR_EVENT_BY_INDEX) / sizeof(YEAR_EVENT_BY_INDEX[0]) == SETTING_TABLE[SET_YEAR_EVENTS].max_value + 1,
+              "one style per year_event_style option");
+
+// Getters and setters in SettingID order (checked below)
+constexpr SettingAccess LifeMatrix::SETTING_ACCESS[SET_COUNT] = {
+  {SET_BRIGHTNESS,
+   [](const LifeMatrix &m) { return (int)m.base_brightness_pct_; },
+   [](LifeMatrix &m, int v) { m.set_base_brightness_pct((float)v); }},
+  {SET_CYCLE_TIME,
+   [](const LifeMatrix &m) { return (int)m.screen_cycle_time_; },
+   [](LifeMatrix &m, int v) { m.set_screen_cycle_time((float)v); }},
+  {SET_TEXT_AREA,
+   [](const LifeMatrix &m) { return m.text_area_position_ == "Top" ? 0 : m.text_area_position_ == "Bottom" ? 1 : 2; },
+   [](LifeMatrix &m, int v) { m.set_text_area_position(OPT_TEXT_AREA[v]); }},
+  {SET_STYLE,
+   [](const LifeMatrix &m) { return (int)m.style_; },
+   [](LifeMatrix &m, int v) { m.style_ = (DisplayStyle)v; }},
+  {SET_GRADIENT,
+   [](const LifeMatrix &m) { return (int)m.gradient_type_; },
+   [](LifeMatrix &m, int v) { m.gradient_type_ = (GradientType)v; }},
+  {SET_FILL_DIRECTION,
+   [](const LifeMatrix &m) { return m.fill_direction_bottom_to_top_ ? 0 : 1; },
+   [](LifeMatrix &m, int v) { m.fill_direction_bottom_to_top_ = (v == 0); }},
+  {SET_MARKER_STYLE,
+   [](const LifeMatrix &m) { return (int)m.marker_style_; },
+   [](LifeMatrix &m, int v) { m.marker_style_ = (MarkerStyle)v; }},
+  {SET_MARKER_COLOR,
+   [](const LifeMatrix &m) { return (int)m.marker_color_; },
+   [](LifeMatrix &m, int v) { m.marker_color_ = (MarkerColor)v; }},
+  {SET_DAY_FILL,
+   [](const LifeMatrix &m) { return (int)m.day_fill_style_; },
+   [](LifeMatrix &m, int v) { m.day_fill_style_ = (DayFillStyle)v; }},
+  {SET_YEAR_EVENTS,
+   [](const LifeMatrix &m) { return m.year_event_style_ == YEAR_EVENT_NONE ? 0 : m.year_event_style_ == YEAR_EVENT_PULSE ? 1 : 2; },
+   [](LifeMatrix &m, int v) { m.year_event_style_ = YEAR_EVENT_BY_INDEX[v]; }},
+  {SET_BED_HOUR,
+   [](const LifeMatrix &m) { return m.time_segments_.bed_time_hour; },
+   [](LifeMatrix &m, int v) { m.set_bed_time_hour(v); }},
+  {SET_WAKE_HOUR,
+   [](const LifeMatrix &m) { return m.time_segments_.wake_time_hour; },
+   [](LifeMatrix &m, int v) { m.set_wake_time_hour(v); }},
+  {SET_WORK_START,
+   [](const LifeMatrix &m) { return m.time_segments_.work_start_hour; },
+   [](LifeMatrix &m, int v) { m.set_work_start_hour(v); }},
+  {SET_WORK_END,
+   [](const LifeMatrix &m) { return m.time_segments_.work_end_hour; },
+   [](LifeMatrix &m, int v) { m.set_work_end_hour(v); }},
+  {SET_GOL_SPEED,
+   [](const LifeMatrix &m) { int ms = m.game_config_.update_interval_ms; return ms <= 50 ? 0 : ms <= 200 ? 1 : 2; },
+   [](LifeMatrix &m, int v) { m.set_game_update_interval(GOL_SPEEDS_MS[v]); }},
+  {SET_GOL_COMPLEX,
+   [](const LifeMatrix &m) { return (int)m.game_config_.complex_patterns; },
+   [](LifeMatrix &m, int v) { m.set_complex_patterns(v != 0); }},
+  {SET_POMO_PRESET,
+   [](const LifeMatrix &m) { return (int)m.pomo_preset_; },
+   [](LifeMatrix &m, int v) { m.pomo_preset_ = (PomodoroPreset)v; }},
+  {SET_POMO_ROUNDS,
+   [](const LifeMatrix &m) { return m.pomo_rounds_before_long_break_; },
+   [](LifeMatrix &m, int v) { m.set_pomo_rounds(v); }},
+  {SET_EXERCISE_SNACKS,
+   [](const LifeMatrix &m) { return (int)m.exercise_snacks_enabled_; },
+   [](LifeMatrix &m, int v) { m.set_exercise_snacks_enabled(v != 0); }},
+  {SET_SHOW_FUTURE,
+   [](const LifeMatrix &m) { return (int)m.show_future_; },
+   [](LifeMatrix &m, int v) { m.set_show_future(v != 0); }},
+  {SET_NIGHT_MODE,
+   [](const LifeMatrix &m) { return m.night_mode_level_; },
+   [](LifeMatrix &m, int v) { m.set_night_mode_level(v); }},
+  {SET_SLEEP_SCHEDULE,
+   [](const LifeMatrix &m) { return (int)m.sleep_schedule_; },
+   [](LifeMatrix &m, int v) { m.set_sleep_schedule(v != 0); }},
+  {SET_SLEEP_NOW,
+   [](const LifeMatrix &m) { return (int)m.sleep_now_; },
+   [](LifeMatrix &m, int v) { m.set_sleep_now(v != 0); }},
+};
+
+static constexpr bool settings_rows_in_order() {
+  for (int i = 0; i < SET_COUNT; i++) {
+    if (SETTING_TABLE[i].id != i || LifeMatrix::SETTING_ACCESS[i].id != i) return false;
+  }
+  return true;
+}
+static_assert(settings_rows_in_order(), "SETTING_TABLE and SETTING_ACCESS rows must follow SettingID order");
+
+// Settings menu: three global rows, then the current screen's list
+static const SettingID MENU_GLOBAL[] = {SET_BRIGHTNESS, SET_CYCLE_TIME, SET_TEXT_AREA};
+static const SettingID MENU_YEAR[]   = {SET_STYLE, SET_MARKER_STYLE, SET_DAY_FILL, SET_YEAR_EVENTS};
+static const SettingID MENU_MONTH[]  = {SET_STYLE, SET_FILL_DIRECTION, SET_DAY_FILL, SET_MARKER_COLOR};
+static const SettingID MENU_DAY[]    = {SET_BED_HOUR, SET_WAKE_HOUR, SET_WORK_START, SET_WORK_END};
+static const SettingID MENU_HOUR[]   = {SET_STYLE, SET_GRADIENT, SET_FILL_DIRECTION, SET_MARKER_STYLE, SET_MARKER_COLOR};
+static const SettingID MENU_GOL[]    = {SET_GOL_SPEED, SET_GOL_COMPLEX};
+static const SettingID MENU_POMO[]   = {SET_STYLE, SET_GRADIENT, SET_POMO_PRESET, SET_POMO_ROUNDS, SET_EXERCISE_SNACKS};
+
+struct ScreenMenu {
+  const SettingID *ids;
+  uint8_t count;
+};
+
+static ScreenMenu screen_menu(int screen_id) {
+  switch (screen_id) {
+    case SCREEN_YEAR:         return {MENU_YEAR, 4};
+    case SCREEN_MONTH:        return {MENU_MONTH, 4};
+    case SCREEN_DAY:          return {MENU_DAY, 4};
+    case SCREEN_HOUR:         return {MENU_HOUR, 5};
+    case SCREEN_GAME_OF_LIFE: return {MENU_GOL, 2};
+    case SCREEN_POMODORO:     return {MENU_POMO, 5};
+    default:                  return {nullptr, 0};
+  }
+}
+
+int LifeMatrix::menu_setting_count_(int screen_id) const {
+  return 3 + screen_menu(screen_id).count;
+}
+
+SettingID LifeMatrix::menu_setting_at_(int screen_id, int cursor) const {
+  if (cursor < 3) return MENU_GLOBAL[std::max(0, cursor)];
+  ScreenMenu menu = screen_menu(screen_id);
+  int local = cursor - 3;
+  return (local < menu.count) ? menu.ids[local] : SET_COUNT;
+}
+
 void LifeMatrix::next_settings_cursor() {
   handle_input();  // Reset timeout
-
-  // Get current screen to determine max cursor position
-  int screen_id = get_current_screen_id();
-  int max_cursor = 2;  // Global settings (brightness, cycle time, text position)
-
-  // Per-screen settings
-  if (screen_id == SCREEN_HOUR) {
-    max_cursor = 7;  // 3 global + 5 hour settings
-  } else if (screen_id == SCREEN_DAY) {
-    max_cursor = 5;  // 3 global + 3 day settings
-  } else if (screen_id == SCREEN_GAME_OF_LIFE) {
-    max_cursor = 4;  // 3 global + 2 GoL settings
-  } else if (screen_id == SCREEN_MONTH) {
-    max_cursor = 6;  // 3 global + 4 month settings (style, fill dir, day fill, marker color)
-  } else if (screen_id == SCREEN_YEAR) {
-    max_cursor = 6;  // 3 global + 4 year settings
-  } else if (screen_id == SCREEN_POMODORO) {
-    max_cursor = 7;  // 3 global + 5 pomodoro settings (style, grad, preset, rounds, exercise)
-  }
-
-  settings_cursor_ = (settings_cursor_ + 1) % (max_cursor + 1);
+  int count = menu_setting_count_(get_current_screen_id());
+  settings_cursor_ = (settings_cursor_ + 1) % count;
   settings_flash_ms_ = millis();
   ESP_LOGD(TAG, "Settings cursor: %d", settings_cursor_);
 }
 
 void LifeMatrix::prev_settings_cursor() {
   handle_input();  // Reset timeout
-
-  // Get current screen to determine max cursor position
-  int screen_id = get_current_screen_id();
-  int max_cursor = 2;  // Global settings
-
-  // Per-screen settings
-  if (screen_id == SCREEN_HOUR) {
-    max_cursor = 7;
-  } else if (screen_id == SCREEN_DAY) {
-    max_cursor = 5;
-  } else if (screen_id == SCREEN_GAME_OF_LIFE) {
-    max_cursor = 4;
-  } else if (screen_id == SCREEN_MONTH) {
-    max_cursor = 6;  // 3 global + 4 month settings (style, fill dir, day fill, marker color)
-  } else if (screen_id == SCREEN_YEAR) {
-    max_cursor = 6;
-  } else if (screen_id == SCREEN_POMODORO) {
-    max_cursor = 7;  // 3 global + 5 pomodoro settings (style, grad, preset, rounds, exercise)
-  }
-
-  settings_cursor_ = (settings_cursor_ - 1 + max_cursor + 1) % (max_cursor + 1);
+  int count = menu_setting_count_(get_current_screen_id());
+  settings_cursor_ = (settings_cursor_ - 1 + count) % count;
   settings_flash_ms_ = millis();
   ESP_LOGD(TAG, "Settings cursor: %d", settings_cursor_);
 }
 
+void LifeMatrix::apply_setting(SettingID id, int value) {
+  if (id >= SET_COUNT) return;
+  const SettingDesc &d = SETTING_TABLE[id];
+  value = std::max((int)d.min_value, std::min((int)d.max_value, value));
+  // A bound entity takes the same path as an HA write: publish, persist to its NVS
+  // slot, then its state callback runs the setter
+  EntityBase *e = setting_entities_[id];
+  if (e == nullptr) {
+    SETTING_ACCESS[id].set(*this, value);
+  } else if (d.kind == SETTING_SELECT) {
+    static_cast<LMSelect *>(e)->control(d.options[value]);
+  } else if (d.kind == SETTING_SWITCH) {
+    auto *sw = static_cast<switch_::Switch *>(e);
+    if (value) sw->turn_on(); else sw->turn_off();
+  } else {
+    static_cast<LMNumber *>(e)->control((float)value);
+  }
+  ESP_LOGD(TAG, "Setting %s = %d", d.label, value);
+}
+
 void LifeMatrix::adjust_setting(int direction) {
   handle_input();  // Reset timeout
+  settings_flash_ms_ = millis();
 
-  // Helper: cycle through enum values
-  auto cycle_enum = [direction](int current, int max_value) {
-    int new_val = current + direction;
-    if (new_val < 0) new_val = max_value;
-    if (new_val > max_value) new_val = 0;
-    return new_val;
-  };
+  // Not in settings mode: adjust screen cycle time
+  SettingID id = (ui_mode_ == SETTINGS) ? menu_setting_at_(get_current_screen_id(), settings_cursor_)
+                                        : SET_CYCLE_TIME;
+  if (id >= SET_COUNT) return;
+  const SettingDesc &d = SETTING_TABLE[id];
+  int v = SETTING_ACCESS[id].get(*this) + direction * d.step;
+  if (d.wrap) {
+    if (v > d.max_value) v = d.min_value;
+    if (v < d.min_value) v = d.max_value;
+  }
+  apply_setting(id, v);
+}
 
-  // Helper: adjust number with wrapping
-  auto adjust_number = [direction](int current, int min_val, int max_val, bool wrap) {
-    int new_val = current + direction;
-    if (wrap) {
-      if (new_val > max_val) new_val = min_val;
-      if (new_val < min_val) new_val = max_val;
-    } else {
-      if (new_val > max_val) new_val = max_val;
-      if (new_val < min_val) new_val = min_val;
-    }
-    return new_val;
-  };
+size_t LifeMatrix::format_setting_value(SettingID id, char *buf, size_t len) const {
+  if (len == 0) return 0;
+  if (id >= SET_COUNT) return (size_t)snprintf(buf, len, "?");
+  const SettingDesc &d = SETTING_TABLE[id];
+  int v = SETTING_ACCESS[id].get(*this);
+  if (d.kind == SETTING_NUMBER) return (size_t)snprintf(buf, len, d.value_fmt, v);
+  v = std::max((int)d.min_value, std::min((int)d.max_value, v));
+  return (size_t)snprintf(buf, len, "%s", d.short_names[v]);
+}
 
-  // Enum-to-HA-option-string lookup tables
-  static const char* const cs_names[] = {"Single Color", "Gradient", "Time Segments", "Rainbow"};
-  static const char* const gt_names[] = {"Red-Blue", "Green-Yellow", "Cyan-Magenta", "Purple-Orange", "Blue-Yellow"};
-  static const char* const ms_names[] = {"None", "Single Dot", "Gradient Peak"};
-  static const char* const mc_names[] = {"Blue", "White", "Yellow", "Red", "Green", "Cyan", "Magenta"};
-  static const char* const yds_names[] = {"Fixed", "Flat", "Shaded"};
-  static const char* const speed_names[] = {"Fast (50ms)", "Normal (200ms)", "Slow (1000ms)"};
+const char *LifeMatrix::get_current_setting_name() {
+  SettingID id = menu_setting_at_(get_current_screen_id(), settings_cursor_);
+  return (id < SET_COUNT) ? SETTING_TABLE[id].label : "?";
+}
 
-  // Not in settings mode: adjust screen cycle time
-  if (ui_mode_ != SETTINGS) {
-    screen_cycle_time_ = (float)adjust_number((int)screen_cycle_time_, 1, 10, false);
-    if (ha_cycle_time_) ha_cycle_time_->publish_state(screen_cycle_time_);
-    ESP_LOGD(TAG, "Adjusted cycle time: %.0fs", screen_cycle_time_);
-    settings_flash_ms_ = millis();
-    return;
+const char *LifeMatrix::get_current_setting_value() {
+  format_setting_value(menu_setting_at_(get_current_screen_id(), settings_cursor_),
+                       setting_value_buf_, sizeof(setting_value_buf_));
+  return setting_value_buf_;
+}
+
+// ============================================================================
+// SCREEN PLUGINS
+// ============================================================================
+// Thin adapters over the view code. Stateless views only render; the stateful ones
+// allocate their buffers in the constructor and give them back in the destructor.
+
+class LifeMatrix::ViewScreen : public Screen {
+ protected:
+  explicit ViewScreen(LifeMatrix *lm) : lm_(lm) {}
+  LifeMatrix *lm_;
+};
+
+#ifndef LIFE_MATRIX_NO_YEAR
+class LifeMatrix::YearScreen : public LifeMatrix::ViewScreen {
+ public:
+  explicit YearScreen(LifeMatrix *lm) : ViewScreen(lm) {}
+  void prepare(ESPTime &time) override {
+    if (time.is_valid()) lm_->prepare_year_days_(time.year);
   }
+  void render(display::Display &it, ESPTime &time, const Viewport &vp) override {
+    lm_->render_year_view(it, time, vp.viz_y, vp.viz_height);
+  }
+};
+#endif
 
-  // Get current screen
-  int screen_id = get_current_screen_id();
-  int cursor = settings_cursor_;
-
-  // Global settings (cursor 0-2)
-  if (cursor == 0) {
-    // Brightness handled by adjust_display_brightness() via encoder callbacks
-  } else if (cursor == 1) {
-    // Cycle time
-    screen_cycle_time_ = (float)adjust_number((int)screen_cycle_time_, 1, 10, false);
-    if (ha_cycle_time_) ha_cycle_time_->publish_state(screen_cycle_time_);
-    ESP_LOGD(TAG, "Cycle time: %.0fs", screen_cycle_time_);
-  } else if (cursor == 2) {
-    // Text area position
-    if (text_area_position_ == "Top") text_area_position_ = "Bottom";
-    else if (text_area_position_ == "Bottom") text_area_position_ = "None";
-    else text_area_position_ = "Top";
-    if (ha_text_area_position_) ha_text_area_position_->publish_state(text_area_position_);
-    ESP_LOGD(TAG, "Text position: %s", text_area_position_.c_str());
-  } else {
-    // Per-screen settings (cursor 3+)
-    int local = cursor - 3;
-
-    if (screen_id == SCREEN_HOUR) {
-      if (local == 0) {
-        style_ = (DisplayStyle)cycle_enum((int)style_, 3);
-        if (ha_style_) ha_style_->publish_state(cs_names[style_]);
-        ESP_LOGD(TAG, "Style: %d", (int)style_);
-      } else if (local == 1) {
-        gradient_type_ = (GradientType)cycle_enum((int)gradient_type_, 4);
-        if (ha_gradient_type_) ha_gradient_type_->publish_state(gt_names[gradient_type_]);
-        ESP_LOGD(TAG, "Gradient type: %d", (int)gradient_type_);
-      } else if (local == 2) {
-        fill_direction_bottom_to_top_ = !fill_direction_bottom_to_top_;
-        if (ha_fill_direction_) ha_fill_direction_->publish_state(fill_direction_bottom_to_top_ ? "Bottom to Top" : "Top to Bottom");
-        ESP_LOGD(TAG, "Fill direction: %s", fill_direction_bottom_to_top_ ? "Bottom to Top" : "Top to Bottom");
-      } else if (local == 3) {
-        marker_style_ = (MarkerStyle)cycle_enum((int)marker_style_, 2);
-        if (ha_marker_style_) ha_marker_style_->publish_state(ms_names[marker_style_]);
-        ESP_LOGD(TAG, "Marker style: %d", (int)marker_style_);
-      } else if (local == 4) {
-        marker_color_ = (MarkerColor)cycle_enum((int)marker_color_, 6);
-        if (ha_marker_color_) ha_marker_color_->publish_state(mc_names[marker_color_]);
-        ESP_LOGD(TAG, "Marker color: %d", (int)marker_color_);
-      }
-    } else if (screen_id == SCREEN_DAY) {
-      if (local == 0) {
-        time_segments_.bed_time_hour = adjust_number(time_segments_.bed_time_hour, 0, 23, true);
-        if (ha_bed_time_hour_) ha_bed_time_hour_->publish_state(time_segments_.bed_time_hour);
-        ESP_LOGD(TAG, "Bed time: %d:00", time_segments_.bed_time_hour);
-      } else if (local == 1) {
-        time_segments_.work_start_hour = adjust_number(time_segments_.work_start_hour, 0, 23, true);
-        if (ha_work_start_hour_) ha_work_start_hour_->publish_state(time_segments_.work_start_hour);
-        ESP_LOGD(TAG, "Work start: %d:00", time_segments_.work_start_hour);
-      } else if (local == 2) {
-        time_segments_.work_end_hour = adjust_number(time_segments_.work_end_hour, 0, 23, true);
-        if (ha_work_end_hour_) ha_work_end_hour_->publish_state(time_segments_.work_end_hour);
-        ESP_LOGD(TAG, "Work end: %d:00", time_segments_.work_end_hour);
-      }
-    } else if (screen_id == SCREEN_GAME_OF_LIFE) {
-      if (local == 0) {
-        // Speed: cycle through 50, 200, 1000 ms
-        int speeds[] = {50, 200, 1000};
-        int current_idx = 1;  // Default 200ms
-        for (int i = 0; i < 3; i++) {
-          if (game_config_.update_interval_ms == speeds[i]) {
-            current_idx = i;
-            break;
-          }
-        }
-        current_idx = (current_idx + direction + 3) % 3;
-        game_config_.update_interval_ms = speeds[current_idx];
-        if (ha_conway_speed_) ha_conway_speed_->publish_state(speed_names[current_idx]);
-        ESP_LOGD(TAG, "GoL speed: %dms", game_config_.update_interval_ms);
-      } else if (local == 1) {
-        game_config_.complex_patterns = !game_config_.complex_patterns;
-        if (ha_complex_patterns_) ha_complex_patterns_->publish_state(game_config_.complex_patterns);
-        ESP_LOGD(TAG, "Complex patterns: %s", game_config_.complex_patterns ? "on" : "off");
-      }
-    } else if (screen_id == SCREEN_MONTH) {
-      if (local == 0) {
-        style_ = (DisplayStyle)cycle_enum((int)style_, 3);
-        if (ha_style_) ha_style_->publish_state(cs_names[style_]);
-        ESP_LOGD(TAG, "Style: %d", (int)style_);
-      } else if (local == 1) {
-        fill_direction_bottom_to_top_ = !fill_direction_bottom_to_top_;
-        if (ha_fill_direction_) ha_fill_direction_->publish_state(fill_direction_bottom_to_top_ ? "Bottom to Top" : "Top to Bottom");
-        ESP_LOGD(TAG, "Fill direction: %s", fill_direction_bottom_to_top_ ? "Bottom to Top" : "Top to Bottom");
-      } else if (local == 2) {
-        day_fill_style_ = (DayFillStyle)cycle_enum((int)day_fill_style_, 2);
-        if (ha_day_fill_) ha_day_fill_->publish_state(yds_names[day_fill_style_]);
-        ESP_LOGD(TAG, "Day fill: %d", (int)day_fill_style_);
-      } else if (local == 3) {
-        marker_color_ = (MarkerColor)cycle_enum((int)marker_color_, 6);
-        if (ha_marker_color_) ha_marker_color_->publish_state(mc_names[marker_color_]);
-        ESP_LOGD(TAG, "Marker color: %d", (int)marker_color_);
-      }
-    } else if (screen_id == SCREEN_YEAR) {
-      if (local == 0) {
-        style_ = (DisplayStyle)cycle_enum((int)style_, 3);
-        if (ha_style_) ha_style_->publish_state(cs_names[style_]);
-        ESP_LOGD(TAG, "Style: %d", (int)style_);
-      } else if (local == 1) {
-        marker_style_ = (MarkerStyle)cycle_enum((int)marker_style_, 2);
-        if (ha_marker_style_) ha_marker_style_->publish_state(ms_names[marker_style_]);
-        ESP_LOGD(TAG, "Marker style: %d", (int)marker_style_);
-      } else if (local == 2) {
-        day_fill_style_ = (DayFillStyle)cycle_enum((int)day_fill_style_, 2);
-        if (ha_day_fill_) ha_day_fill_->publish_state(yds_names[day_fill_style_]);
-        ESP_LOGD(TAG, "Day fill: %d", (int)day_fill_style_);
-      } else if (local == 3) {
-        if (year_event_style_ == YEAR_EVENT_NONE) {
-          year_event_style_ = YEAR_EVENT_PULSE;
-        } else if (year_event_style_ == YEAR_EVENT_PULSE) {
-          year_event_style_ = YEAR_EVENT_MARKERS;
-        } else {
-          year_event_style_ = YEAR_EVENT_NONE;
-        }
-        const char* yes_name = (year_event_style_ == YEAR_EVENT_NONE) ? "None" :
-                               (year_event_style_ == YEAR_EVENT_PULSE) ? "Pulse" : "Markers";
-        if (ha_year_event_style_) ha_year_event_style_->publish_state(yes_name);
-        ESP_LOGD(TAG, "Year event style: %d", (int)year_event_style_);
-      }
-    } else if (screen_id == SCREEN_POMODORO) {
-      static const char* const pomo_preset_names[] = {
-        "Classic (25/5)", "Deep Work (50/10)", "Ultradian (90/20)"};
-      if (local == 0) {
-        style_ = (DisplayStyle)cycle_enum((int)style_, 3);
-        if (ha_style_) ha_style_->publish_state(cs_names[style_]);
-        ESP_LOGD(TAG, "Pomo style: %d", (int)style_);
-      } else if (local == 1) {
-        gradient_type_ = (GradientType)cycle_enum((int)gradient_type_, 4);
-        if (ha_gradient_type_) ha_gradient_type_->publish_state(gt_names[gradient_type_]);
-        ESP_LOGD(TAG, "Pomo gradient: %d", (int)gradient_type_);
-      } else if (local == 2) {
-        pomo_preset_ = (PomodoroPreset)cycle_enum((int)pomo_preset_, 2);
-        if (ha_pomo_preset_) ha_pomo_preset_->publish_state(pomo_preset_names[pomo_preset_]);
-        ESP_LOGD(TAG, "Pomo preset: %d", (int)pomo_preset_);
-      } else if (local == 3) {
-        pomo_rounds_before_long_break_ += direction;
-        if (pomo_rounds_before_long_break_ < 2) pomo_rounds_before_long_break_ = 8;
-        if (pomo_rounds_before_long_break_ > 8) pomo_rounds_before_long_break_ = 2;
-        if (ha_pomo_rounds_) ha_pomo_rounds_->publish_state((float)pomo_rounds_before_long_break_);
-        ESP_LOGD(TAG, "Pomo rounds: %d", pomo_rounds_before_long_break_);
-      } else if (local == 4) {
-        exercise_snacks_enabled_ = !exercise_snacks_enabled_;
-        if (ha_exercise_snacks_) ha_exercise_snacks_->publish_state(exercise_snacks_enabled_);
-        ESP_LOGD(TAG, "Exercise snacks: %s", exercise_snacks_enabled_ ? "on" : "off");
-      }
-    }
+#ifndef LIFE_MATRIX_NO_MONTH
+class LifeMatrix::MonthScreen : public LifeMatrix::ViewScreen {
+ public:
+  explicit MonthScreen(LifeMatrix *lm) : ViewScreen(lm) {}
+  void render(display::Display &it, ESPTime &time, const Viewport &vp) override {
+    lm_->render_month_view(it, time, vp.viz_y, vp.viz_height);
   }
+};
+#endif
 
-  // Flash animation timing
-  settings_flash_ms_ = millis();
-}
+#ifndef LIFE_MATRIX_NO_DAY
+class LifeMatrix::DayScreen : public LifeMatrix::ViewScreen {
+ public:
+  explicit DayScreen(LifeMatrix *lm) : ViewScreen(lm) {}
+  void render(display::Display &it, ESPTime &time, const Viewport &vp) override {
+    lm_->render_day_view(it, time, vp.viz_y, vp.viz_height);
+  }
+};
+#endif
 
-std::string LifeMatrix::get_current_setting_name() {
-  int cursor = settings_cursor_;
-  int screen_id = get_current_screen_id();
+#ifndef LIFE_MATRIX_NO_HOUR
+class LifeMatrix::HourScreen : public LifeMatrix::ViewScreen {
+ public:
+  explicit HourScreen(LifeMatrix *lm) : ViewScreen(lm) {}
+  void render(display::Display &it, ESPTime &time, const Viewport &vp) override {
+    lm_->render_hour_view(it, time, vp.viz_y, vp.viz_height);
+  }
+};
+#endif
+
+#ifndef LIFE_MATRIX_NO_HABITS
+// The habit bits are an NVS-backed cache: prepare pulls this year's blobs ahead of the
+// first frame, and disabling the view saves and frees them (a check-in arriving while the
+// view is off loads its year again)
+class LifeMatrix::HabitsScreen : public LifeMatrix::ViewScreen {
+ public:
+  explicit HabitsScreen(LifeMatrix *lm) : ViewScreen(lm) {}
+  ~HabitsScreen() override { lm_->habit_release_(); }
+  void prepare(ESPTime &time) override {
+    if (time.is_valid()) lm_->habit_year_bits_(0, time.year);
+  }
+  void render(display::Display &it, ESPTime &time, const Viewport &vp) override {
+    lm_->render_habits_view(it, time, vp);
+  }
+};
+#endif
+
+#ifndef LIFE_MATRIX_NO_LIFESPAN
+// Owns the zoom cell tables (up to 52 cells per year of life expectancy). The biography
+// and phases stay, since birthdays also feed the year view and celebrations.
+class LifeMatrix::LifespanScreen : public LifeMatrix::ViewScreen {
+ public:
+  explicit LifespanScreen(LifeMatrix *lm) : ViewScreen(lm) { lm->precompute_lifespan_zoom_(); }
+  ~LifespanScreen() override {
+    for (auto &t : lm_->lifespan_zoom_tables_) {
+      t.marks.clear();
+      t.marks.shrink_to_fit();
+      t.seg.clear();
+      t.seg.shrink_to_fit();
+    }
+    lm_->lifespan_zoom_segs_.clear();
+    lm_->lifespan_zoom_segs_.shrink_to_fit();
+  }
+  void render(display::Display &it, ESPTime &time, const Viewport &vp) override {
+    lm_->render_lifespan_view(it, time, vp.viz_y, vp.viz_height);
+  }
+};
+#endif
+
+#ifndef LIFE_MATRIX_NO_GOL
+// Owns the two age grids and the rewind history; generations advance in step()
+class LifeMatrix::GolScreen : public LifeMatrix::ViewScreen {
+ public:
+  explicit GolScreen(LifeMatrix *lm) : ViewScreen(lm) {
+    size_t n = (size_t)lm->grid_width_ * lm->grid_height_;
+    lm->game_grid_.assign(n, 0);
+    lm->game_grid_back_.assign(n, 0);
+  }
+  ~GolScreen() override {
+    lm_->game_initialized_ = false;
+    lm_->rewind_clear_();
+    lm_->rewind_segments_.shrink_to_fit();
+    for (auto *v : {&lm_->game_grid_, &lm_->game_grid_back_, &lm_->rewind_last_, &lm_->rewind_pack_,
+                    &lm_->rewind_view_, &lm_->rewind_ages_}) {
+      v->clear();
+      v->shrink_to_fit();
+    }
+  }
+  void prepare(ESPTime &time) override {
+    // Enabled after boot: show the rules first, the world is seeded when they end. The
+    // rules' timer starts on the first visible frame, not the pre-warm pass.
+    if (lm_->prewarm_pass_) return;
+    if (!lm_->game_initialized_ && !lm_->game_demo_mode_ && !lm_->game_reset_animation_) lm_->set_demo_mode(true);
+  }
+  void step(uint32_t now_ms) override {
+    if (!running_()) return;
+    lm_->update_game_of_life();
 
-  // Global settings
-  if (cursor == 0) return "Brite";
-  if (cursor == 1) return "Cycle";
-  if (cursor == 2) return "Text";
+    // Check for long-standing stability and reset if needed
+    if (lm_->game_is_stable_ && lm_->game_config_.auto_reset_on_stable) {
+      unsigned long elapsed = now_ms - lm_->game_stable_since_;
+      if (elapsed >= (unsigned long)lm_->game_config_.stability_timeout_ms) {
+        ESP_LOGD(TAG, "Auto-resetting Game of Life after %lu ms of stability", elapsed);
+        lm_->reset_game_of_life();
+      }
+    }
+  }
+  void render(display::Display &it, ESPTime &time, const Viewport &vp) override {
+    lm_->render_game_of_life(it, vp.viz_y, vp.viz_height);
+  }
+  uint32_t next_change_time(uint32_t now_ms) override {
+    if (!running_()) return now_ms;
+    return lm_->game_last_update_ + lm_->game_config_.update_interval_ms;
+  }
 
-  // Per-screen settings
-  int local = cursor - 3;
-  if (screen_id == SCREEN_HOUR) {
-    if (local == 0) return "Style";
-    if (local == 1) return "Grad";
-    if (local == 2) return "Fill";
-    if (local == 3) return "Mark";
-    if (local == 4) return "MkClr";
-  } else if (screen_id == SCREEN_DAY) {
-    if (local == 0) return "Sleep";
-    if (local == 1) return "WkBeg";
-    if (local == 2) return "WkEnd";
-  } else if (screen_id == SCREEN_GAME_OF_LIFE) {
-    if (local == 0) return "Speed";
-    if (local == 1) return "Cmplx";
-  } else if (screen_id == SCREEN_MONTH) {
-    if (local == 0) return "Style";
-    if (local == 1) return "Fill";
-    if (local == 2) return "DFill";
-    if (local == 3) return "MkClr";
-  } else if (screen_id == SCREEN_YEAR) {
-    if (local == 0) return "Style";
-    if (local == 1) return "Mark";
-    if (local == 2) return "DFill";
-    if (local == 3) return "Event";
-  } else if (screen_id == SCREEN_POMODORO) {
-    if (local == 0) return "Style";
-    if (local == 1) return "Grad";
-    if (local == 2) return "Prset";
-    if (local == 3) return "Rnds";
-    if (local == 4) return "ExSnc";
-  }
-  return "?";
-}
-
-std::string LifeMatrix::get_current_setting_value() {
-  int cursor = settings_cursor_;
-  int screen_id = get_current_screen_id();
-  char buf[32];
+ protected:
+  // Not in reset/demo state and not being scrubbed
+  bool running_() const {
+    return lm_->game_initialized_ && !lm_->game_reset_animation_ && !lm_->game_demo_mode_ && lm_->rewind_gen_ < 0;
+  }
+};
+#endif
+
+#ifndef LIFE_MATRIX_NO_POMODORO
+// Owns the block fill spiral and, without the heatmap, the session log cache; the timer
+// itself keeps running while the view is off
+class LifeMatrix::PomodoroScreen : public LifeMatrix::ViewScreen {
+ public:
+  explicit PomodoroScreen(LifeMatrix *lm) : ViewScreen(lm) {}
+  ~PomodoroScreen() override {
+    lm_->pomo_spiral_x_.clear();
+    lm_->pomo_spiral_x_.shrink_to_fit();
+    lm_->pomo_spiral_y_.clear();
+    lm_->pomo_spiral_y_.shrink_to_fit();
+    lm_->pomo_spiral_w_ = lm_->pomo_spiral_h_ = -1;
+    if (!lm_->pomo_heatmap_) lm_->pomo_log_release_();
+  }
+  void render(display::Display &it, ESPTime &time, const Viewport &vp) override {
+    lm_->render_pomodoro_view(it, time, vp);
+  }
+};
+#endif
 
-  // Global settings (these need to be read from external state in YAML)
-  if (cursor == 0) return "**";  // Brightness - read from HA entity
-  if (cursor == 1) return "**";  // Cycle time - read from HA entity
-  if (cursor == 2) {
-    // Text area position
-    if (text_area_position_ == "Top") return "Top";
-    if (text_area_position_ == "Bottom") return "Bottom";
-    return "None";
+#ifndef LIFE_MATRIX_NO_SENSORS
+class LifeMatrix::SensorsScreen : public LifeMatrix::ViewScreen {
+ public:
+  explicit SensorsScreen(LifeMatrix *lm) : ViewScreen(lm) {}
+  void render(display::Display &it, ESPTime &time, const Viewport &vp) override {
+    lm_->render_sensor_graph_view(it, vp);
   }
+};
+#endif
 
-  // Per-screen settings
-  int local = cursor - 3;
-  if (screen_id == SCREEN_HOUR) {
-    if (local == 0) {
-      // Color scheme
-      if (style_ == STYLE_SINGLE) return "Singl";
-      if (style_ == STYLE_GRADIENT) return "Gradt";
-      if (style_ == STYLE_TIME_SEGMENTS) return "TmSeg";
-      if (style_ == STYLE_RAINBOW) return "Rainb";
-    } else if (local == 1) {
-      // Gradient type
-      if (gradient_type_ == GRADIENT_RED_BLUE) return "RedBl";
-      if (gradient_type_ == GRADIENT_GREEN_YELLOW) return "GrnYl";
-      if (gradient_type_ == GRADIENT_CYAN_MAGENTA) return "CynMg";
-      if (gradient_type_ == GRADIENT_PURPLE_ORANGE) return "PurOr";
-      if (gradient_type_ == GRADIENT_BLUE_YELLOW) return "BluYl";
-    } else if (local == 2) {
-      // Fill direction
-      return fill_direction_bottom_to_top_ ? "BotT" : "TopB";
-    } else if (local == 3) {
-      // Marker style
-      if (marker_style_ == MARKER_NONE) return "None";
-      if (marker_style_ == MARKER_SINGLE_DOT) return "Dot";
-      if (marker_style_ == MARKER_GRADIENT_PEAK) return "Peak";
-    } else if (local == 4) {
-      // Marker color
-      if (marker_color_ == MARKER_BLUE) return "Blue";
-      if (marker_color_ == MARKER_WHITE) return "White";
-      if (marker_color_ == MARKER_YELLOW) return "Yellw";
-      if (marker_color_ == MARKER_RED) return "Red";
-      if (marker_color_ == MARKER_GREEN) return "Green";
-      if (marker_color_ == MARKER_CYAN) return "Cyan";
-      if (marker_color_ == MARKER_MAGENTA) return "Magnt";
-    }
-  } else if (screen_id == SCREEN_DAY) {
-    if (local == 0) {
-      snprintf(buf, sizeof(buf), "%dh", time_segments_.bed_time_hour);
-      return buf;
-    } else if (local == 1) {
-      snprintf(buf, sizeof(buf), "%dh", time_segments_.work_start_hour);
-      return buf;
-    } else if (local == 2) {
-      snprintf(buf, sizeof(buf), "%dh", time_segments_.work_end_hour);
-      return buf;
-    }
-  } else if (screen_id == SCREEN_GAME_OF_LIFE) {
-    if (local == 0) {
-      // Speed
-      int ms = game_config_.update_interval_ms;
-      if (ms <= 50) return "Fast";
-      if (ms <= 200) return "Norml";
-      return "Slow";
-    } else if (local == 1) {
-      return game_config_.complex_patterns ? "ON" : "OFF";
-    }
-  } else if (screen_id == SCREEN_MONTH) {
-    if (local == 0) {
-      if (style_ == STYLE_SINGLE) return "Singl";
-      if (style_ == STYLE_GRADIENT) return "Gradt";
-      if (style_ == STYLE_TIME_SEGMENTS) return "TmSeg";
-      if (style_ == STYLE_RAINBOW) return "Rainb";
-    } else if (local == 1) {
-      return fill_direction_bottom_to_top_ ? "BotT" : "TopB";
-    } else if (local == 2) {
-      // Day fill
-      if (day_fill_style_ == DAY_FILL_ACTIVITY) return "Fixed";
-      if (day_fill_style_ == DAY_FILL_SCHEME) return "Flat";
-      if (day_fill_style_ == DAY_FILL_MIXED) return "Shade";
-    } else if (local == 3) {
-      if (marker_color_ == MARKER_BLUE) return "Blue";
-      if (marker_color_ == MARKER_WHITE) return "White";
-      if (marker_color_ == MARKER_YELLOW) return "Yellw";
-      if (marker_color_ == MARKER_RED) return "Red";
-      if (marker_color_ == MARKER_GREEN) return "Green";
-      if (marker_color_ == MARKER_CYAN) return "Cyan";
-      if (marker_color_ == MARKER_MAGENTA) return "Magnt";
-    }
-  } else if (screen_id == SCREEN_YEAR) {
-    if (local == 0) {
-      // Color scheme
-      if (style_ == STYLE_SINGLE) return "Singl";
-      if (style_ == STYLE_GRADIENT) return "Gradt";
-      if (style_ == STYLE_TIME_SEGMENTS) return "TmSeg";
-      if (style_ == STYLE_RAINBOW) return "Rainb";
-    } else if (local == 1) {
-      // Marker style
-      if (marker_style_ == MARKER_NONE) return "None";
-      if (marker_style_ == MARKER_SINGLE_DOT) return "Dot";
-      if (marker_style_ == MARKER_GRADIENT_PEAK) return "Peak";
-    } else if (local == 2) {
-      // Day fill
-      if (day_fill_style_ == DAY_FILL_ACTIVITY) return "Fixed";
-      if (day_fill_style_ == DAY_FILL_SCHEME) return "Flat";
-      if (day_fill_style_ == DAY_FILL_MIXED) return "Shade";
-    } else if (local == 3) {
-      // Event style
-      if (year_event_style_ == YEAR_EVENT_NONE) return "None";
-      if (year_event_style_ == YEAR_EVENT_PULSE) return "Pulse";
-      if (year_event_style_ == YEAR_EVENT_MARKERS) return "Marks";
-    }
-  } else if (screen_id == SCREEN_POMODORO) {
-    if (local == 0) {
-      if (style_ == STYLE_SINGLE) return "Singl";
-      if (style_ == STYLE_GRADIENT) return "Gradt";
-      if (style_ == STYLE_TIME_SEGMENTS) return "TmSeg";
-      if (style_ == STYLE_RAINBOW) return "Rainb";
-    } else if (local == 1) {
-      if (gradient_type_ == GRADIENT_RED_BLUE) return "RedBl";
-      if (gradient_type_ == GRADIENT_GREEN_YELLOW) return "GrnYl";
-      if (gradient_type_ == GRADIENT_CYAN_MAGENTA) return "CynMg";
-      if (gradient_type_ == GRADIENT_PURPLE_ORANGE) return "PurOr";
-      if (gradient_type_ == GRADIENT_BLUE_YELLOW) return "BluYl";
-    } else if (local == 2) {
-      if (pomo_preset_ == POMO_PRESET_CLASSIC) return "25-5";
-      if (pomo_preset_ == POMO_PRESET_DEEP_WORK) return "50-10";
-      if (pomo_preset_ == POMO_PRESET_ULTRADIAN) return "90-20";
-    } else if (local == 3) {
-      char buf[4];
-      snprintf(buf, sizeof(buf), "%d", pomo_rounds_before_long_break_);
-      return buf;
-    } else if (local == 4) {
-      return exercise_snacks_enabled_ ? "On" : "Off";
-    }
-  }
-  return "?";
+std::unique_ptr<Screen> LifeMatrix::create_screen_(int screen_id) {
+  switch (screen_id) {
+#ifndef LIFE_MATRIX_NO_YEAR
+    case SCREEN_YEAR:         return std::unique_ptr<Screen>(new YearScreen(this));
+#endif
+#ifndef LIFE_MATRIX_NO_MONTH
+    case SCREEN_MONTH:        return std::unique_ptr<Screen>(new MonthScreen(this));
+#endif
+#ifndef LIFE_MATRIX_NO_DAY
+    case SCREEN_DAY:          return std::unique_ptr<Screen>(new DayScreen(this));
+#endif
+#ifndef LIFE_MATRIX_NO_HOUR
+    case SCREEN_HOUR:         return std::unique_ptr<Screen>(new HourScreen(this));
+#endif
+#ifndef LIFE_MATRIX_NO_HABITS
+    case SCREEN_HABITS:       return std::unique_ptr<Screen>(new HabitsScreen(this));
+#endif
+#ifndef LIFE_MATRIX_NO_LIFESPAN
+    case SCREEN_LIFESPAN:     return std::unique_ptr<Screen>(new LifespanScreen(this));
+#endif
+#ifndef LIFE_MATRIX_NO_GOL
+    case SCREEN_GAME_OF_LIFE: return std::unique_ptr<Screen>(new GolScreen(this));
+#endif
+#ifndef LIFE_MATRIX_NO_POMODORO
+    case SCREEN_POMODORO:     return std::unique_ptr<Screen>(new PomodoroScreen(this));
+#endif
+#ifndef LIFE_MATRIX_NO_SENSORS
+    case SCREEN_SENSORS:      return std::unique_ptr<Screen>(new SensorsScreen(this));
+#endif
+    default:                  return nullptr;
+  }
+}
+
+Screen *LifeMatrix::find_screen_(int screen_id) {
+  for (auto &screen : screens_) {
+    if (screen.id == screen_id) return screen.screen.get();
+  }
+  return nullptr;
 }
 
 // ============================================================================
@@ -920,7 +1730,7 @@ void LifeMatrix::register_screen(int screen_id, bool enabled) {
     if (screen.id == screen_id) {
       screen.enabled = enabled;
       found = true;
-      ESP_LOGD(TAG, "Updated screen %d (%s): %s", screen_id, screen.name.c_str(), enabled ? "enabled" : "disabled");
+      ESP_LOGD(TAG, "Updated screen %d (%s): %s", screen_id, screen.name, enabled ? "enabled" : "disabled");
       break;
     }
   }
@@ -941,11 +1751,27 @@ void LifeMatrix::register_screen(int screen_id, bool enabled) {
       case SCREEN_GAME_OF_LIFE: config.name = "Conway"; break;
       case SCREEN_LIFESPAN:  config.name = "Life"; break;
       case SCREEN_POMODORO:  config.name = "Pomo"; break;
+      case SCREEN_SENSORS:   config.name = "Graph"; break;
       default: config.name = "Unknown"; break;
     }
 
-    screens_.push_back(config);
-    ESP_LOGD(TAG, "Registered new screen %d (%s): %s", screen_id, config.name.c_str(), enabled ? "enabled" : "disabled");
+    screens_.push_back(std::move(config));
+    ESP_LOGD(TAG, "Registered new screen %d (%s): %s", screen_id, screens_.back().name, enabled ? "enabled" : "disabled");
+  }
+
+  // The view's state follows its switch: allocated on enable, released on disable
+  for (auto &screen : screens_) {
+    if (screen.id != screen_id) continue;
+    if (enabled && !screen.screen) {
+      screen.screen = create_screen_(screen_id);
+      // Compiled out (screens: <name>: include: false): keep it out of the cycle
+      if (!screen.screen) {
+        ESP_LOGW(TAG, "Screen %d (%s) is not built into this firmware", screen_id, screen.name);
+        screen.enabled = false;
+      }
+    } else if (!enabled && screen.screen) {
+      screen.screen.reset();
+    }
   }
 
   // Always rebuild enabled screens list to ensure consistency
@@ -988,12 +1814,46 @@ void LifeMatrix::update_screen_cycle() {
   unsigned long cycle_interval_ms = (unsigned long)(screen_cycle_time_ * 1000.0f);
 
   if ((current_time_ms - last_switch_time_) >= cycle_interval_ms) {
+    int from_id = get_current_screen_id();
     current_screen_idx_ = (current_screen_idx_ + 1) % enabled_screen_ids_.size();
+    start_transition_(from_id, +1);
     last_switch_time_ = current_time_ms;
     ESP_LOGD(TAG, "Auto-cycled to screen index %d (ID %d)", current_screen_idx_, get_current_screen_id());
   }
 }
 
+void LifeMatrix::update_prewarm_() {
+  static const uint32_t PREWARM_MAX_LEAD_MS = 500;
+  if (ui_mode_ != AUTO_CYCLE || ui_paused_ || enabled_screen_ids_.size() < 2) return;
+  if (transition_active_ || layout_.width <= 0 || frame_period_ms_ == 0) return;
+
+  // Only within the last frame period before the switch: earlier, the frame it warms
+  // would be re-rendered anyway before the switch frame needs it
+  uint32_t cycle_ms = (uint32_t)(screen_cycle_time_ * 1000.0f);
+  uint32_t lead_ms = std::min(frame_period_ms_, PREWARM_MAX_LEAD_MS);
+  if (millis() - last_switch_time_ + lead_ms < cycle_ms) return;
+  int next_id = enabled_screen_ids_[(current_screen_idx_ + 1) % enabled_screen_ids_.size()];
+  if (next_id == prewarmed_screen_) return;
+
+  // prepare() builds the screen's tables and lazy buffers. With transitions on, the switch
+  // renders into transition_to_ anyway, so a render there settles the draw-time caches too;
+  // without them the canvas is never allocated. prewarm_pass_ keeps both from advancing
+  // demo timers or phase cycles.
+  uint32_t start_us = micros();
+  ESPTime t = get_display_time();
+  prewarm_pass_ = true;
+  if (Screen *screen = find_screen_(next_id)) screen->prepare(t);
+  if (transition_style_ != TRANSITION_NONE && transition_duration_ms_ > 0) {
+    transition_to_.resize(layout_.width, layout_.height);
+    transition_to_.clear();
+    Viewport vp = calculate_viewport(transition_to_);
+    render_screen_(transition_to_, next_id, t, vp);
+  }
+  prewarm_pass_ = false;
+  prewarmed_screen_ = next_id;
+  ESP_LOGV(TAG, "Pre-warmed screen %d in %u us", next_id, (unsigned)(micros() - start_us));
+}
+
 void LifeMatrix::next_screen() {
   if (enabled_screen_ids_.empty()) {
     return;
@@ -1002,8 +1862,10 @@ void LifeMatrix::next_screen() {
   handle_input();  // Reset timeout
   set_ui_mode(MANUAL_BROWSE);
 
+  int from_id = get_current_screen_id();
   current_screen_idx_ = (current_screen_idx_ + 1) % enabled_screen_ids_.size();
   last_switch_time_ = millis();
+  start_transition_(from_id, +1);
 
   ESP_LOGD(TAG, "Next screen: index %d (ID %d)", current_screen_idx_, get_current_screen_id());
 }
@@ -1016,11 +1878,13 @@ void LifeMatrix::prev_screen() {
   handle_input();  // Reset timeout
   set_ui_mode(MANUAL_BROWSE);
 
+  int from_id = get_current_screen_id();
   current_screen_idx_--;
   if (current_screen_idx_ < 0) {
     current_screen_idx_ = enabled_screen_ids_.size() - 1;
   }
   last_switch_time_ = millis();
+  start_transition_(from_id, -1);
 
   ESP_LOGD(TAG, "Prev screen: index %d (ID %d)", current_screen_idx_, get_current_screen_id());
 }
@@ -1030,8 +1894,10 @@ void LifeMatrix::set_current_screen(int screen_idx) {
     return;
   }
 
+  int from_id = get_current_screen_id();
   current_screen_idx_ = screen_idx % enabled_screen_ids_.size();
   last_switch_time_ = millis();
+  start_transition_(from_id, +1);
 }
 
 int LifeMatrix::get_current_screen_id() {
@@ -1069,6 +1935,86 @@ Viewport LifeMatrix::calculate_viewport(display::Display &it) {
   return vp;
 }
 
+// Rebuilds the geometry tables only when the display size or viewport changes (text area
+// moved, different panel chain); every other frame this is four integer compares.
+const ViewLayout &LifeMatrix::update_layout(display::Display &it, const Viewport &vp) {
+  int width = it.get_width();
+  int height = it.get_height();
+  ViewLayout &lay = layout_;
+  if (lay.width == width && lay.height == height &&
+      lay.viz_y == vp.viz_y && lay.viz_height == vp.viz_height) {
+    return lay;
+  }
+  lay.width = width;
+  lay.height = height;
+  lay.viz_y = vp.viz_y;
+  lay.viz_height = vp.viz_height;
+  int rows = std::max(1, vp.viz_height);
+
+  // Bar area: one marker column each side when there is room for it
+  lay.bar_x = (width >= 8) ? 1 : 0;
+  lay.bar_w = std::max(1, width - 2 * lay.bar_x);
+
+#ifndef LIFE_MATRIX_NO_DAY
+  // Day view: 24 h spread over all visible rows
+  lay.day_row_minute.resize(rows);
+  for (int r = 0; r < rows; r++) lay.day_row_minute[r] = (uint16_t)(r * 1440 / rows);
+  day_row_type_.assign(rows, 0);
+  day_life_progress_.assign(rows, 0.0f);
+#endif
+
+#ifndef LIFE_MATRIX_NO_HOUR
+  // Hour view: 3600 s spread over all visible rows
+  lay.hour_row_second.resize(rows + 1);
+  for (int r = 0; r <= rows; r++) lay.hour_row_second[r] = (uint16_t)(r * 3600 / rows);
+#endif
+
+  // Hour view Time Segments: clockwise spiral from the top-left corner of a quarter. Cells
+  // are stored as offsets into the quarter, so any width fits while a quarter stays under
+  // 64 Ki pixels; a larger one would need wider entries and is left without a spiral.
+  lay.quarter_h = std::max(1, rows / 4);
+  lay.quarter_spiral.clear();
+  if ((long)lay.bar_w * lay.quarter_h > 65536) {
+    ESP_LOGW(TAG, "Layout: %dx%d hour quarter is too large for the Time Segments spiral", lay.bar_w, lay.quarter_h);
+  } else {
+    lay.quarter_spiral.reserve(lay.bar_w * lay.quarter_h);
+    const int w = lay.bar_w;
+    int top = 0, bot = lay.quarter_h - 1, left = 0, right = lay.bar_w - 1;
+    while (top <= bot && left <= right) {
+      for (int x = left; x <= right; x++) lay.quarter_spiral.push_back((uint16_t)(top * w + x));
+      top++;
+      for (int y = top; y <= bot; y++) lay.quarter_spiral.push_back((uint16_t)(y * w + right));
+      right--;
+      if (top <= bot) {
+        for (int x = right; x >= left; x--) lay.quarter_spiral.push_back((uint16_t)(bot * w + x));
+        bot--;
+      }
+      if (left <= right) {
+        for (int y = bot; y >= top; y--) lay.quarter_spiral.push_back((uint16_t)(y * w + left));
+        left++;
+      }
+    }
+  }
+
+  // Month grid: ~8 px wide cells, enough rows for 31 days, leftover width split evenly
+  lay.month_cols = std::max(1, std::min(31, width / 8));
+  lay.month_rows = (31 + lay.month_cols - 1) / lay.month_cols;
+  lay.month_cell_w = width / lay.month_cols;
+  lay.month_cell_h = std::max(2, rows / lay.month_rows);
+  lay.month_x0 = (width - lay.month_cols * lay.month_cell_w) / 2;
+
+  // Year view: column 0 keeps month/event markers, days share the rest
+  lay.year_month_h = std::max(1, rows / 12);
+  lay.year_day_w = std::max(1, (width - 1) / 31);
+  for (int d = 1; d <= 31; d++) lay.year_day_x[d] = (uint16_t)(1 + (d - 1) * lay.year_day_w);
+
+  ESP_LOGD(TAG, "Layout %dx%d viz %d+%d: bar %d+%d, month %dx%d@%dx%d, quarter spiral %d px",
+           width, height, vp.viz_y, vp.viz_height, lay.bar_x, lay.bar_w,
+           lay.month_cols, lay.month_rows, lay.month_cell_w, lay.month_cell_h,
+           (int)lay.quarter_spiral.size());
+  return lay;
+}
+
 Color LifeMatrix::dim_future(Color c) const {
   if (!show_future_) return Color(0, 0, 0);
   return Color(c.r / 10, c.g / 10, c.b / 10);
@@ -1093,24 +2039,374 @@ Color LifeMatrix::hsv_to_rgb(int hue, float saturation, float value) {
   }
 }
 
-// draw_pixel: routes all main-display pixels through the active per-frame color transform.
-// CTM_HUE_SHIFT uses a precomputed circulant matrix (set in render() pre-render block):
-//   a = cosθ + (1-cosθ)/3   b = (1-cosθ)/3 + sinθ/√3   c = (1-cosθ)/3 - sinθ/√3
-//   r' = a·r + c·g + b·b    g' = b·r + a·g + c·b    b' = c·r + b·g + a·b
-// Celebration overlay functions call it.draw_pixel_at directly to bypass transforms.
-void LifeMatrix::draw_pixel(display::Display &it, int x, int y, Color c) {
-  if (ctm_ == CTM_HUE_SHIFT && (c.r | c.g | c.b)) {
-    int r = (int)(c.r * hue_mat_a_ + c.g * hue_mat_c_ + c.b * hue_mat_b_);
-    int g = (int)(c.r * hue_mat_b_ + c.g * hue_mat_a_ + c.b * hue_mat_c_);
-    int b = (int)(c.r * hue_mat_c_ + c.g * hue_mat_b_ + c.b * hue_mat_a_);
-    c = Color((uint8_t)(r < 0 ? 0 : r > 255 ? 255 : r),
-              (uint8_t)(g < 0 ? 0 : g > 255 ? 255 : g),
-              (uint8_t)(b < 0 ? 0 : b > 255 ? 255 : b));
-  }
-  it.draw_pixel_at(x, y, c);
+// draw_pixel: routes all main-display pixels through the active per-frame color transform.
+// CTM_HUE_SHIFT uses a precomputed circulant matrix (set in render() pre-render block):
+//   a = cosθ + (1-cosθ)/3   b = (1-cosθ)/3 + sinθ/√3   c = (1-cosθ)/3 - sinθ/√3
+//   r' = a·r + c·g + b·b    g' = b·r + a·g + c·b    b' = c·r + b·g + a·b
+// Celebration overlay functions call draw_raw_pixel_ to bypass transforms.
+// In palette render mode the raw color is interned instead and the transform runs per
+// palette slot in palette_present_().
+void LifeMatrix::draw_pixel(display::Display &it, int x, int y, Color c) {
+  if (palette_frame_active_ && palette_put_(x, y, c, false)) return;
+  Color out = apply_color_transform(c);
+  power_note_(it, out);
+  it.draw_pixel_at(x, y, out);
+}
+
+void LifeMatrix::draw_raw_pixel_(display::Display &it, int x, int y, Color c) {
+  if (palette_frame_active_ && palette_put_(x, y, c, true)) return;
+  power_note_(it, c);
+  it.draw_pixel_at(x, y, c);
+}
+
+Color LifeMatrix::apply_color_transform(Color c) const {
+  if (ctm_ != CTM_HUE_SHIFT || !(c.r | c.g | c.b)) return c;
+  int r = (int)(c.r * hue_mat_a_ + c.g * hue_mat_c_ + c.b * hue_mat_b_);
+  int g = (int)(c.r * hue_mat_b_ + c.g * hue_mat_a_ + c.b * hue_mat_c_);
+  int b = (int)(c.r * hue_mat_c_ + c.g * hue_mat_b_ + c.b * hue_mat_a_);
+  return Color((uint8_t)(r < 0 ? 0 : r > 255 ? 255 : r),
+               (uint8_t)(g < 0 ? 0 : g > 255 ? 255 : g),
+               (uint8_t)(b < 0 ? 0 : b > 255 ? 255 : b));
+}
+
+// ============================================================================
+// PALETTE-INDEXED RENDERING
+// ============================================================================
+// Views keep calling draw_pixel(); while a palette frame is open each pixel costs one
+// byte in palette_index_buf_ and the colors themselves live in palette_[] (≤255 slots).
+// Global per-frame effects therefore touch palette_count_ entries instead of every
+// pixel. Slot 0 means "not drawn" and presents black, like the cleared display.
+//
+// Everything the frame draws lands in the canvas, in draw order: text through direct_(),
+// whose PaletteText front feeds the font engine's pixels in as raw slots (no color
+// transform, as in direct mode), and overlays through draw_raw_pixel_(). The frame is
+// presented once, after the overlays, as RGB565 row blocks through draw_pixels_at(). Only
+// a frame with more than 255 colors presents early and finishes direct. Between frames the
+// canvas and resolved palette are the presented frame, which the power estimator and the
+// snapshot read instead of keeping an RGB copy.
+//
+// The canvas is laid out in the panel's native scan order. Views still address it with
+// logical (x, y); the display rotation is folded into canvas_step_x_/canvas_step_y_, so
+// each write stays a single multiply-add and present is a sequential native-order sweep
+// with the display's own per-pixel rotation switched off.
+
+static inline uint16_t to_rgb565(Color c) {
+  return (uint16_t)(((c.r & 0xF8) << 8) | ((c.g & 0xFC) << 3) | (c.b >> 3));
+}
+
+static inline Color from_rgb565(uint16_t p) {
+  uint8_t r = (p >> 11) & 0x1F, g = (p >> 5) & 0x3F, b = p & 0x1F;
+  return Color((uint8_t)((r << 3) | (r >> 2)), (uint8_t)((g << 2) | (g >> 4)), (uint8_t)((b << 3) | (b >> 2)));
+}
+
+static inline uint32_t rgb565_channel_sum(uint16_t px) {
+  Color c = from_rgb565(px);
+  return (uint32_t)c.r + c.g + c.b;
+}
+
+// Runs every frame after update_layout(); only a rotation or layout size change does work.
+void LifeMatrix::configure_canvas_(display::Display &it) {
+  display::DisplayRotation rot = it.get_rotation();
+  const int lw = layout_.width, lh = layout_.height;
+  if (rot == canvas_rotation_ && lw == canvas_lw_ && lh == canvas_lh_) return;
+  canvas_rotation_ = rot;
+  if (lw != canvas_lw_ || lh != canvas_lh_) {
+    canvas_lw_ = lw;
+    canvas_lh_ = lh;  // the palette buffer is resized in palette_begin_()
+  }
+
+  int nw = it.get_native_width();
+  int nh = it.get_native_height();
+  bool quarter_turn = (rot == display::DISPLAY_ROTATION_90_DEGREES ||
+                       rot == display::DISPLAY_ROTATION_270_DEGREES);
+  int cw = quarter_turn ? lh : lw;   // canvas row length in native pixels
+  int ch = quarter_turn ? lw : lh;
+
+  // Logical layout is the fallback whenever the native panel can't hold the canvas
+  canvas_native_ = native_canvas_ && rot != display::DISPLAY_ROTATION_0_DEGREES && nw >= cw && nh >= ch;
+  if (!canvas_native_) {
+    canvas_w_ = lw;      canvas_h_ = lh;
+    canvas_nx0_ = 0;     canvas_ny0_ = 0;
+    canvas_origin_ = 0;  canvas_step_x_ = 1;  canvas_step_y_ = lw;
+    ESP_LOGD(TAG, "Canvas: logical %dx%d", canvas_w_, canvas_h_);
+    return;
+  }
+
+  // Mirrors Display::draw_pixel_at() rotation: where logical (0,0) lands and which
+  // native direction +x / +y walk in, restricted to the layout-sized window.
+  canvas_w_ = cw;
+  canvas_h_ = ch;
+  switch (rot) {
+    case display::DISPLAY_ROTATION_90_DEGREES:   // nx = nw-1-y, ny = x
+      canvas_nx0_ = nw - cw;  canvas_ny0_ = 0;
+      canvas_origin_ = cw - 1;  canvas_step_x_ = cw;  canvas_step_y_ = -1;
+      break;
+    case display::DISPLAY_ROTATION_270_DEGREES:  // nx = y, ny = nh-1-x
+      canvas_nx0_ = 0;  canvas_ny0_ = nh - ch;
+      canvas_origin_ = (ch - 1) * cw;  canvas_step_x_ = -cw;  canvas_step_y_ = 1;
+      break;
+    default:                                     // 180°: nx = nw-1-x, ny = nh-1-y
+      canvas_nx0_ = nw - cw;  canvas_ny0_ = nh - ch;
+      canvas_origin_ = cw * ch - 1;  canvas_step_x_ = -1;  canvas_step_y_ = -cw;
+      break;
+  }
+  ESP_LOGD(TAG, "Canvas: native %dx%d at (%d,%d), rotation %d",
+           canvas_w_, canvas_h_, canvas_nx0_, canvas_ny0_, (int)rot);
+}
+
+void LifeMatrix::palette_begin_(display::Display &it) {
+  size_t cells = (size_t)canvas_lw_ * (size_t)canvas_lh_;
+  if (palette_index_buf_.size() != cells)
+    palette_index_buf_.assign(cells, 0);  // first frame, or the layout changed size
+  else if (palette_count_ > 1)
+    std::fill(palette_index_buf_.begin(), palette_index_buf_.end(), 0);  // the last frame's slots
+  palette_count_ = 1;
+  memset(palette_hash_, 0, sizeof(palette_hash_));
+  palette_last_key_ = UINT32_MAX;
+  palette_target_ = &it;
+  palette_frame_whole_ = false;
+  palette_frame_active_ = true;
+}
+
+// Key = raw flag << 24 | rgb: the same color drawn by a view and by text takes two slots,
+// as only the view's one goes through the color transform
+int LifeMatrix::palette_intern_(Color c, bool raw) {
+  uint32_t key = ((uint32_t)raw << 24) | ((uint32_t)c.r << 16) | ((uint32_t)c.g << 8) | c.b;
+  if (key == palette_last_key_) return palette_last_idx_;
+
+  uint32_t slot = (key * 2654435761u) >> 23;  // Fibonacci hash → top 9 bits (0..511)
+  for (int probe = 0; probe < PALETTE_HASH_SIZE; probe++, slot = (slot + 1) & (PALETTE_HASH_SIZE - 1)) {
+    uint8_t idx = palette_hash_[slot];
+    if (idx == 0) {
+      // Empty — claim it if the palette has room
+      if (palette_count_ >= PALETTE_SIZE) return 0;
+      idx = (uint8_t)palette_count_++;
+      palette_[idx] = key;
+      palette_hash_[slot] = idx;
+    } else if (palette_[idx] != key) {
+      continue;
+    }
+    palette_last_key_ = key;
+    palette_last_idx_ = idx;
+    return idx;
+  }
+  return 0;  // unreachable: table is twice the palette size
+}
+
+bool LifeMatrix::palette_put_(int x, int y, Color c, bool raw) {
+  if ((unsigned)x >= (unsigned)canvas_lw_ || (unsigned)y >= (unsigned)canvas_lh_) return false;
+  int idx = palette_intern_(c, raw);
+  if (idx == 0) {
+    // Palette exhausted (plasma-like content): flush what we have, finish the frame direct
+    palette_present_();
+    palette_frame_whole_ = false;
+    return false;
+  }
+  palette_index_buf_[canvas_origin_ + x * canvas_step_x_ + y * canvas_step_y_] = (uint8_t)idx;
+  return true;
+}
+
+display::Display &LifeMatrix::direct_(display::Display &it) {
+  if (palette_frame_active_ && &it == palette_target_) return palette_text_;
+  return it;
+}
+
+void LifeMatrix::palette_present_() {
+  if (!palette_frame_active_) return;
+  palette_frame_active_ = false;
+  palette_frame_whole_ = true;
+  display::Display &it = *palette_target_;
+
+  // Resolve in place — the frame's raw colors are not needed after this point. The
+  // RGB565 and channel-sum lookups live on the stack for the blit below.
+  uint16_t px565[PALETTE_SIZE];
+  uint16_t channel_sum[PALETTE_SIZE];
+  px565[0] = 0;
+  channel_sum[0] = 0;
+  for (int i = 1; i < palette_count_; i++) {
+    uint32_t key = palette_[i];
+    Color c((uint8_t)(key >> 16), (uint8_t)(key >> 8), (uint8_t)key);
+    if (!(key >> 24)) c = apply_color_transform(c);
+    palette_[i] = ((uint32_t)c.r << 16) | ((uint32_t)c.g << 8) | c.b;
+    px565[i] = to_rgb565(c);
+    channel_sum[i] = (uint16_t)(c.r + c.g + c.b);
+  }
+
+  // Native canvas: drop the display's rotation for the blit so every block lands on the
+  // panel in scan order, then restore it for anything drawn afterwards. Rows are staged
+  // PALETTE_BLIT_PIXELS at a time (whole rows where they fit, else row segments).
+  if (canvas_native_) it.set_rotation(display::DISPLAY_ROTATION_0_DEGREES);
+  uint16_t block[PALETTE_BLIT_PIXELS];
+  const int cols = std::min(canvas_w_, PALETTE_BLIT_PIXELS);
+  const int block_rows = std::max(1, PALETTE_BLIT_PIXELS / canvas_w_);
+  const uint8_t *canvas = palette_index_buf_.data();
+  uint32_t sum = 0;
+  for (int cy = 0; cy < canvas_h_; cy += block_rows) {
+    int rows = std::min(block_rows, canvas_h_ - cy);
+    for (int cx = 0; cx < canvas_w_; cx += cols) {
+      int n = std::min(cols, canvas_w_ - cx);
+      uint16_t *dst = block;
+      for (int r = 0; r < rows; r++) {
+        const uint8_t *src = canvas + (size_t)(cy + r) * canvas_w_ + cx;
+        for (int x = 0; x < n; x++) {
+          *dst++ = px565[src[x]];
+          sum += channel_sum[src[x]];
+        }
+      }
+      it.draw_pixels_at(canvas_nx0_ + cx, canvas_ny0_ + cy, n, rows, reinterpret_cast<const uint8_t *>(block),
+                        display::COLOR_ORDER_RGB, display::COLOR_BITNESS_565, false);
+    }
+  }
+  if (canvas_native_) it.set_rotation(canvas_rotation_);
+  power_sum_ += sum;
+}
+
+// ============================================================================
+// SCREEN TRANSITIONS
+// ============================================================================
+// While a transition runs, the outgoing and incoming screens are both rendered into
+// off-screen RGB565 FrameCanvas buffers (text included) and combined on the way out:
+//   Crossfade — SWAR blend, two pixels per 32-bit multiply-add (see blend565x2)
+//   Slide     — row offset; each output row is read straight from one of the two frames
+// Views and overlays are unchanged; celebration/UI overlays still draw on top afterwards.
+
+// Blend two packed RGB565 pairs: result = (a·α + b·(32-α)) / 32, α in 0..32.
+// Fields are split over two masks so every 5/6-bit channel has ≥5 zero bits above it,
+// which is exactly the headroom the ×α products need:
+//   lo = B0 | R0 | G1  (0x07E0F81F)      hi = (w >> 5): G0 | B1 | R1  (0x07C0F83F)
+static inline uint32_t blend565x2(uint32_t a, uint32_t b, uint32_t alpha) {
+  const uint32_t M_LO = 0x07E0F81Fu;
+  const uint32_t M_HI = 0x07C0F83Fu;
+  uint32_t inv = 32 - alpha;
+  uint32_t lo = (((a & M_LO) * alpha + (b & M_LO) * inv) >> 5) & M_LO;
+  uint32_t hi = ((((a >> 5) & M_HI) * alpha + ((b >> 5) & M_HI) * inv) >> 5) & M_HI;
+  return lo | (hi << 5);
+}
+
+void FrameCanvas::resize(int width, int height) {
+  if (width == w_ && height == h_) return;
+  w_ = width;
+  h_ = height;
+  buf_.assign((size_t)((w_ * h_ + 1) & ~1), 0);  // even length → whole 32-bit words
+}
+
+void FrameCanvas::draw_pixel_at(int x, int y, Color color) {
+  if ((unsigned)x >= (unsigned)w_ || (unsigned)y >= (unsigned)h_) return;
+  buf_[y * w_ + x] = to_rgb565(color);
+}
+
+void LifeMatrix::set_transition_style(const std::string &style) {
+  if (style == "Crossfade") transition_style_ = TRANSITION_CROSSFADE;
+  else if (style == "Slide") transition_style_ = TRANSITION_SLIDE;
+  else transition_style_ = TRANSITION_NONE;
+  if (transition_style_ == TRANSITION_NONE) transition_active_ = false;
+}
+
+void LifeMatrix::set_transition_easing(const std::string &easing) {
+  if (easing == "Linear") transition_easing_ = EASE_LINEAR;
+  else if (easing == "Ease Out") transition_easing_ = EASE_OUT;
+  else transition_easing_ = EASE_IN_OUT;
+}
+
+void LifeMatrix::start_transition_(int from_screen_id, int direction) {
+  if (transition_style_ == TRANSITION_NONE || transition_duration_ms_ == 0) return;
+  if (from_screen_id < 0 || from_screen_id == get_current_screen_id()) return;
+  // Re-triggering mid-transition (fast encoder spin) restarts from the screen being left
+  transition_from_screen_ = from_screen_id;
+  transition_from_ready_ = false;
+  transition_dir_ = (int8_t)(direction < 0 ? -1 : 1);
+  transition_start_ms_ = millis();
+  transition_active_ = true;
+}
+
+bool LifeMatrix::render_transition_(display::Display &it, ESPTime &time, const Viewport &vp) {
+  uint32_t elapsed = millis() - transition_start_ms_;
+  int to_screen = get_current_screen_id();
+  if (elapsed >= transition_duration_ms_ || to_screen < 0) {
+    transition_active_ = false;
+    return false;
+  }
+
+  float t = (float)elapsed / (float)transition_duration_ms_;
+  if (transition_easing_ == EASE_IN_OUT) {
+    t = t * t * (3.f - 2.f * t);
+  } else if (transition_easing_ == EASE_OUT) {
+    float u = 1.f - t;
+    t = 1.f - u * u * u;
+  }
+
+  // Only the incoming screen is rendered per frame: the outgoing one is a still
+  int w = it.get_width();
+  int h = it.get_height();
+  if (!transition_from_ready_) {
+    transition_from_.resize(w, h);
+    transition_from_.clear();
+    render_screen_(transition_from_, transition_from_screen_, time, vp);
+    transition_from_ready_ = true;
+  }
+  transition_to_.resize(w, h);
+  transition_to_.clear();
+  render_screen_(transition_to_, to_screen, time, vp);
+
+  const uint16_t *from_px = transition_from_.pixels();
+  uint16_t *to_px = transition_to_.pixels();
+
+  if (transition_style_ == TRANSITION_CROSSFADE) {
+    // Blend in place into the incoming frame, two pixels per word
+    uint32_t alpha = (uint32_t)(t * 32.f + 0.5f);
+    uint32_t *dst = transition_to_.words();
+    const uint32_t *src = reinterpret_cast<const uint32_t *>(from_px);
+    int words = (transition_to_.pixel_count() + 1) / 2;
+    for (int i = 0; i < words; i++) dst[i] = blend565x2(dst[i], src[i], alpha);
+    blit565_(it, 0, h, to_px);
+    return true;
+  }
+
+  // Slide: next pushes the old frame up and pulls the new one in from below; prev reverses.
+  // Either way the output is two contiguous row blocks, one from each frame.
+  int offset = std::min((int)(t * (float)h + 0.5f), h);
+  if (transition_dir_ > 0) {
+    blit565_(it, 0, h - offset, from_px + offset * w);
+    blit565_(it, h - offset, offset, to_px);
+  } else {
+    blit565_(it, 0, offset, to_px + (h - offset) * w);
+    blit565_(it, offset, h - offset, from_px);
+  }
+  return true;
+}
+
+// Full-width RGB565 rows to the display in one draw_pixels_at() call, as live_blit_()
+// does for DDP payloads; the frame's channel sum is taken from the same rows
+void LifeMatrix::blit565_(display::Display &it, int y, int rows, const uint16_t *px) {
+  int w = it.get_width();
+  if (rows <= 0 || w <= 0) return;
+  it.draw_pixels_at(0, y, w, rows, reinterpret_cast<const uint8_t *>(px), display::COLOR_ORDER_RGB,
+                    display::COLOR_BITNESS_565, false);
+  if (&it != frame_target_ || !power_limit_enabled_) return;
+  for (int i = 0; i < w * rows; i++) power_sum_ += rgb565_channel_sum(px[i]);
+}
+
+void LifeMatrix::render_screen_(display::Display &it, int screen_id, ESPTime &display_time, const Viewport &vp) {
+  Screen *screen = find_screen_(screen_id);
+  if (screen != nullptr) screen->render(it, display_time, vp);
 }
 
 void LifeMatrix::render(display::Display &it, ESPTime &time) {
+  // Asleep: the display lambda still clears its buffer, so the frame pushed
+  // while entering sleep is black
+  if (sleeping_ || live_active_) return;
+  BusyScope busy(busy_us_);
+  uint32_t frame_start_us = micros();
+  frame_target_ = &it;
+
+  // Frame period (EMA of render() intervals) bounds the pre-warm lead
+  uint32_t frame_ms = millis();
+  if (last_render_ms_ != 0) {
+    uint32_t period = frame_ms - last_render_ms_;
+    frame_period_ms_ = frame_period_ms_ == 0 ? period : (frame_period_ms_ * 7 + period) / 8;
+  }
+  last_render_ms_ = frame_ms;
+
   // Build display time — uses fake time (ticking forward) when override is active
   ESPTime display_time_val = get_display_time();
   ESPTime &display_time = display_time_val;
@@ -1118,8 +2414,10 @@ void LifeMatrix::render(display::Display &it, ESPTime &time) {
   // Check for hourly celebration trigger (on all screens)
   check_celebration(display_time);
 
-  // Calculate viewport
+  // Calculate viewport and (on size/viewport change) the geometry tables
   Viewport vp = calculate_viewport(it);
+  update_layout(it, vp);
+  configure_canvas_(it);
 
   // Get current screen to render
   int screen_id = get_current_screen_id();
@@ -1128,8 +2426,9 @@ void LifeMatrix::render(display::Display &it, ESPTime &time) {
     // No screens enabled
     int center_x = it.get_width() / 2;
     int center_y = it.get_height() / 2;
-    it.print(center_x, center_y - 5, font_small_, color_active_, display::TextAlign::CENTER, "No");
-    it.print(center_x, center_y + 5, font_small_, color_active_, display::TextAlign::CENTER, "Views");
+    direct_(it).print(center_x, center_y - 5, font_small_, color_active_, display::TextAlign::CENTER, "No");
+    direct_(it).print(center_x, center_y + 5, font_small_, color_active_, display::TextAlign::CENTER, "Views");
+    finish_frame_();
     return;
   }
 
@@ -1151,38 +2450,22 @@ void LifeMatrix::render(display::Display &it, ESPTime &time) {
     ctm_ = CTM_HUE_SHIFT;
   }
 
-  // Render the appropriate screen
-  switch (screen_id) {
-    case SCREEN_YEAR:
-      render_year_view(it, display_time, vp.viz_y, vp.viz_height);
-      break;
-    case SCREEN_MONTH:
-      render_month_view(it, display_time, vp.viz_y, vp.viz_height);
-      break;
-    case SCREEN_DAY:
-      render_day_view(it, display_time, vp.viz_y, vp.viz_height);
-      break;
-    case SCREEN_HOUR:
-      render_hour_view(it, display_time, vp.viz_y, vp.viz_height);
-      break;
-    case SCREEN_GAME_OF_LIFE:
-      render_game_of_life(it, vp.viz_y, vp.viz_height);
-      break;
-    case SCREEN_LIFESPAN:
-      render_lifespan_view(it, display_time, vp.viz_y, vp.viz_height);
-      break;
-    case SCREEN_POMODORO:
-      render_pomodoro_view(it, display_time, vp);
-      break;
-    case SCREEN_HABITS:
-      // Placeholder for habits screen
-      {
-        int center_x = it.get_width() / 2;
-        int center_y = vp.viz_y + vp.viz_height / 2;
-        it.print(center_x, vp.text_y, font_small_, color_active_, display::TextAlign::CENTER, "Habit");
-        it.print(center_x, center_y - 5, font_small_, color_highlight_, display::TextAlign::CENTER, "Soon");
-      }
-      break;
+  // First visible frame of a screen: settle its lazy state (a no-op once pre-warmed)
+  if (screen_id != last_frame_screen_) {
+    if (Screen *screen = find_screen_(screen_id)) screen->prepare(display_time);
+  }
+
+  // Palette canvas is skipped while a transition renders into its off-screen frames. The
+  // frame's channel sum is rebuilt from the canvas present and any direct writes.
+  power_sum_ = 0;
+  if (palette_render_) {
+    palette_frame_whole_ = false;
+    if (!transition_active_) palette_begin_(it);
+  }
+
+  // Render the appropriate screen (or the blend of outgoing + incoming during a transition)
+  if (!transition_active_ || !render_transition_(it, display_time, vp)) {
+    render_screen_(it, screen_id, display_time, vp);
   }
 
   // Celebration sequence: advance phases, draw overlays for styles that need them
@@ -1209,16 +2492,52 @@ void LifeMatrix::render(display::Display &it, ESPTime &time) {
 
   // Render UI overlays on top
   render_ui_overlays(it);
+
+  // Resolve and blit the palette canvas, overlays included
+  palette_present_();
+
+  // The frame is complete but not yet flushed: brightness is limited for what it shows
+  finish_frame_();
+
+  // Input-to-frame latency: the frame that reflects the pending input is complete here
+  if (input_pending_) {
+    input_pending_ = false;
+    uint32_t lat = micros() - input_event_us_;
+    input_latency_sum_us_ += lat;
+    if (lat > input_latency_max_us_) input_latency_max_us_ = lat;
+    input_latency_samples_++;
+  }
+
+  // Switch-frame cost: the first frame of a new screen vs the steady per-frame cost
+  uint32_t frame_us = micros() - frame_start_us;
+#ifdef USE_LIFE_MATRIX_SOAK
+  soak_render_hist_.record(frame_us);
+  soak_frames_++;
+#endif
+  if (screen_id != last_frame_screen_) {
+    if (last_frame_screen_ >= 0) {
+      switch_frame_sum_us_ += frame_us;
+      if (frame_us > switch_frame_max_us_) switch_frame_max_us_ = frame_us;
+      if (screen_id == prewarmed_screen_) switch_frames_warm_++;
+      switch_frames_++;
+    }
+    prewarmed_screen_ = -1;
+    last_frame_screen_ = screen_id;
+  } else if (!transition_active_) {
+    steady_frame_us_ = steady_frame_us_ == 0 ? frame_us : (steady_frame_us_ * 7 + frame_us) / 8;
+  }
 }
 
+#ifndef LIFE_MATRIX_NO_GOL
 void LifeMatrix::render_game_of_life(display::Display &it, int viz_y, int viz_height) {
   int center_x = it.get_width() / 2;
   int width = it.get_width();
 
-  // Check if big bang animation is active (first 1 second after reset)
+  // Check if big bang animation is active (first 1 second after reset). The pre-warm
+  // pass draws whichever state is current and leaves the timers to the visible frame.
   if (game_reset_animation_) {
     unsigned long elapsed = millis() - game_reset_animation_start_;
-    if (elapsed >= 1000) {
+    if (elapsed >= 1000 && !prewarm_pass_) {
       game_reset_animation_ = false;  // End animation after 1 second
     } else {
       render_big_bang_animation(it, viz_y, viz_height);
@@ -1228,7 +2547,7 @@ void LifeMatrix::render_game_of_life(display::Display &it, int viz_y, int viz_he
 
   // Check if still in demo mode (first 5 seconds)
   if (game_demo_mode_) {
-    if (millis() - game_demo_start_time_ >= 5000) {
+    if (millis() - game_demo_start_time_ >= 5000 && !prewarm_pass_) {
       game_demo_mode_ = false;  // Exit demo mode after 5 seconds
       last_switch_time_ = millis();  // Reset cycle timer so screen stays for full duration
 
@@ -1237,9 +2556,9 @@ void LifeMatrix::render_game_of_life(display::Display &it, int viz_y, int viz_he
       initialize_game_of_life(pattern);
     } else {
       // Display rules - title with each word on one line (tighter spacing)
-      it.print(center_x, 4, font_small_, color_highlight_, display::TextAlign::TOP_CENTER, "Game");
-      it.print(center_x, 12, font_small_, color_highlight_, display::TextAlign::TOP_CENTER, "of");
-      it.print(center_x, 20, font_small_, color_highlight_, display::TextAlign::TOP_CENTER, "Life");
+      direct_(it).print(center_x, 4, font_small_, color_highlight_, display::TextAlign::TOP_CENTER, "Game");
+      direct_(it).print(center_x, 12, font_small_, color_highlight_, display::TextAlign::TOP_CENTER, "of");
+      direct_(it).print(center_x, 20, font_small_, color_highlight_, display::TextAlign::TOP_CENTER, "Life");
 
       // Draw common patterns between title and rules
       Color pattern_color = Color(80, 80, 120);
@@ -1262,10 +2581,10 @@ void LifeMatrix::render_game_of_life(display::Display &it, int viz_y, int viz_he
       draw_pixel(it, 25, 42, pattern_color);
       draw_pixel(it, 26, 42, pattern_color);
 
-      it.print(center_x, 50, font_small_, color_active_, display::TextAlign::TOP_CENTER, "Rules:");
-      it.print(center_x, 62, font_small_, Color(0, 255, 150), display::TextAlign::TOP_CENTER, "2-3 OK");
-      it.print(center_x, 72, font_small_, Color(0, 150, 255), display::TextAlign::TOP_CENTER, "3 Born");
-      it.print(center_x, 82, font_small_, Color(255, 50, 0), display::TextAlign::TOP_CENTER, "* Die");
+      direct_(it).print(center_x, 50, font_small_, color_active_, display::TextAlign::TOP_CENTER, "Rules:");
+      direct_(it).print(center_x, 62, font_small_, Color(0, 255, 150), display::TextAlign::TOP_CENTER, "2-3 OK");
+      direct_(it).print(center_x, 72, font_small_, Color(0, 150, 255), display::TextAlign::TOP_CENTER, "3 Born");
+      direct_(it).print(center_x, 82, font_small_, Color(255, 50, 0), display::TextAlign::TOP_CENTER, "* Die");
 
       return;  // Don't update game during demo
     }
@@ -1275,8 +2594,12 @@ void LifeMatrix::render_game_of_life(display::Display &it, int viz_y, int viz_he
   Viewport vp = calculate_viewport(it);
   unsigned long current_millis = millis();
 
-  // Show countdown if stable with breathing animation
-  if (game_is_stable_) {
+  // Scrubbing: the generation on screen, in the highlight color
+  if (rewind_gen_ >= 0) {
+    direct_(it).printf(2, vp.text_y, font_small_, color_highlight_, display::TextAlign::CENTER_LEFT,
+              "%s %d", (rewind_gen_ >= 100) ? "G" : "Gen", rewind_gen_);
+  } else if (game_is_stable_) {
+    // Show countdown if stable with breathing animation
     unsigned long elapsed_ms = current_millis - game_stable_since_;
     int seconds_remaining = (game_config_.stability_timeout_ms / 1000) - (elapsed_ms / 1000);
 
@@ -1289,19 +2612,19 @@ void LifeMatrix::render_game_of_life(display::Display &it, int viz_y, int viz_he
       0
     );
 
-    it.printf(center_x, vp.text_y, font_small_, countdown_color, display::TextAlign::CENTER,
+    direct_(it).printf(center_x, vp.text_y, font_small_, countdown_color, display::TextAlign::CENTER,
               "-%ds", seconds_remaining);
   } else {
     // Alternate between generation and births/deaths
     bool show_generation = ((current_millis / 5000) % 2) == 0;
     if (show_generation) {
       const char* gen_label = (game_generation_ >= 100) ? "G" : "Gen";
-      it.printf(2, vp.text_y, font_small_, color_active_, display::TextAlign::CENTER_LEFT,
+      direct_(it).printf(2, vp.text_y, font_small_, color_active_, display::TextAlign::CENTER_LEFT,
                 "%s %d", gen_label, game_generation_);
     } else {
-      it.printf(1, vp.text_y, font_small_, Color(0, 150, 255), display::TextAlign::CENTER_LEFT,
+      direct_(it).printf(1, vp.text_y, font_small_, Color(0, 150, 255), display::TextAlign::CENTER_LEFT,
                 "%d", game_births_);
-      it.printf(width, vp.text_y, font_small_, Color(255, 50, 0), display::TextAlign::CENTER_RIGHT,
+      direct_(it).printf(width, vp.text_y, font_small_, Color(255, 50, 0), display::TextAlign::CENTER_RIGHT,
                 "%d", game_deaths_);
     }
   }
@@ -1309,16 +2632,14 @@ void LifeMatrix::render_game_of_life(display::Display &it, int viz_y, int viz_he
   // Draw the grid with age-based coloring (direct array access)
   int max_row = std::min(viz_height, grid_height_);
   int hue_divisor = grid_width_ + grid_height_;
+  const uint8_t *cells = (rewind_gen_ >= 0) ? rewind_ages_.data() : game_grid_.data();
 
   for (int row = 0; row < max_row; row++) {
-    // Yield every 30 rows to let WiFi stack process
-    if (row > 0 && (row % 30) == 0) delay(0);
-
     int y_pos = fill_direction_bottom_to_top_ ? (viz_y + viz_height - 1 - row) : (viz_y + row);
     int row_offset = row * grid_width_;
 
     for (int col = 0; col < grid_width_; col++) {
-      uint8_t age = game_grid_[row_offset + col];
+      uint8_t age = cells[row_offset + col];
 
       if (age > 0) {
         Color cell_color;
@@ -1364,7 +2685,6 @@ void LifeMatrix::render_big_bang_animation(display::Display &it, int viz_y, int
 
   // Single merged loop for ring + center circle
   for (int row = 0; row < viz_height && row < grid_height_; row++) {
-    if (row > 0 && (row % 30) == 0) delay(0);
     int y_pos = fill_direction_bottom_to_top_ ? (viz_y + viz_height - 1 - row) : (viz_y + row);
     float dy = (float)(row - half_h);
     float dy2 = dy * dy;
@@ -1385,7 +2705,9 @@ void LifeMatrix::render_big_bang_animation(display::Display &it, int viz_y, int
     }
   }
 }
+#endif
 
+#ifndef LIFE_MATRIX_NO_MONTH
 void LifeMatrix::render_month_view(display::Display &it, ESPTime &time, int viz_y, int viz_height) {
   Viewport vp = calculate_viewport(it);
   int center_x = it.get_width() / 2;
@@ -1393,7 +2715,7 @@ void LifeMatrix::render_month_view(display::Display &it, ESPTime &time, int viz_
   // Text area: month name only (no year)
   char month_str[4];
   time.strftime(month_str, sizeof(month_str), "%b");
-  it.print(center_x, vp.text_y, font_small_, color_active_, display::TextAlign::CENTER, month_str);
+  direct_(it).print(center_x, vp.text_y, font_small_, color_active_, display::TextAlign::CENTER, month_str);
 
   // Days in this month
   uint8_t month_days[12];
@@ -1407,12 +2729,12 @@ void LifeMatrix::render_month_view(display::Display &it, ESPTime &time, int viz_
       event_day[evt.day - 1] = true;
   }
 
-  // Grid: 4 columns × 8 rows = 32 slots, days flow left→right, top→bottom
-  const int COLS = 4;
-  const int ROWS = 8;
-  const int cell_w = 8;   // 32px / 4 cols
-  int cell_h = viz_height / ROWS;
-  if (cell_h < 2) cell_h = 2;
+  // Grid from the layout (4 × 8 cells of 8 px on a 32-wide panel), days flow left→right
+  const ViewLayout &lay = layout_;
+  const int COLS = lay.month_cols;
+  const int ROWS = lay.month_rows;
+  const int cell_w = lay.month_cell_w;
+  const int cell_h = lay.month_cell_h;
 
   // Marker color for today border blending
   Color today_clr = get_marker_color_value(marker_color_);
@@ -1430,7 +2752,7 @@ void LifeMatrix::render_month_view(display::Display &it, ESPTime &time, int viz_
 
   // Track today's cell position for the moment pixel (drawn after the loop)
   int today_cy = viz_y;
-  int today_cx = 0;
+  int today_cx = lay.month_x0;
 
   for (int day = 1; day <= days_in_month; day++) {
     int slot = day - 1;
@@ -1438,7 +2760,7 @@ void LifeMatrix::render_month_view(display::Display &it, ESPTime &time, int viz_
     int row_idx = slot / COLS;
     if (row_idx >= ROWS) break;
 
-    int cx = col * cell_w;
+    int cx = lay.month_x0 + col * cell_w;
     // Fill direction controls row order: bottom-to-top puts day 1 at the bottom row
     int cy = fill_direction_bottom_to_top_
                ? viz_y + (ROWS - 1 - row_idx) * cell_h
@@ -1601,6 +2923,27 @@ void LifeMatrix::render_month_view(display::Display &it, ESPTime &time, int viz_
     }
   }
 
+#ifndef LIFE_MATRIX_NO_POMODORO
+  // Pomodoro focus heatmap: bar up the cell's inner left column, full height = POMO_HEAT_FULL_MIN
+  const PomoAggregates *focus_agg = pomo_heatmap_ ? &pomo_log_().agg : nullptr;
+  if (focus_agg != nullptr && focus_agg->year == time.year && cell_h > 2 && cell_w > 2) {
+    int month_doy = compute_doy(time.year, time.month, 1);
+    for (int day = 1; day <= days_in_month && (day - 1) / COLS < ROWS; day++) {
+      int focus = focus_agg->day_min[month_doy + day - 1];
+      if (focus == 0) continue;
+      int inner_h = cell_h - 2;
+      int bar_h = std::min(inner_h, (focus * inner_h + POMO_HEAT_FULL_MIN - 1) / POMO_HEAT_FULL_MIN);
+      int row_idx = (day - 1) / COLS;
+      int cx = lay.month_x0 + ((day - 1) % COLS) * cell_w;
+      int cy = fill_direction_bottom_to_top_ ? viz_y + (ROWS - 1 - row_idx) * cell_h : viz_y + row_idx * cell_h;
+      for (int p = 0; p < bar_h; p++) {
+        int y_pos = fill_direction_bottom_to_top_ ? (cy + cell_h - 2 - p) : (cy + 1 + p);
+        draw_pixel(it, cx + 1, y_pos, POMO_FOCUS_COLOR);
+      }
+    }
+  }
+#endif
+
   // Current moment: breathing rainbow pixel at the fill edge inside today's cell
   // x sweeps left→right across the cell width; y tracks the fill boundary
   {
@@ -1627,7 +2970,9 @@ void LifeMatrix::render_month_view(display::Display &it, ESPTime &time, int viz_
     draw_pixel(it, pixel_x, pixel_y, breathing);
   }
 }
+#endif
 
+#ifndef LIFE_MATRIX_NO_DAY
 void LifeMatrix::render_day_view(display::Display &it, ESPTime &time, int viz_y, int viz_height) {
   int center_x = it.get_width() / 2;
   Viewport vp = calculate_viewport(it);
@@ -1635,7 +2980,7 @@ void LifeMatrix::render_day_view(display::Display &it, ESPTime &time, int viz_y,
   // Display day name
   char day_str[8];
   time.strftime(day_str, sizeof(day_str), "%a %d");
-  it.print(center_x, vp.text_y, font_small_, color_active_, display::TextAlign::CENTER, day_str);
+  direct_(it).print(center_x, vp.text_y, font_small_, color_active_, display::TextAlign::CENTER, day_str);
 
   // Calculate time segments
   int bed_hour = time_segments_.bed_time_hour;
@@ -1650,9 +2995,11 @@ void LifeMatrix::render_day_view(display::Display &it, ESPTime &time, int viz_y,
   int current_minutes = time.hour * 60 + time.minute;
 
   // Determine segment type per row: 0=sleep, 1=work, 2=life
-  uint8_t row_type[120];
-  for (int row = 0; row < 120; row++) {
-    int hour = (int)((row * 24.0f) / 120.0f);
+  const ViewLayout &lay = layout_;
+  int rows = std::min(viz_height, (int)lay.day_row_minute.size());
+  uint8_t *row_type = day_row_type_.data();
+  for (int row = 0; row < rows; row++) {
+    int hour = lay.day_row_minute[row] / 60;
 
     bool sleep = false;
     if (bed_hour < wake_hour) {
@@ -1674,11 +3021,11 @@ void LifeMatrix::render_day_view(display::Display &it, ESPTime &time, int viz_y,
   }
 
   // Calculate rainbow progress for life segments (STYLE_TIME_SEGMENTS only)
-  float life_progress[120] = {};
+  float *life_progress = day_life_progress_.data();
   if (style_ == STYLE_TIME_SEGMENTS) {
     int seg_start = -1;
-    for (int row = 0; row <= 120; row++) {
-      bool is_life = (row < 120 && row_type[row] == 2);
+    for (int row = 0; row <= rows; row++) {
+      bool is_life = (row < rows && row_type[row] == 2);
       if (is_life && seg_start < 0) {
         seg_start = row;
       } else if (!is_life && seg_start >= 0) {
@@ -1692,12 +3039,10 @@ void LifeMatrix::render_day_view(display::Display &it, ESPTime &time, int viz_y,
   }
 
   // Draw 24-hour day
-  for (int row = 0; row < viz_height && row < 120; row++) {
+  for (int row = 0; row < rows; row++) {
     int y_pos = fill_direction_bottom_to_top_ ? (viz_y + viz_height - 1 - row) : (viz_y + row);
 
-    float hour_float = (row * 24.0f) / 120.0f;
-    int row_minutes = (int)(hour_float * 60);
-    bool is_future = (row_minutes > current_minutes);
+    bool is_future = (lay.day_row_minute[row] > current_minutes);
 
     // Determine pixel color based on style
     Color pixel_color;
@@ -1711,10 +3056,10 @@ void LifeMatrix::render_day_view(display::Display &it, ESPTime &time, int viz_y,
         pixel_color = hsv_to_rgb(hue, 1.0f, 1.0f); // life: rainbow per segment
       }
     } else if (style_ == STYLE_GRADIENT) {
-      float progress = (float)row / 120.0f;
+      float progress = (float)row / (float)rows;
       pixel_color = interpolate_gradient(progress, gradient_type_);
     } else if (style_ == STYLE_RAINBOW) {
-      int hue = (row * 360) / 120;
+      int hue = (row * 360) / rows;
       pixel_color = hsv_to_rgb(hue, 1.0f, 1.0f);
     } else {
       pixel_color = color_active_;
@@ -1725,12 +3070,14 @@ void LifeMatrix::render_day_view(display::Display &it, ESPTime &time, int viz_y,
       if (pixel_color.r == 0 && pixel_color.g == 0 && pixel_color.b == 0) continue;
     }
 
-    for (int col = 1; col <= 30; col++) {
+    for (int col = lay.bar_x; col < lay.bar_x + lay.bar_w; col++) {
       draw_pixel(it, col, y_pos, pixel_color);
     }
   }
 }
+#endif
 
+#ifndef LIFE_MATRIX_NO_HOUR
 void LifeMatrix::render_hour_view(display::Display &it, ESPTime &time, int viz_y, int viz_height) {
   int center_x = it.get_width() / 2;
   int width = it.get_width();
@@ -1739,28 +3086,32 @@ void LifeMatrix::render_hour_view(display::Display &it, ESPTime &time, int viz_y
   // Display current time in text area
   char time_str[6];
   time.strftime(time_str, sizeof(time_str), "%H:%M");
-  it.print(center_x, vp.text_y, font_small_, color_active_, display::TextAlign::CENTER, time_str);
+  direct_(it).print(center_x, vp.text_y, font_small_, color_active_, display::TextAlign::CENTER, time_str);
 
   // Get current time components
   int minute = time.minute;
   int second = time.second;
 
-  // Calculate position in hour (120 rows = 60 min × 2 rows/min)
-  int current_row = minute * 2 + (second >= 30 ? 1 : 0);  // Which row we're filling
-  int pixels_in_row = second % 30;  // How many pixels filled in current row (0-29)
+  // Position in hour; each row covers hour_row_second[row] .. hour_row_second[row + 1]
+  const ViewLayout &lay = layout_;
+  int rows = std::min(viz_height, (int)lay.hour_row_second.size() - 1);
+  int hour_sec = minute * 60 + second;
 
   // Handle Time Segments separately (spiral filling, not line-by-line)
   if (style_ == STYLE_TIME_SEGMENTS) {
+    int spiral_len = (int)lay.quarter_spiral.size();
+    int current_quarter = minute / 15;
+
     // Draw all 4 quarters as spirals
     for (int q = 0; q < 4; q++) {
-      int quarter_start_row = q * 30;
+      int quarter_start_row = q * lay.quarter_h;
 
       // Determine if this quarter should be filled
-      int current_quarter = minute / 15;
       bool is_past_quarter = (q < current_quarter);
       bool is_current_quarter = (q == current_quarter);
 
       int seconds_in_quarter = is_past_quarter ? 900 : (is_current_quarter ? ((minute % 15) * 60 + second) : 0);
+      int filled = seconds_in_quarter * spiral_len / 900;
 
       // Choose color for this quarter
       Color quarter_color;
@@ -1768,52 +3119,15 @@ void LifeMatrix::render_hour_view(display::Display &it, ESPTime &time, int viz_y
       else if (q == 1) quarter_color = Color(0, 255, 100); // Green
       else if (q == 2) quarter_color = Color(255, 200, 0); // Yellow-Orange
       else quarter_color = Color(255, 0, 100);             // Red-Magenta
-      
-      Color dim_color = dim_future(quarter_color);
-
-      // Draw spiral for this quarter
-      int spiral_pos = 0;
-      int length = 30;
-
-      // 1. Draw top edge (row 0, cols 0-29)
-      int draw_row = quarter_start_row;
-      for (int draw_col = 1; draw_col <= 30 && spiral_pos < 900; draw_col++) {
-        int y_pos = fill_direction_bottom_to_top_ ? (viz_y + viz_height - 1 - draw_row) : (viz_y + draw_row);
-        draw_pixel(it, draw_col, y_pos, (spiral_pos < seconds_in_quarter) ? quarter_color : dim_color);
-        spiral_pos++;
-      }
-
-      // 2. Spiral inward
-      int current_spiral_row = 0;
-      int current_col = 29;
-      int direction = 1;  // 0=right, 1=down, 2=left, 3=up
-
-      while (length > 0 && spiral_pos < 900) {
-        length--;
 
-        // First side
-        for (int i = 0; i < length && spiral_pos < 900; i++) {
-          if (direction == 1) current_spiral_row++;
-          else if (direction == 3) current_spiral_row--;
-
-          int abs_row = quarter_start_row + current_spiral_row;
-          int y_pos = fill_direction_bottom_to_top_ ? (viz_y + viz_height - 1 - abs_row) : (viz_y + abs_row);
-          draw_pixel(it, current_col + 1, y_pos, (spiral_pos < seconds_in_quarter) ? quarter_color : dim_color);
-          spiral_pos++;
-        }
-        direction = (direction + 1) % 4;
-
-        // Second side
-        for (int i = 0; i < length && spiral_pos < 900; i++) {
-          if (direction == 2) current_col--;
-          else if (direction == 0) current_col++;
+      Color dim_color = dim_future(quarter_color);
 
-          int abs_row = quarter_start_row + current_spiral_row;
-          int y_pos = fill_direction_bottom_to_top_ ? (viz_y + viz_height - 1 - abs_row) : (viz_y + abs_row);
-          draw_pixel(it, current_col + 1, y_pos, (spiral_pos < seconds_in_quarter) ? quarter_color : dim_color);
-          spiral_pos++;
-        }
-        direction = (direction + 1) % 4;
+      // Walk the precomputed spiral for this quarter
+      for (int p = 0; p < spiral_len; p++) {
+        int cell = lay.quarter_spiral[p];
+        int abs_row = quarter_start_row + cell / lay.bar_w;
+        int y_pos = fill_direction_bottom_to_top_ ? (viz_y + viz_height - 1 - abs_row) : (viz_y + abs_row);
+        draw_pixel(it, lay.bar_x + cell % lay.bar_w, y_pos, (p < filled) ? quarter_color : dim_color);
       }
     }
     return;  // Done with Time Segments
@@ -1821,12 +3135,12 @@ void LifeMatrix::render_hour_view(display::Display &it, ESPTime &time, int viz_y
 
   // Normal drawing for other schemes (not Time Segments)
 
-  // Draw minute markers (every 10 minutes = every 20 rows, skip 0)
+  // Draw minute markers (every 10 minutes, skip 0)
   if (marker_style_ != MARKER_NONE) {
     Color marker_clr = get_marker_color_value(marker_color_);
 
     for (int mark_min = 10; mark_min <= 50; mark_min += 10) {
-      int mark_row = mark_min * 2;
+      int mark_row = mark_min * rows / 60;
       if (mark_row < viz_height) {
         int mark_y = fill_direction_bottom_to_top_ ? (viz_y + viz_height - 1 - mark_row) : (viz_y + mark_row);
         draw_marker(it, mark_y, width, marker_style_, marker_clr);
@@ -1834,43 +3148,43 @@ void LifeMatrix::render_hour_view(display::Display &it, ESPTime &time, int viz_y
     }
   }
 
-  // Draw time visualization (use columns 1-30, leave 0 and 31 for markers)
-  for (int row = 0; row < viz_height && row < 120; row++) {
+  // Draw time visualization in the bar area (outer columns are left for markers)
+  for (int row = 0; row < rows; row++) {
     int y_pos = fill_direction_bottom_to_top_ ? (viz_y + viz_height - 1 - row) : (viz_y + row);
-    bool is_current_row = (row == current_row);
-    bool is_past_row = (row < current_row);
+    int row_start = lay.hour_row_second[row];
+    int row_end = lay.hour_row_second[row + 1];
 
     // Determine how many bright pixels to draw in this row
     int pixels_to_draw = 0;
-    if (is_past_row) {
-      pixels_to_draw = 30;  // Fully filled
-    } else if (is_current_row) {
-      pixels_to_draw = pixels_in_row;  // Partially filled
+    if (hour_sec >= row_end) {
+      pixels_to_draw = lay.bar_w;  // Fully filled
+    } else if (hour_sec >= row_start && row_end > row_start) {
+      pixels_to_draw = (hour_sec - row_start) * lay.bar_w / (row_end - row_start);  // Partially filled
     }
 
     // Determine color based on scheme
     Color pixel_color = color_active_;
 
     if (style_ == STYLE_GRADIENT) {
-      float progress = (float)row / 120.0f;
+      float progress = (float)row / (float)rows;
       pixel_color = interpolate_gradient(progress, gradient_type_);
     } else if (style_ == STYLE_RAINBOW) {
-      int hue = (row * 360) / 120;
+      int hue = (row * 360) / rows;
       pixel_color = hsv_to_rgb(hue, 1.0f, 1.0f);
     }
     // else: Single Color - use color_active_ (already set)
-    
+
     Color dim_color = dim_future(pixel_color);
 
     // Draw pixels in this row
-    for (int col = 0; col < 30; col++) {
-      int x_pos = 1 + col;  // Start at column 1 (skip marker column)
+    for (int col = 0; col < lay.bar_w; col++) {
       Color draw_c = (col < pixels_to_draw) ? pixel_color : dim_color;
       if (draw_c.r == 0 && draw_c.g == 0 && draw_c.b == 0) continue;
-      draw_pixel(it, x_pos, y_pos, draw_c);
+      draw_pixel(it, lay.bar_x + col, y_pos, draw_c);
     }
   }
 }
+#endif
 
 Color LifeMatrix::get_complementary_color(Color c) {
   uint8_t max_c = std::max({c.r, c.g, c.b});
@@ -1889,6 +3203,7 @@ Color LifeMatrix::get_complementary_color(Color c) {
   return hsv_to_rgb((hue + 180) % 360, 1.0f, 1.0f);
 }
 
+#ifndef LIFE_MATRIX_NO_YEAR
 void LifeMatrix::render_year_view(display::Display &it, ESPTime &time, int viz_y, int viz_height) {
   int center_x = it.get_width() / 2;
   int width = it.get_width();
@@ -1897,7 +3212,7 @@ void LifeMatrix::render_year_view(display::Display &it, ESPTime &time, int viz_y
   // Display year
   char year_str[5];
   time.strftime(year_str, sizeof(year_str), "%Y");
-  it.print(center_x, vp.text_y, font_small_, color_active_, display::TextAlign::CENTER, year_str);
+  direct_(it).print(center_x, vp.text_y, font_small_, color_active_, display::TextAlign::CENTER, year_str);
 
   // Current date/time
   int cur_year = time.year;
@@ -1910,17 +3225,13 @@ void LifeMatrix::render_year_view(display::Display &it, ESPTime &time, int viz_y
   uint8_t days_in_month[12];
   get_days_in_month(cur_year, days_in_month);
 
-  // Calculate month height in pixels
-  int month_h = viz_height / 12;
-  if (month_h < 1) month_h = 1;
+  // Month band height and per-day column bands from the layout
+  const ViewLayout &lay = layout_;
+  int month_h = lay.year_month_h;
+  int day_w = lay.year_day_w;
 
-  // Create event lookup bitmap for O(1) access
-  bool event_map[13][32] = {};  // [month 1-12][day 1-31]
-  for (const auto &evt : year_events_) {
-    if (evt.month >= 1 && evt.month <= 12 && evt.day >= 1 && evt.day <= 31) {
-      event_map[evt.month][evt.day] = true;
-    }
-  }
+  // Weekend/event bits per day, cached until the year or the event list changes
+  prepare_year_days_(cur_year);
 
   // Get marker color
   Color marker_clr = get_marker_color_value(marker_color_);
@@ -2036,11 +3347,9 @@ void LifeMatrix::render_year_view(display::Display &it, ESPTime &time, int viz_y
     for (int day = 1; day <= days_in_month[month_idx]; day++) {
       bool is_past = (month_num < cur_month) || (month_num == cur_month && day < cur_day);
       bool is_today = (month_num == cur_month && day == cur_day);
-      bool has_event = event_map[month_num][day];
-
-      // Determine if weekend
-      int day_of_week = day_of_week_sakamoto(cur_year, month_num, day);
-      bool is_weekend = (day_of_week == 0 || day_of_week == 6);  // Sunday=0, Saturday=6
+      uint8_t day_flags = year_day_flags_[month_num][day];
+      bool has_event = (day_flags & YEAR_DAY_EVENT) != 0;
+      bool is_weekend = (day_flags & YEAR_DAY_WEEKEND) != 0;
 
       // Render this day's column
       if (is_past) {
@@ -2066,7 +3375,7 @@ void LifeMatrix::render_year_view(display::Display &it, ESPTime &time, int viz_y
             pixel_color = activity_colors[month_idx][activity_type];
           }
 
-          draw_pixel(it, day, screen_y, pixel_color);
+          for (int dx = 0; dx < day_w; dx++) draw_pixel(it, lay.year_day_x[day] + dx, screen_y, pixel_color);
         }
       } else if (is_today) {
         // Today: fill up to current time
@@ -2094,7 +3403,7 @@ void LifeMatrix::render_year_view(display::Display &it, ESPTime &time, int viz_y
             pixel_color = activity_colors[month_idx][activity_type];
           }
 
-          draw_pixel(it, day, screen_y, pixel_color);
+          for (int dx = 0; dx < day_w; dx++) draw_pixel(it, lay.year_day_x[day] + dx, screen_y, pixel_color);
         }
       } else if (has_event && year_event_style_ == YEAR_EVENT_PULSE) {
         // Future event with pulse: dim static preview
@@ -2112,7 +3421,7 @@ void LifeMatrix::render_year_view(display::Display &it, ESPTime &time, int viz_y
             event_colors[month_idx].b >> 2
           );
 
-          draw_pixel(it, day, screen_y, pixel_color);
+          for (int dx = 0; dx < day_w; dx++) draw_pixel(it, lay.year_day_x[day] + dx, screen_y, pixel_color);
         }
       } else if (show_future_) {
         // Future non-event day: draw dimmed
@@ -2122,13 +3431,34 @@ void LifeMatrix::render_year_view(display::Display &it, ESPTime &time, int viz_y
           uint8_t activity_type = get_activity_type(py, month_h, is_weekend);
           Color pixel_color = dim_future(activity_colors[month_idx][activity_type]);
           if (pixel_color.r == 0 && pixel_color.g == 0 && pixel_color.b == 0) continue;
-          draw_pixel(it, day, screen_y, pixel_color);
+          for (int dx = 0; dx < day_w; dx++) draw_pixel(it, lay.year_day_x[day] + dx, screen_y, pixel_color);
         }
       }
       // else future non-event days: leave black (skip)
     }
   }
 
+#ifndef LIFE_MATRIX_NO_POMODORO
+  // === Pomodoro focus heatmap: per-day bar from the session aggregates ===
+  const PomoAggregates *focus_agg = pomo_heatmap_ ? &pomo_log_().agg : nullptr;
+  if (focus_agg != nullptr && focus_agg->year == cur_year) {
+    int month_doy = 0;
+    for (int month_idx = 0; month_idx < 12; month_idx++) {
+      for (int day = 1; day <= days_in_month[month_idx]; day++) {
+        int focus = focus_agg->day_min[month_doy + day - 1];
+        if (focus == 0) continue;
+        int bar_h = std::min(month_h, (focus * month_h + POMO_HEAT_FULL_MIN - 1) / POMO_HEAT_FULL_MIN);
+        for (int py = 0; py < bar_h; py++) {
+          int logical_row = month_idx * month_h + py;
+          int screen_y = fill_direction_bottom_to_top_ ? (viz_y + viz_height - 1 - logical_row) : (viz_y + logical_row);
+          for (int dx = 0; dx < day_w; dx++) draw_pixel(it, lay.year_day_x[day] + dx, screen_y, POMO_FOCUS_COLOR);
+        }
+      }
+      month_doy += days_in_month[month_idx];
+    }
+  }
+#endif
+
   // === Column 0: Breathing rainbow for today (Markers mode only) ===
   if (year_event_style_ == YEAR_EVENT_MARKERS) {
     // Breathing: slow sine wave 0.5-1.0
@@ -2156,6 +3486,7 @@ void LifeMatrix::render_year_view(display::Display &it, ESPTime &time, int viz_y
     draw_pixel(it, 0, screen_y, breathing);
   }
 }
+#endif
 
 void LifeMatrix::check_celebration(ESPTime &time) {
   // Re-trigger once per minute on event days
@@ -2170,16 +3501,20 @@ void LifeMatrix::check_celebration(ESPTime &time) {
   last_celebration_month_  = time.month;
   for (const auto &evt : year_events_) {
     if (evt.month == time.month && evt.day == time.day_of_month) {
-      celebration_active_ = true;
-      celebration_start_  = millis();
-      celeb_seq_idx_ = 0;
-      ctm_           = CTM_NONE;
+      start_celebration_();
       ESP_LOGD(TAG, "Celebration triggered for %d-%02d %02d:%02d", time.month, time.day_of_month, time.hour, time.minute);
       break;
     }
   }
 }
 
+void LifeMatrix::start_celebration_() {
+  celebration_active_ = true;
+  celebration_start_  = millis();
+  celeb_seq_idx_ = 0;
+  ctm_           = CTM_NONE;
+}
+
 void LifeMatrix::render_sparkle_celebration(display::Display &it, uint32_t elapsed_ms) {
   float progress = (float)elapsed_ms / 3000.0f;
   float density  = (1.0f - progress) * (1.0f - progress);  // quadratic falloff
@@ -2194,10 +3529,11 @@ void LifeMatrix::render_sparkle_celebration(display::Display &it, uint32_t elaps
     int y = (int)((seed >> 16) % (uint32_t)h);
     seed = seed * 1664525u + 1013904223u;
     int hue = (int)((seed >> 16) % 360u);
-    it.draw_pixel_at(x, y, hsv_to_rgb(hue, 1.0f, 1.0f));
+    draw_raw_pixel_(it, x, y, hsv_to_rgb(hue, 1.0f, 1.0f));
   }
 }
 
+#ifndef LIFE_MATRIX_NO_PLASMA
 void LifeMatrix::render_plasma_celebration(display::Display &it, uint32_t elapsed_ms) {
   float t = (float)elapsed_ms * 0.001f;  // seconds
   int w = it.get_width();
@@ -2226,22 +3562,39 @@ void LifeMatrix::render_plasma_celebration(display::Display &it, uint32_t elapse
       // v in [-4, 4] → hue 0–360
       int hue = (int)((v + 4.0f) * 45.0f) % 360;
       if (hue < 0) hue += 360;
-      it.draw_pixel_at(x, y, hsv_to_rgb(hue, 1.0f, brightness));
+      draw_raw_pixel_(it, x, y, hsv_to_rgb(hue, 1.0f, brightness));
     }
   }
 }
+#endif
 
 void LifeMatrix::render_celebration_overlay(display::Display &it, uint32_t elapsed_ms) {
   CelebrationStyle cur_style =
       (celeb_seq_idx_ < celeb_seq_len_) ? celeb_sequence_[celeb_seq_idx_] : CELEB_SPARKLE;
   switch (cur_style) {
+#ifndef LIFE_MATRIX_NO_PLASMA
     case CELEB_PLASMA:    render_plasma_celebration(it, elapsed_ms);    break;
+#endif
+#ifndef LIFE_MATRIX_NO_FIREWORKS
     case CELEB_FIREWORKS: render_fireworks_celebration(it, elapsed_ms); break;
+#endif
     case CELEB_SPARKLE:
     default:              render_sparkle_celebration(it, elapsed_ms);   break;
   }
 }
 
+void LifeMatrix::set_celebration_sequence(const std::vector<uint8_t> &styles) {
+  celeb_seq_len_ = 0;
+  for (uint8_t style : styles) {
+    if (celeb_seq_len_ >= 4 || style > CELEB_HUE_CYCLE) continue;
+    celeb_sequence_[celeb_seq_len_++] = (CelebrationStyle)style;
+  }
+  if (celeb_seq_len_ == 0) {
+    celeb_sequence_[0] = CELEB_HUE_CYCLE;
+    celeb_seq_len_ = 1;
+  }
+}
+
 uint32_t LifeMatrix::get_celeb_duration(CelebrationStyle style) {
   switch (style) {
     case CELEB_FIREWORKS: return 5000;
@@ -2252,6 +3605,7 @@ uint32_t LifeMatrix::get_celeb_duration(CelebrationStyle style) {
   }
 }
 
+#ifndef LIFE_MATRIX_NO_FIREWORKS
 // ============================================================================
 // FIREWORKS — 7 staggered rockets, 20 sparks each, trailing streaks,
 //             burst core flash, and a secondary mini-burst per firework.
@@ -2297,7 +3651,7 @@ void LifeMatrix::render_fireworks_celebration(display::Display &it, uint32_t ela
         int iy = (int)roundf((h - 1) + (fw.burst_y - (h - 1)) * p);
         if (ix >= 0 && ix < w && iy >= 0 && iy < h) {
           float br = (seg == 0) ? 1.f : (seg == 1 ? 0.6f : seg == 2 ? 0.28f : 0.10f);
-          it.draw_pixel_at(ix, iy, Color((uint8_t)(255*br), (uint8_t)(215*br), 0));
+          draw_raw_pixel_(it, ix, iy, Color((uint8_t)(255*br), (uint8_t)(215*br), 0));
         }
       }
       continue;
@@ -2310,7 +3664,7 @@ void LifeMatrix::render_fireworks_celebration(display::Display &it, uint32_t ela
       for (int dy = -1; dy <= 1; dy++) for (int dx = -1; dx <= 1; dx++) {
         int ix = fw.burst_x + dx, iy = fw.burst_y + dy;
         if (ix >= 0 && ix < w && iy >= 0 && iy < h)
-          it.draw_pixel_at(ix, iy, Color((uint8_t)(255*flash), (uint8_t)(255*flash), (uint8_t)(255*flash)));
+          draw_raw_pixel_(it, ix, iy, Color((uint8_t)(255*flash), (uint8_t)(255*flash), (uint8_t)(255*flash)));
       }
     }
 
@@ -2332,7 +3686,7 @@ void LifeMatrix::render_fireworks_celebration(display::Display &it, uint32_t ela
           if (ix >= 0 && ix < w && iy >= 0 && iy < h) {
             float br = brightness * (tr == 0 ? 1.f : tr == 1 ? 0.38f : 0.13f);
             int hue = ((int)fw.base_hue + i * 14) % 360;
-            it.draw_pixel_at(ix, iy, hsv_to_rgb(hue, 1.f, br));
+            draw_raw_pixel_(it, ix, iy, hsv_to_rgb(hue, 1.f, br));
           }
         }
       }
@@ -2348,11 +3702,12 @@ void LifeMatrix::render_fireworks_celebration(display::Display &it, uint32_t ela
         int ix = (int)roundf(fw.burst_x + cosf(a) * spd * t2);
         int iy = (int)roundf(fw.burst_y - sinf(a) * spd * t2 + 0.5f * GRAVITY * t2 * t2);
         if (ix >= 0 && ix < w && iy >= 0 && iy < h)
-          it.draw_pixel_at(ix, iy, hsv_to_rgb(((int)fw.base_hue + 60) % 360, 0.8f, b2));
+          draw_raw_pixel_(it, ix, iy, hsv_to_rgb(((int)fw.base_hue + 60) % 360, 0.8f, b2));
       }
     }
   }
 }
+#endif
 
 void LifeMatrix::render_ui_overlays(display::Display &it) {
   int width = it.get_width();
@@ -2362,13 +3717,13 @@ void LifeMatrix::render_ui_overlays(display::Display &it) {
     Color pause_color = Color(180, 180, 180);  // Brighter gray/white
     // Left bar (2 pixels wide, 5 pixels tall)
     for (int y = 1; y <= 5; y++) {
-      it.draw_pixel_at(width - 7, y, pause_color);
-      it.draw_pixel_at(width - 6, y, pause_color);
+      draw_raw_pixel_(it, width - 7, y, pause_color);
+      draw_raw_pixel_(it, width - 6, y, pause_color);
     }
     // Right bar (2 pixels wide, 5 pixels tall)
     for (int y = 1; y <= 5; y++) {
-      it.draw_pixel_at(width - 4, y, pause_color);
-      it.draw_pixel_at(width - 3, y, pause_color);
+      draw_raw_pixel_(it, width - 4, y, pause_color);
+      draw_raw_pixel_(it, width - 3, y, pause_color);
     }
   }
 
@@ -2543,6 +3898,27 @@ void LifeMatrix::draw_marker(display::Display &it, int mark_y, int width, Marker
 // YEAR VIEW HELPER METHODS
 // ============================================================================
 
+#ifndef LIFE_MATRIX_NO_YEAR
+void LifeMatrix::prepare_year_days_(int year) {
+  if (year == year_days_year_) return;
+  std::memset(year_day_flags_, 0, sizeof(year_day_flags_));
+  uint8_t days_in_month[12];
+  get_days_in_month(year, days_in_month);
+  for (int m = 1; m <= 12; m++) {
+    for (int d = 1; d <= days_in_month[m - 1]; d++) {
+      int dow = day_of_week_sakamoto(year, m, d);
+      if (dow == 0 || dow == 6) year_day_flags_[m][d] |= YEAR_DAY_WEEKEND;  // Sunday=0, Saturday=6
+    }
+  }
+  for (const auto &evt : year_events_) {
+    if (evt.month >= 1 && evt.month <= 12 && evt.day >= 1 && evt.day <= 31) {
+      year_day_flags_[evt.month][evt.day] |= YEAR_DAY_EVENT;
+    }
+  }
+  year_days_year_ = year;
+}
+#endif
+
 void LifeMatrix::parse_year_events(const std::string &events_str) {
   year_events_.clear();
 
@@ -2572,14 +3948,17 @@ void LifeMatrix::parse_year_events(const std::string &events_str) {
       i++;
     }
 
-    // Validate and add
+    // Validate and add. Two thirds of the table at most: the rest stays free for lifespan birthdays
     if (month >= 1 && month <= 12 && day >= 1 && day <= 31) {
+      const size_t limit = year_events_.capacity() * 2 / 3;
+      if (year_events_.size() >= limit) {
+        ESP_LOGW(TAG, "Year events: more than %u entries, rest ignored", (unsigned)limit);
+        break;
+      }
       YearEvent evt;
       evt.month = month;
       evt.day = day;
       year_events_.push_back(evt);
-
-      if (year_events_.size() >= 32) break;  // Limit to 32 events
     }
   }
 
@@ -2590,9 +3969,16 @@ void LifeMatrix::parse_year_events(const std::string &events_str) {
     for (const auto &existing : year_events_) {
       if (existing.month == le.month && existing.day == le.day) { dup = true; break; }
     }
-    if (!dup && year_events_.size() < 48) year_events_.push_back(le);
+    if (!dup && !year_events_.push_back(le)) {
+      ESP_LOGW(TAG, "Year events: more than %u entries, remaining lifespan birthdays ignored",
+               (unsigned)year_events_.capacity());
+      break;
+    }
   }
 
+#ifndef LIFE_MATRIX_NO_YEAR
+  year_days_year_ = -1;  // year view rebuilds its day flags on the next frame
+#endif
   ESP_LOGD(TAG, "Parsed %d year events (%d lifespan)", (int)year_events_.size(), (int)lifespan_year_events_.size());
 }
 
@@ -2765,7 +4151,7 @@ LifeRange LifeMatrix::parse_life_range(const std::string &s) const {
   return r;
 }
 
-void LifeMatrix::parse_comma_dates(const std::string &s, std::vector<LifeDate> &out) const {
+void LifeMatrix::parse_comma_dates(const std::string &s, LifeDateList &out) const {
   out.clear();
   size_t pos = 0;
   while (pos < s.size()) {
@@ -2773,12 +4159,15 @@ void LifeMatrix::parse_comma_dates(const std::string &s, std::vector<LifeDate> &
     if (comma == std::string::npos) comma = s.size();
     std::string tok = s.substr(pos, comma - pos);
     LifeDate d = parse_life_date(tok);
-    if (d.is_set()) out.push_back(d);
+    if (d.is_set() && !out.push_back(d)) {
+      ESP_LOGW(TAG, "Lifespan: more than %u dates, rest ignored", (unsigned)out.capacity());
+      break;
+    }
     pos = comma + 1;
   }
 }
 
-void LifeMatrix::parse_comma_ranges(const std::string &s, std::vector<LifeRange> &out) const {
+void LifeMatrix::parse_comma_ranges(const std::string &s, LifeRangeList &out) const {
   out.clear();
   // Ranges are separated by comma; each range may itself contain a '/' (handled by parse_life_range)
   // We split on commas, but must not split inside a range's slash.
@@ -2790,7 +4179,10 @@ void LifeMatrix::parse_comma_ranges(const std::string &s, std::vector<LifeRange>
     if (comma == std::string::npos) comma = s.size();
     std::string tok = s.substr(pos, comma - pos);
     LifeRange r = parse_life_range(tok);
-    if (r.is_set()) out.push_back(r);
+    if (r.is_set() && !out.push_back(r)) {
+      ESP_LOGW(TAG, "Lifespan: more than %u ranges, rest ignored", (unsigned)out.capacity());
+      break;
+    }
     pos = comma + 1;
   }
 }
@@ -2821,7 +4213,7 @@ void LifeMatrix::set_lifespan_kids(const std::string &dates) {
 
 void LifeMatrix::set_lifespan_parents(const std::string &ranges) {
   lifespan_config_.parent_count = 0;
-  std::vector<LifeRange> tmp;
+  LifeRangeList tmp;
   parse_comma_ranges(ranges, tmp);
   for (size_t i = 0; i < tmp.size() && i < 2; i++) {
     lifespan_config_.parents[i] = tmp[i];
@@ -2856,12 +4248,15 @@ void LifeMatrix::set_lifespan_milestones(const std::string &milestones_str) {
     // Find first ':' after position 9 (to skip date separators)
     size_t colon = tok.find(':', 9);
     if (colon != std::string::npos) {
-      m.date  = parse_life_date(tok.substr(0, colon));
-      m.label = tok.substr(colon + 1);
+      m.date = parse_life_date(tok.substr(0, colon));
+      m.label.assign(tok.c_str() + colon + 1, tok.size() - colon - 1);
     } else {
       m.date = parse_life_date(tok);
     }
-    if (m.date.is_set()) lifespan_config_.milestones.push_back(m);
+    if (m.date.is_set() && !lifespan_config_.milestones.push_back(m)) {
+      ESP_LOGW(TAG, "Lifespan: more than %u milestones, rest ignored", (unsigned)lifespan_config_.milestones.capacity());
+      break;
+    }
     pos = comma + 1;
   }
 }
@@ -2883,7 +4278,7 @@ void LifeMatrix::apply_lifespan_year_events() {
     YearEvent evt;
     evt.month = month;
     evt.day   = day;
-    lifespan_year_events_.push_back(evt);
+    lifespan_year_events_.push_back(evt);  // full: the extra birthdays are not marked
   };
 
   // Own birthday
@@ -2909,133 +4304,237 @@ void LifeMatrix::apply_lifespan_year_events() {
 // LIFESPAN VIEW — PHASE LOGIC
 // ============================================================================
 
-uint16_t LifeMatrix::get_active_phases(int age, int row_year) const {
-  if (!lifespan_config_.birthday.is_set()) return 0;
-  uint16_t mask = 0;
-  int birth_year = lifespan_config_.birthday.year;
-
-  // PARENTS: birth → moved_out_age (inclusive)
-  if (lifespan_config_.moved_out_age > 0) {
-    if (age <= lifespan_config_.moved_out_age) mask |= (1 << PHASE_PARENTS);
-  }
-
-  // SCHOOL phases: always starts at age 6 (European: 8 primary, 4 highschool, rest university)
-  if (lifespan_config_.school_years_count > 0) {
-    const int ss    = 6;
-    const int se    = ss + lifespan_config_.school_years_count;
-    const int total = lifespan_config_.school_years_count;
-    const int primary_end    = ss + 8;
-    const int highschool_end = ss + 12;
-
-    if (age >= ss && age < primary_end)
-      mask |= (1 << PHASE_PRIMARY);
-    if (total > 8 && age >= primary_end && age < highschool_end)
-      mask |= (1 << PHASE_HIGHSCHOOL);
-    if (total > 12 && age >= highschool_end && age < se)
-      mask |= (1 << PHASE_UNIVERSITY);
-  }
-
-  // CAREER: max(school_end, moved_out_age) → retirement_age (or life expectancy)
-  {
-    int career_start = -1;
-    if (lifespan_config_.school_years_count > 0)
-      career_start = 6 + lifespan_config_.school_years_count;
-    if (lifespan_config_.moved_out_age > 0)
-      career_start = (career_start < 0) ? lifespan_config_.moved_out_age
-                                        : std::max(career_start, lifespan_config_.moved_out_age);
-    int career_end = (lifespan_config_.retirement_age > 0) ? lifespan_config_.retirement_age
-                                                           : lifespan_config_.life_expectancy_age;
-    if (career_start >= 0 && age >= career_start && age < career_end)
-      mask |= (1 << PHASE_CAREER);
-  }
-
-  // CHILDREN: first kid birth → last kid + 18
-  if (!lifespan_config_.kids.empty()) {
-    int first_age = lifespan_config_.kids.front().year - birth_year;
-    int last_age  = lifespan_config_.kids.back().year  - birth_year;
-    if (age >= first_age && age <= last_age + 18)
-      mask |= (1 << PHASE_CHILDREN);
-  }
-
-  // PARTNER ranges
-  for (const auto &r : lifespan_config_.partner_ranges) {
-    if (!r.is_set()) continue;
-    if (row_year >= r.start.year && (r.end.year == 0 || row_year <= r.end.year))
-      mask |= (1 << PHASE_PARTNER);
-  }
+// Phase rules are resolved to half-open age intervals once per biography change
+// (precompute_lifespan_phases). A sweep over the sorted endpoints then yields the
+// elementary segments, each with its phase mask and cached blend color, so a row
+// lookup is one binary search however many phases and ranges are configured.
 
-  // MARRIAGE ranges
-  for (const auto &r : lifespan_config_.marriage_ranges) {
-    if (!r.is_set()) continue;
-    if (row_year >= r.start.year && (r.end.year == 0 || row_year <= r.end.year))
-      mask |= (1 << PHASE_MARRIED);
-  }
+static const int16_t PHASE_AGE_OPEN = 1000;  // end of an open-ended interval
 
-  // RETIREMENT
-  if (lifespan_config_.retirement_age > 0 && age >= lifespan_config_.retirement_age)
-    mask |= (1 << PHASE_RETIREMENT);
+const LifePhaseSegment *LifeMatrix::phase_segment_at(int age) const {
+  auto it = std::upper_bound(lifespan_segments_.begin(), lifespan_segments_.end(), age,
+                             [](int a, const LifePhaseSegment &seg) { return a < seg.start_age; });
+  if (it == lifespan_segments_.begin()) return nullptr;
+  return &*(it - 1);
+}
 
-  return mask;
+uint64_t LifeMatrix::get_active_phases(int age) const {
+  const LifePhaseSegment *seg = phase_segment_at(age);
+  return seg ? seg->mask : 0;
 }
 
 Color LifeMatrix::get_phase_color(int phase) const {
-  switch (phase) {
-    case PHASE_PARENTS:    return Color(255, 136,   0);  // amber
-    case PHASE_PRIMARY:    return Color(  0, 200, 200);  // cyan
-    case PHASE_HIGHSCHOOL: return Color(  0, 160, 100);  // teal
-    case PHASE_UNIVERSITY: return Color(  0,  80, 255);  // blue
-    case PHASE_CAREER:     return Color(  0, 200,  60);  // green
-    case PHASE_CHILDREN:   return Color(255, 200,   0);  // golden yellow
-    case PHASE_PARTNER:    return Color(255,  80, 160);  // rose
-    case PHASE_MARRIED:    return Color(180,   0, 100);  // deep magenta
-    case PHASE_RETIREMENT: return Color(140,  80, 255);  // lavender
-    default:               return Color( 80,  80,  80);  // grey
-  }
+  if (phase < 0 || phase >= (int)lifespan_phase_defs_.size()) return Color(80, 80, 80);
+  return lifespan_phase_defs_[phase].color;
 }
 
 const char *LifeMatrix::get_phase_short_name(int phase) const {
-  switch (phase) {
-    case PHASE_PARENTS:    return "Home";
-    case PHASE_PRIMARY:    return "Prim";
-    case PHASE_HIGHSCHOOL: return "High";
-    case PHASE_UNIVERSITY: return "Uni";
-    case PHASE_CAREER:     return "Work";
-    case PHASE_CHILDREN:   return "Kids";
-    case PHASE_PARTNER:    return "Love";
-    case PHASE_MARRIED:    return "Wed";
-    case PHASE_RETIREMENT: return "Retir";
-    default:               return "";
-  }
+  if (phase < 0 || phase >= (int)lifespan_phase_defs_.size()) return "";
+  return lifespan_phase_defs_[phase].label;
 }
 
-Color LifeMatrix::blend_phase_colors(uint16_t phase_mask) const {
+Color LifeMatrix::blend_phase_colors(uint64_t phase_mask) const {
   if (phase_mask == 0) return Color(50, 50, 50);  // no phase: dim neutral
   int r = 0, g = 0, b = 0, count = 0;
-  for (int i = 0; i < PHASE_COUNT; i++) {
-    if (phase_mask & (1 << i)) {
-      Color c = get_phase_color(i);
-      r += c.r; g += c.g; b += c.b; count++;
-    }
+  for (uint64_t m = phase_mask; m; m &= m - 1) {
+    Color c = get_phase_color(__builtin_ctzll(m));
+    r += c.r; g += c.g; b += c.b; count++;
   }
   return Color((uint8_t)(r / count), (uint8_t)(g / count), (uint8_t)(b / count));
 }
 
+void LifeMatrix::set_lifespan_custom_phases(const std::string &phases) {
+  lifespan_config_.custom_phases.clear();
+  size_t pos = 0;
+  while (pos < phases.size()) {
+    size_t comma = phases.find(',', pos);
+    if (comma == std::string::npos) comma = phases.size();
+    std::string tok = phases.substr(pos, comma - pos);
+    pos = comma + 1;
+    while (!tok.empty() && tok.front() == ' ') tok.erase(0, 1);
+    while (!tok.empty() && tok.back()  == ' ') tok.pop_back();
+
+    // Format: "range:label[:RRGGBB]"
+    size_t c1 = tok.find(':');
+    if (c1 == std::string::npos || c1 == 0) continue;
+    std::string range = tok.substr(0, c1);
+    size_t c2 = tok.find(':', c1 + 1);
+    LifeCustomPhase p;
+    p.label.assign(tok.c_str() + c1 + 1, (c2 == std::string::npos ? tok.size() : c2) - c1 - 1);
+    if (c2 != std::string::npos && tok.size() - c2 - 1 == 6) {
+      uint32_t rgb = (uint32_t)strtoul(tok.c_str() + c2 + 1, nullptr, 16);
+      p.color = Color((rgb >> 16) & 0xFF, (rgb >> 8) & 0xFF, rgb & 0xFF);
+      p.has_color = true;
+    }
+
+    // Dates carry two '-' (or a '/'); ages are "A-B", "A-" or "A"
+    if (range.find('/') != std::string::npos || std::count(range.begin(), range.end(), '-') >= 2) {
+      p.by_age = false;
+      p.range = parse_life_range(range);
+      if (!p.range.is_set()) continue;
+    } else {
+      size_t dash = range.find('-');
+      p.start_age = (int16_t)atoi(range.c_str());
+      if (dash == std::string::npos)
+        p.end_age = p.start_age + 1;
+      else if (dash + 1 < range.size())
+        p.end_age = (int16_t)(atoi(range.c_str() + dash + 1) + 1);  // inclusive → exclusive
+      if (p.end_age >= 0 && p.end_age <= p.start_age) continue;
+    }
+    if (!lifespan_config_.custom_phases.push_back(p)) {
+      ESP_LOGW(TAG, "Lifespan: more than %u custom phases, rest ignored",
+               (unsigned)lifespan_config_.custom_phases.capacity());
+      break;
+    }
+  }
+  ESP_LOGD(TAG, "Lifespan custom phases: %d", (int)lifespan_config_.custom_phases.size());
+}
+
 void LifeMatrix::precompute_lifespan_phases() {
   lifespan_active_phases_.clear();
+  lifespan_segments_.clear();
+  lifespan_phase_defs_.clear();
+#ifndef LIFE_MATRIX_NO_LIFESPAN
+  lifespan_spans_.clear();
+  lifespan_zoom_segs_.clear();
+  for (auto &t : lifespan_zoom_tables_) {
+    t.marks.clear();
+    t.seg.clear();
+  }
+#endif
+
+  // Built-in phases keep their LifePhase ids
+  static const char *const builtin_names[PHASE_COUNT] = {
+    "Home", "Prim", "High", "Uni", "Work", "Kids", "Love", "Wed", "Retir"};
+  static const Color builtin_colors[PHASE_COUNT] = {
+    Color(255, 136,   0),  // parents: amber
+    Color(  0, 200, 200),  // primary: cyan
+    Color(  0, 160, 100),  // highschool: teal
+    Color(  0,  80, 255),  // university: blue
+    Color(  0, 200,  60),  // career: green
+    Color(255, 200,   0),  // children: golden yellow
+    Color(255,  80, 160),  // partner: rose
+    Color(180,   0, 100),  // married: deep magenta
+    Color(140,  80, 255),  // retirement: lavender
+  };
+  for (int i = 0; i < PHASE_COUNT; i++) lifespan_phase_defs_.push_back({builtin_names[i], builtin_colors[i]});
+
   if (!lifespan_config_.birthday.is_set()) return;
-  int birth_year = lifespan_config_.birthday.year;
-  int le_age = lifespan_config_.life_expectancy_age;
-  for (int phase = 0; phase < PHASE_COUNT; phase++) {
-    for (int age = 0; age <= le_age; age++) {
-      if (get_active_phases(age, birth_year + age) & (1 << phase)) {
-        lifespan_active_phases_.push_back(phase);
-        break;
-      }
+  const LifespanConfig &cfg = lifespan_config_;
+  int birth_year = cfg.birthday.year;
+
+  // Each interval is kept twice: in whole calendar years for the year index, and in
+  // days (lifespan_spans_) so the month and week grids can place date boundaries
+  struct Interval { int16_t start, end; uint8_t phase; };
+  std::vector<Interval> intervals;
+  const int32_t open_day = (int32_t)PHASE_AGE_OPEN * 366;
+  auto add_days = [&](int start, int end, int32_t start_day, int32_t end_day, int phase) {
+    start = std::max(start, 0);
+    end = std::min(end, (int)PHASE_AGE_OPEN);
+    if (end <= start) return;
+    intervals.push_back({(int16_t)start, (int16_t)end, (uint8_t)phase});
+#ifndef LIFE_MATRIX_NO_LIFESPAN
+    start_day = std::max<int32_t>(start_day, 0);
+    end_day = std::min(end_day, open_day);
+    if (end_day > start_day) lifespan_spans_.push_back({start_day, end_day, (uint8_t)phase});
+#endif
+  };
+  auto add = [&](int start, int end, int phase) {
+    add_days(start, end, (int32_t)start * 366, (int32_t)end * 366, phase);
+  };
+  auto day_of = [&](const LifeDate &d) -> int32_t {
+    return (int32_t)(d.year - birth_year) * 366 + std::max(0, compute_doy(d.year, d.month, d.day));
+  };
+  auto add_range = [&](const LifeRange &r, int phase) {
+    if (!r.is_set()) return;
+    bool open = r.end.year == 0;
+    add_days(r.start.year - birth_year, open ? PHASE_AGE_OPEN : r.end.year - birth_year + 1,
+             day_of(r.start), open ? open_day : day_of(r.end) + 1, phase);  // end date inclusive
+  };
+
+  // PARENTS: birth → moved_out_age (inclusive)
+  if (cfg.moved_out_age > 0) add(0, cfg.moved_out_age + 1, PHASE_PARENTS);
+
+  // SCHOOL phases: always starts at age 6 (European: 8 primary, 4 highschool, rest university)
+  if (cfg.school_years_count > 0) {
+    const int ss = 6;
+    const int total = cfg.school_years_count;
+    add(ss, ss + 8, PHASE_PRIMARY);
+    if (total > 8)  add(ss + 8, ss + 12, PHASE_HIGHSCHOOL);
+    if (total > 12) add(ss + 12, ss + total, PHASE_UNIVERSITY);
+  }
+
+  // CAREER: max(school_end, moved_out_age) → retirement_age (or life expectancy)
+  {
+    int career_start = -1;
+    if (cfg.school_years_count > 0) career_start = 6 + cfg.school_years_count;
+    if (cfg.moved_out_age > 0)
+      career_start = (career_start < 0) ? cfg.moved_out_age : std::max(career_start, cfg.moved_out_age);
+    int career_end = (cfg.retirement_age > 0) ? cfg.retirement_age : cfg.life_expectancy_age;
+    if (career_start >= 0) add(career_start, career_end, PHASE_CAREER);
+  }
+
+  // CHILDREN: first kid birth → last kid + 18
+  if (!cfg.kids.empty()) {
+    LifeDate adult = cfg.kids.back();
+    adult.year += 18;
+    add_days(cfg.kids.front().year - birth_year, cfg.kids.back().year - birth_year + 19,
+             day_of(cfg.kids.front()), day_of(adult), PHASE_CHILDREN);
+  }
+
+  for (const auto &r : cfg.partner_ranges)  add_range(r, PHASE_PARTNER);
+  for (const auto &r : cfg.marriage_ranges) add_range(r, PHASE_MARRIED);
+
+  // RETIREMENT
+  if (cfg.retirement_age > 0) add(cfg.retirement_age, PHASE_AGE_OPEN, PHASE_RETIREMENT);
+
+  // Custom phases: default colors step the hue by the golden angle
+  for (const auto &p : cfg.custom_phases) {
+    int id = (int)lifespan_phase_defs_.size();
+    if (id >= LIFESPAN_MAX_PHASES) break;
+    Color c = p.has_color ? p.color : hsv_to_rgb(((id - PHASE_COUNT) * 137) % 360, 0.8f, 1.0f);
+    lifespan_phase_defs_.push_back({p.label.c_str(), c});
+    if (p.by_age) add(p.start_age, p.end_age < 0 ? PHASE_AGE_OPEN : p.end_age, id);
+    else          add_range(p.range, id);
+  }
+
+  // Sweep: +1/-1 events at every endpoint, per-phase overlap counters
+  std::vector<std::pair<int16_t, int>> events;  // (age, +phase+1 for start / -(phase+1) for end)
+  events.reserve(intervals.size() * 2);
+  for (const auto &iv : intervals) {
+    events.push_back({iv.start, iv.phase + 1});
+    events.push_back({iv.end, -(iv.phase + 1)});
+  }
+  std::sort(events.begin(), events.end());
+  std::vector<uint16_t> depth(lifespan_phase_defs_.size(), 0);
+  uint64_t mask = 0;
+  lifespan_segments_.push_back({0, 0, blend_phase_colors(0)});
+  for (size_t i = 0; i < events.size();) {
+    int16_t age = events[i].first;
+    for (; i < events.size() && events[i].first == age; i++) {
+      int phase = std::abs(events[i].second) - 1;
+      if (events[i].second > 0) { if (depth[phase]++ == 0) mask |= 1ULL << phase; }
+      else                      { if (--depth[phase] == 0) mask &= ~(1ULL << phase); }
     }
+    if (mask == lifespan_segments_.back().mask) continue;  // merge equal neighbours
+    if (lifespan_segments_.back().start_age == age) lifespan_segments_.pop_back();
+    if (!lifespan_segments_.empty() && lifespan_segments_.back().mask == mask) continue;
+    lifespan_segments_.push_back({age, mask, blend_phase_colors(mask)});
   }
-  ESP_LOGD(TAG, "Lifespan active phases: %d", (int)lifespan_active_phases_.size());
+
+  // Phases that cover at least one year up to life expectancy (for highlight cycling)
+  uint64_t seen = 0;
+  for (const auto &seg : lifespan_segments_)
+    if (seg.start_age <= cfg.life_expectancy_age) seen |= seg.mask;
+  for (uint64_t m = seen; m; m &= m - 1) lifespan_active_phases_.push_back(__builtin_ctzll(m));
+  ESP_LOGD(TAG, "Lifespan phases: %d defined, %d active, %d segments",
+           (int)lifespan_phase_defs_.size(), (int)lifespan_active_phases_.size(), (int)lifespan_segments_.size());
+#ifndef LIFE_MATRIX_NO_LIFESPAN
+  if (find_screen_(SCREEN_LIFESPAN) != nullptr) precompute_lifespan_zoom_();
+#endif
 }
 
+#ifndef LIFE_MATRIX_NO_LIFESPAN
 void LifeMatrix::update_lifespan_phase_cycle() {
   if (lifespan_config_.phase_cycle_s < 0.1f || lifespan_active_phases_.empty()) {
     lifespan_highlighted_phase_ = -1;
@@ -3058,17 +4557,118 @@ void LifeMatrix::update_lifespan_phase_cycle() {
   lifespan_phase_changed_ms_ = now;
 }
 
+// ============================================================================
+// LIFESPAN VIEW — ZOOM LEVELS
+// ============================================================================
+// Decades, months and weeks are cell grids over the same calendar-year ages as the
+// year view. Tables are rebuilt with the phase index, so a zoomed frame only reads
+// one segment byte and one marker byte per cell. Year cells share the year index;
+// month and week cells take the phases active at the cell's middle day.
+
+static int lifespan_cell_sub(int per_year, int month, int day_of_year) {
+  if (per_year == 12) return month - 1;
+  if (per_year == 52) return std::min(51, day_of_year / 7);
+  return 0;
+}
+
+void LifeMatrix::precompute_lifespan_zoom_() {
+  lifespan_zoom_segs_.clear();
+  for (auto &t : lifespan_zoom_tables_) {
+    t.marks.clear();
+    t.seg.clear();
+  }
+  if (!lifespan_config_.birthday.is_set() || lifespan_segments_.empty()) return;
+
+  const LifespanConfig &cfg = lifespan_config_;
+  const int birth_year = cfg.birthday.year;
+  const int years = cfg.life_expectancy_age;
+
+  // Distinct phase sets, slot 0 = no phase (also the fallback once 256 sets are in use)
+  lifespan_zoom_segs_.push_back({0, 0, blend_phase_colors(0)});
+  uint8_t last_seg = 0;
+  auto seg_of = [&](int age, uint64_t mask) -> uint8_t {
+    if (lifespan_zoom_segs_[last_seg].mask == mask) return last_seg;
+    for (size_t s = 0; s < lifespan_zoom_segs_.size(); s++)
+      if (lifespan_zoom_segs_[s].mask == mask) return last_seg = (uint8_t)s;
+    if (lifespan_zoom_segs_.size() > UINT8_MAX) return 0;
+    lifespan_zoom_segs_.push_back({(int16_t)age, mask, blend_phase_colors(mask)});
+    return last_seg = (uint8_t)(lifespan_zoom_segs_.size() - 1);
+  };
+  auto mask_on = [&](int32_t day) {
+    uint64_t mask = 0;
+    for (const auto &sp : lifespan_spans_)
+      if (day >= sp.start_day && day < sp.end_day) mask |= 1ULL << sp.phase;
+    return mask;
+  };
+
+  static const uint8_t per_year_of[LS_ZOOM_COUNT] = {1, 0, 12, 52};
+  for (int level = 0; level < LS_ZOOM_COUNT; level++) {
+    int per_year = per_year_of[level];
+    if (per_year == 0) continue;
+    LifespanZoomTable &tab = lifespan_zoom_tables_[level];
+    tab.per_year = per_year;
+    tab.marks.assign(years * per_year, 0);
+    tab.seg.assign(years * per_year, 0);
+    for (int i = 0; i < (int)tab.seg.size(); i++) {
+      int age = i / per_year, sub = i % per_year;
+      uint64_t mask;
+      if (per_year == 1) {
+        const LifePhaseSegment *seg = phase_segment_at(age);
+        mask = seg ? seg->mask : 0;
+      } else {
+        int mid = (per_year == 12) ? compute_doy(birth_year + age, sub + 1, 15) : sub * 7 + 3;
+        mask = mask_on((int32_t)age * 366 + mid);
+      }
+      tab.seg[i] = seg_of(age, mask);
+    }
+
+    auto mark = [&](const LifeDate &d, uint8_t bit) {
+      if (!d.is_set()) return;
+      int cell = (d.year - birth_year) * per_year
+               + lifespan_cell_sub(per_year, d.month, compute_doy(d.year, d.month, d.day));
+      if (cell >= 0 && cell < (int)tab.marks.size()) tab.marks[cell] |= bit;
+    };
+    auto mark_age = [&](int age, uint8_t bit) {
+      if (age <= 0) return;
+      LifeDate d = cfg.birthday;
+      d.year = birth_year + age;
+      mark(d, bit);
+    };
+
+    int birth_sub = lifespan_cell_sub(per_year, cfg.birthday.month,
+                                      compute_doy(birth_year, cfg.birthday.month, cfg.birthday.day));
+    for (int i = 0; i < birth_sub && i < (int)tab.marks.size(); i++) tab.marks[i] |= LS_CELL_UNBORN;
+
+    for (const auto &k : cfg.kids) mark(k, LS_CELL_EVENT);
+    for (int i = 0; i < cfg.parent_count; i++) mark(cfg.parents[i].end, LS_CELL_EVENT);
+    for (const auto &r : cfg.marriage_ranges) mark(r.start, LS_CELL_EVENT);
+    if (cfg.moved_out_age > 0)  mark_age(cfg.moved_out_age, LS_CELL_EVENT);
+    if (cfg.retirement_age > 0) mark_age(cfg.retirement_age, LS_CELL_EVENT);
+    for (const auto &m : cfg.milestones) mark(m.date, LS_CELL_MILESTONE);
+  }
+  ESP_LOGD(TAG, "Lifespan zoom tables: %d ages, %d week cells, %d phase sets",
+           years, (int)lifespan_zoom_tables_[LS_ZOOM_WEEKS].marks.size(), (int)lifespan_zoom_segs_.size());
+}
+
+void LifeMatrix::zoom_lifespan(int delta) {
+  int z = std::max(0, std::min((int)LS_ZOOM_COUNT - 1, (int)lifespan_zoom_ + delta));
+  if (z == lifespan_zoom_) return;
+  lifespan_zoom_ = (uint8_t)z;
+  lifespan_zoom_changed_ms_ = millis();
+  request_redraw();
+}
+
 // ============================================================================
 // LIFESPAN VIEW — RENDERING
 // ============================================================================
 
 void LifeMatrix::render_lifespan_view(display::Display &it, ESPTime &time, int viz_y, int viz_height) {
-  int width = it.get_width();  // 32
+  int width = it.get_width();
 
   if (!lifespan_config_.birthday.is_set()) {
     int cx = width / 2, cy = viz_y + viz_height / 2;
-    it.print(cx, cy - 9, font_small_, Color(80, 80, 80), display::TextAlign::CENTER, "Set");
-    it.print(cx, cy + 9, font_small_, Color(80, 80, 80), display::TextAlign::CENTER, "bday");
+    direct_(it).print(cx, cy - 9, font_small_, Color(80, 80, 80), display::TextAlign::CENTER, "Set");
+    direct_(it).print(cx, cy + 9, font_small_, Color(80, 80, 80), display::TextAlign::CENTER, "bday");
     return;
   }
 
@@ -3082,11 +4682,21 @@ void LifeMatrix::render_lifespan_view(display::Display &it, ESPTime &time, int v
   bool is_leap = (current_year % 4 == 0 && (current_year % 100 != 0 || current_year % 400 == 0));
   int days_in_year = is_leap ? 366 : 365;
 
-  // Update phase cycling
-  update_lifespan_phase_cycle();
+  // Update phase cycling (the visible frame owns the cycle timer)
+  if (!prewarm_pass_) update_lifespan_phase_cycle();
   int highlighted_phase = lifespan_highlighted_phase_;
 
-  int max_rows = std::min(viz_height, 120);
+  if (lifespan_zoom_ != LS_ZOOM_YEARS) {
+    render_lifespan_zoom_view_(it, time, viz_y, viz_height, highlighted_phase);
+    render_lifespan_text_(it, time, highlighted_phase);
+    return;
+  }
+
+  // One row per year of age; the bar area maps day-of-year to x
+  const ViewLayout &lay = layout_;
+  int max_rows = viz_height;
+  int doy_span = lay.bar_w;
+  int doy_x_max = lay.bar_x + lay.bar_w;
 
   for (int age = 0; age < max_rows; age++) {
     int row_year = birth_year + age;
@@ -3098,25 +4708,11 @@ void LifeMatrix::render_lifespan_view(display::Display &it, ESPTime &time, int v
 
     // ── MARKER COLUMN (x=0): decade ticks, life events ───────────────────────
     if (!is_grave) {
-      // Determine highest-priority marker for this year
-      bool has_milestone = false;
-      for (const auto &m : lifespan_config_.milestones)
-        if (m.date.year == row_year) { has_milestone = true; break; }
-
-      bool has_event = false;
-      for (const auto &k : lifespan_config_.kids)
-        if (k.year == row_year) { has_event = true; break; }
-      if (!has_event)
-        for (int i = 0; i < lifespan_config_.parent_count; i++)
-          if (lifespan_config_.parents[i].end.year == row_year) { has_event = true; break; }
-      if (!has_event && lifespan_config_.moved_out_age > 0
-          && birth_year + lifespan_config_.moved_out_age == row_year)   has_event = true;
-      if (!has_event && lifespan_config_.retirement_age > 0
-          && birth_year + lifespan_config_.retirement_age == row_year)  has_event = true;
-      if (!has_event) {
-        for (const auto &r : lifespan_config_.marriage_ranges)
-          if (r.start.year == row_year) { has_event = true; break; }
-      }
+      // Highest-priority marker for this year, from the per-year table built with the phases
+      const ColdVector<uint8_t> &year_marks = lifespan_zoom_tables_[LS_ZOOM_DECADES].marks;
+      uint8_t marks = age < (int)year_marks.size() ? year_marks[age] : 0;
+      bool has_milestone = (marks & LS_CELL_MILESTONE) != 0;
+      bool has_event = (marks & LS_CELL_EVENT) != 0;
 
       bool is_decade = (age > 0 && age % 10 == 0);
 
@@ -3127,8 +4723,8 @@ void LifeMatrix::render_lifespan_view(display::Display &it, ESPTime &time, int v
         draw_pixel(it, 0, row_y, Color(dcl.r / div, dcl.g / div, dcl.b / div));
       } else if (marker_style_ != MARKER_NONE && (has_milestone || has_event)) {
         // Events and milestones: complementary of this row's phase color (like year view)
-        uint16_t phase_mask = get_active_phases(age, row_year);
-        Color comp = get_complementary_color(blend_phase_colors(phase_mask));
+        const LifePhaseSegment *seg = phase_segment_at(age);
+        Color comp = get_complementary_color(seg ? seg->blend : blend_phase_colors(0));
         // Milestones at full brightness, life events at 60%
         float scale = has_milestone ? 1.0f : 0.6f;
         Color mc = Color((uint8_t)(comp.r * scale),
@@ -3207,30 +4803,14 @@ void LifeMatrix::render_lifespan_view(display::Display &it, ESPTime &time, int v
       continue;
     }
 
-    // ── NORMAL LIFE ROW (x=1..31) ────────────────────────────────────────────
-    uint16_t phase_mask = get_active_phases(age, row_year);
-
-    Color base_color;
-    if (highlighted_phase >= 0) {
-      if (phase_mask & (1 << highlighted_phase))
-        base_color = get_phase_color(highlighted_phase);
-      else
-        base_color = Color(8, 8, 8);  // very dim when not in highlighted phase
-    } else if (style_ == STYLE_TIME_SEGMENTS) {
-      base_color = blend_phase_colors(phase_mask);
-    } else if (style_ == STYLE_GRADIENT) {
-      base_color = interpolate_gradient((float)age / (float)le_age, gradient_type_);
-    } else if (style_ == STYLE_RAINBOW) {
-      base_color = hsv_to_rgb((age * 360) / le_age, 1.0f, 1.0f);
-    } else {
-      base_color = color_active_;  // STYLE_SINGLE
-    }
+    // ── NORMAL LIFE ROW (x=1..width-1) ─────────────────────────────────────────
+    Color base_color = lifespan_base_color_(phase_segment_at(age), age, highlighted_phase);
 
-    // Present pixel x within current year (1–31)
+    // Present pixel x within current year (bar_x … bar_x + bar_w)
     int present_x = -1;
     if (is_current) {
-      present_x = 1 + (int)((float)doy / (float)days_in_year * 30.0f + 0.5f);
-      if (present_x > 31) present_x = 31;
+      present_x = lay.bar_x + (int)((float)doy / (float)days_in_year * doy_span + 0.5f);
+      if (present_x > doy_x_max) present_x = doy_x_max;
     }
 
     for (int x = 1; x < width; x++) {
@@ -3261,58 +4841,580 @@ void LifeMatrix::render_lifespan_view(display::Display &it, ESPTime &time, int v
     if (age < 0 || age >= max_rows || age > le_age) continue;
     int doy_m = compute_doy(m.date.year, m.date.month, m.date.day);
     bool leap_m = (m.date.year % 4 == 0 && (m.date.year % 100 != 0 || m.date.year % 400 == 0));
-    int x = 1 + (int)((float)doy_m / (float)(leap_m ? 366 : 365) * 30.0f + 0.5f);
-    if (x > 31) x = 31;
+    int x = lay.bar_x + (int)((float)doy_m / (float)(leap_m ? 366 : 365) * doy_span + 0.5f);
+    if (x > doy_x_max) x = doy_x_max;
     bool past = (m.date.year < current_year);
     draw_pixel(it, x, viz_y + age, past ? Color(110, 110, 0) : Color(220, 220, 0));
   }
 
-  // Kid birth markers (golden dot at birth day)
-  for (const auto &k : lifespan_config_.kids) {
-    if (!k.is_set()) continue;
-    int age = k.year - birth_year;
-    if (age < 0 || age >= max_rows || age > le_age) continue;
-    int doy_k = compute_doy(k.year, k.month, k.day);
-    bool leap_k = (k.year % 4 == 0 && (k.year % 100 != 0 || k.year % 400 == 0));
-    int x = 1 + (int)((float)doy_k / (float)(leap_k ? 366 : 365) * 30.0f + 0.5f);
-    if (x > 31) x = 31;
-    draw_pixel(it, x, viz_y + age,
-               (k.year < current_year) ? Color(128, 100, 0) : Color(255, 210, 0));
+  // Kid birth markers (golden dot at birth day)
+  for (const auto &k : lifespan_config_.kids) {
+    if (!k.is_set()) continue;
+    int age = k.year - birth_year;
+    if (age < 0 || age >= max_rows || age > le_age) continue;
+    int doy_k = compute_doy(k.year, k.month, k.day);
+    bool leap_k = (k.year % 4 == 0 && (k.year % 100 != 0 || k.year % 400 == 0));
+    int x = lay.bar_x + (int)((float)doy_k / (float)(leap_k ? 366 : 365) * doy_span + 0.5f);
+    if (x > doy_x_max) x = doy_x_max;
+    draw_pixel(it, x, viz_y + age,
+               (k.year < current_year) ? Color(128, 100, 0) : Color(255, 210, 0));
+  }
+
+  // ── TEXT AREA: time, phase name, or active milestone label ────────────────
+  render_lifespan_text_(it, time, highlighted_phase);
+}
+
+Color LifeMatrix::lifespan_base_color_(const LifePhaseSegment *seg, int age, int highlighted_phase) {
+  int le_age = lifespan_config_.life_expectancy_age;
+  if (highlighted_phase >= 0) {
+    if (seg && (seg->mask & (1ULL << highlighted_phase)))
+      return get_phase_color(highlighted_phase);
+    return Color(8, 8, 8);  // very dim when not in highlighted phase
+  }
+  if (style_ == STYLE_TIME_SEGMENTS) return seg ? seg->blend : blend_phase_colors(0);
+  if (style_ == STYLE_GRADIENT)      return interpolate_gradient((float)age / (float)le_age, gradient_type_);
+  if (style_ == STYLE_RAINBOW)       return hsv_to_rgb((age * 360) / le_age, 1.0f, 1.0f);
+  return color_active_;  // STYLE_SINGLE
+}
+
+void LifeMatrix::render_lifespan_zoom_view_(display::Display &it, ESPTime &time, int viz_y, int viz_height,
+                                            int highlighted_phase) {
+  const LifespanZoomTable &tab = lifespan_zoom_tables_[lifespan_zoom_];
+  if (tab.marks.empty()) return;
+  const ViewLayout &lay = layout_;
+  const int per_year = tab.per_year;
+  const int cells = (int)tab.marks.size();
+
+  // Grid geometry: whole years per row where the panel allows it
+  int cols;
+  if (lifespan_zoom_ == LS_ZOOM_DECADES)     cols = 10;
+  else if (lifespan_zoom_ == LS_ZOOM_MONTHS) cols = 12;
+  else cols = (lay.bar_w >= 52) ? 52 : (lay.bar_w >= 26) ? 26 : 13;
+  int cw = std::max(1, lay.bar_w / cols);
+  int x0 = lay.bar_x + std::max(0, (lay.bar_w - cw * cols) / 2);
+  int total_rows = (cells + cols - 1) / cols;
+  int ch = std::max(1, std::min(16, viz_height / total_rows));
+  int visible_rows = viz_height / ch;
+
+  // Present cell; rows scroll so it sits a third of the way down when the grid is taller than the panel
+  int doy = std::max(0, time.day_of_year - 1);
+  int present = (time.year - lifespan_config_.birthday.year) * per_year
+              + lifespan_cell_sub(per_year, time.month, doy);
+  int first_row = 0;
+  if (total_rows > visible_rows)
+    first_row = std::max(0, std::min(total_rows - visible_rows, present / cols - visible_rows / 3));
+
+  int pw = (cw >= 3) ? cw - 1 : cw;  // 1 px gutter once cells are big enough
+  int ph = (ch >= 3) ? ch - 1 : ch;
+  int last_cell = std::min(cells, (first_row + visible_rows) * cols);
+  for (int i = first_row * cols; i < last_cell; i++) {
+    int age = i / per_year;
+    uint8_t marks = tab.marks[i];
+    Color c;
+    if (marks & LS_CELL_UNBORN) {
+      c = Color(0, 0, 0);
+    } else if (i == present) {
+      c = Color(255, 255, 255);
+    } else if (marks & LS_CELL_MILESTONE) {
+      c = (i < present) ? Color(110, 110, 0) : Color(220, 220, 0);
+    } else if ((marks & LS_CELL_EVENT) && marker_style_ != MARKER_NONE) {
+      c = (i < present) ? Color(128, 100, 0) : Color(255, 210, 0);
+    } else {
+      Color base = lifespan_base_color_(&lifespan_zoom_segs_[tab.seg[i]], age, highlighted_phase);
+      float brightness = (i < present) ? 0.50f : 0.25f;
+      c = Color((uint8_t)(base.r * brightness), (uint8_t)(base.g * brightness), (uint8_t)(base.b * brightness));
+    }
+    int x = x0 + (i % cols) * cw;
+    int y = viz_y + (i / cols - first_row) * ch;
+    for (int dy = 0; dy < ph; dy++)
+      for (int dx = 0; dx < pw; dx++)
+        draw_pixel(it, x + dx, y + dy, c);
+  }
+}
+
+void LifeMatrix::render_lifespan_text_(display::Display &it, ESPTime &time, int highlighted_phase) {
+  if (text_area_position_ == "None" || !font_small_) return;
+  int width = it.get_width();
+  Viewport vp = calculate_viewport(it);
+  if (millis() - lifespan_zoom_changed_ms_ < 2000 && lifespan_zoom_changed_ms_ != 0) {
+    static const char *const zoom_names[LS_ZOOM_COUNT] = {"10yr", "Year", "Month", "Week"};
+    direct_(it).print(width / 2, vp.text_y, font_small_, color_active_, display::TextAlign::CENTER,
+             zoom_names[lifespan_zoom_]);
+  } else if (highlighted_phase >= 0 && lifespan_config_.phase_cycle_s > 0.1f) {
+    direct_(it).print(width / 2, vp.text_y, font_small_,
+             get_phase_color(highlighted_phase),
+             display::TextAlign::CENTER,
+             get_phase_short_name(highlighted_phase));
+  } else {
+    // Check for active milestone label in the current year
+    const char *label = nullptr;
+    for (const auto &m : lifespan_config_.milestones) {
+      if (m.date.year == time.year && !m.label.empty()) {
+        label = m.label.c_str(); break;
+      }
+    }
+    if (label) {
+      direct_(it).print(width / 2, vp.text_y, font_small_,
+               Color(200, 200, 0), display::TextAlign::CENTER, label);
+    } else {
+      char buf[8];
+      snprintf(buf, sizeof(buf), "%02d:%02d", time.hour, time.minute);
+      direct_(it).print(width / 2, vp.text_y, font_small_,
+               color_active_, display::TextAlign::CENTER, buf);
+    }
+  }
+}
+#endif
+
+#ifndef LIFE_MATRIX_NO_HABITS
+// ============================================================================
+// HABIT TRACKER
+// ============================================================================
+// Each habit-year is a 366-bit set indexed by day-of-year. RAM keeps HABIT_YEARS
+// years per habit in a ring keyed by year; NVS stores the first 46 bytes of each
+// (little-endian words, so bytes 0..45 hold bits 0..367). Keys hash the habit name,
+// so reordering habit_list keeps each habit's history.
+
+static void habit_nvs_key(char *buf, const char *name, int year) {
+  uint32_t hash = 2166136261UL;
+  for (; *name; name++) hash = (hash * 16777619UL) ^ (uint8_t)*name;
+  snprintf(buf, 16, "h%08" PRIX32 "%04d", hash, year);
+}
+
+static int habit_days_in_year(int year) {
+  return (year % 4 == 0 && (year % 100 != 0 || year % 400 == 0)) ? 366 : 365;
+}
+
+// Set bits in [first, last] (inclusive)
+static int habit_popcount_range(const uint32_t *bits, int first, int last) {
+  if (last < first) return 0;
+  int fw = first >> 5, lw = last >> 5;
+  uint32_t lo_mask = 0xFFFFFFFFu << (first & 31);
+  uint32_t hi_mask = 0xFFFFFFFFu >> (31 - (last & 31));
+  if (fw == lw) return __builtin_popcount(bits[fw] & lo_mask & hi_mask);
+  int n = __builtin_popcount(bits[fw] & lo_mask) + __builtin_popcount(bits[lw] & hi_mask);
+  for (int w = fw + 1; w < lw; w++) n += __builtin_popcount(bits[w]);
+  return n;
+}
+
+// Run of set bits ending at `last`, walking towards bit 0. *reached_start is set when
+// the run covers bit 0, i.e. it may continue into the previous year.
+static int habit_run_ending_at(const uint32_t *bits, int last, bool *reached_start) {
+  int run = 0;
+  int w = last >> 5;
+  int avail = (last & 31) + 1;
+  uint32_t x = bits[w] << (31 - (last & 31));  // bit `last` moved to the MSB
+  *reached_start = false;
+  while (true) {
+    int ones = (~x == 0) ? 32 : __builtin_clz(~x);
+    if (ones < avail) return run + ones;
+    run += avail;
+    if (--w < 0) { *reached_start = true; return run; }
+    x = bits[w];
+    avail = 32;
+  }
+}
+
+// Longest run of set bits in one year
+static int habit_longest_run(const uint32_t *bits) {
+  int best = 0, carry = 0;
+  for (int w = 0; w < HABIT_WORDS; w++) {
+    uint32_t x = bits[w];
+    if (x == 0xFFFFFFFFu) { carry += 32; continue; }
+    best = std::max(best, carry + __builtin_ctz(~x));
+    // Each x &= x >> 1 shortens every run by one: iterations = longest run in the word
+    int inner = 0;
+    for (uint32_t y = x; y; y &= y >> 1) inner++;
+    best = std::max(best, inner);
+    carry = __builtin_clz(~x);  // ones reaching bit 31 continue into the next word
+  }
+  return std::max(best, carry);
+}
+
+void LifeMatrix::set_habit_list_csv(const std::string &csv) {
+  for (int slot = 0; slot < HABIT_YEARS; slot++) {
+    if (habit_dirty_[slot]) { habit_save_(); break; }
+  }
+  // Parsed straight into the fixed names, trimmed and cut to LIFE_MATRIX_LABEL_LEN - 1
+  habit_count_ = 0;
+  size_t pos = 0;
+  while (pos <= csv.size() && habit_count_ < HABIT_MAX) {
+    size_t comma = csv.find(',', pos);
+    if (comma == std::string::npos) comma = csv.size();
+    size_t b = pos, e = comma;
+    while (b < e && csv[b] == ' ') b++;
+    while (e > b && csv[e - 1] == ' ') e--;
+    if (e > b) habit_names_[habit_count_++].assign(csv.data() + b, e - b);
+    pos = comma + 1;
+  }
+  // Names index the NVS blobs (and the count sizes the cache): drop resident years so they
+  // reload under the new list
+  habit_bits_.clear();
+  memset(habit_slot_year_, 0, sizeof(habit_slot_year_));
+  if (habit_selected_ >= habit_count_) habit_selected_ = -1;
+  ESP_LOGD(TAG, "Habits: %u configured", habit_count_);
+}
+
+uint32_t *LifeMatrix::habit_year_bits_(int habit, int year) {
+  if (habit < 0 || habit >= habit_count_ || year <= 0) return nullptr;
+  if (habit_bits_.empty()) {
+    habit_bits_.assign((size_t)HABIT_YEARS * habit_count_ * HABIT_WORDS, 0);
+    memset(habit_slot_year_, 0, sizeof(habit_slot_year_));
+  }
+  int slot = year % HABIT_YEARS;
+  if (habit_slot_year_[slot] != year) {
+    if (habit_dirty_[slot]) habit_save_();
+    std::fill_n(habit_slot_bits_(slot, 0), (size_t)habit_count_ * HABIT_WORDS, 0u);
+    habit_slot_year_[slot] = year;
+    nvs_handle_t h;
+    if (lm_nvs_open(h, NVS_READONLY) == ESP_OK) {
+      for (int i = 0; i < habit_count_; i++) {
+        char key[16];
+        habit_nvs_key(key, habit_names_[i].c_str(), year);
+        size_t len = HABIT_BLOB_BYTES;
+        nvs_get_blob(h, key, habit_slot_bits_(slot, i), &len);
+      }
+      nvs_close(h);
+    }
+  }
+  return habit_slot_bits_(slot, habit);
+}
+
+void LifeMatrix::habit_release_() {
+  for (int slot = 0; slot < HABIT_YEARS; slot++) {
+    if (habit_dirty_[slot]) { habit_save_(); break; }
+  }
+  habit_bits_.clear();
+  habit_bits_.shrink_to_fit();
+  memset(habit_slot_year_, 0, sizeof(habit_slot_year_));
+}
+
+void LifeMatrix::habit_save_() {
+  nvs_handle_t h;
+  if (lm_nvs_open(h, NVS_READWRITE) != ESP_OK) return;
+  int written = 0;
+  for (int slot = 0; slot < HABIT_YEARS; slot++) {
+    for (int i = 0; i < habit_count_; i++) {
+      if (!(habit_dirty_[slot] & (1u << i))) continue;
+      char key[16];
+      habit_nvs_key(key, habit_names_[i].c_str(), habit_slot_year_[slot]);
+      nvs_set_blob(h, key, habit_slot_bits_(slot, i), HABIT_BLOB_BYTES);
+      written++;
+    }
+    habit_dirty_[slot] = 0;
+  }
+  nvs_commit(h);
+  nvs_close(h);
+  ESP_LOGD(TAG, "Habits: saved %d habit-year blob(s)", written);
+}
+
+void LifeMatrix::set_habit_done(int habit, int year, int doy, bool done) {
+  if (doy < 0 || doy >= habit_days_in_year(year)) return;
+  uint32_t *bits = habit_year_bits_(habit, year);
+  if (!bits) return;
+  uint32_t mask = 1u << (doy & 31);
+  if (((bits[doy >> 5] & mask) != 0) == done) return;
+  bits[doy >> 5] ^= mask;
+  habit_dirty_[year % HABIT_YEARS] |= 1u << habit;
+  // Coalesce a burst of toggles into one NVS write (same name replaces the pending timeout)
+  this->set_timeout("habit_save", 3000, [this]() { habit_save_(); });
+}
+
+bool LifeMatrix::is_habit_done(int habit, int year, int doy) {
+  if (doy < 0 || doy > 365) return false;
+  const uint32_t *bits = habit_year_bits_(habit, year);
+  return bits && ((bits[doy >> 5] >> (doy & 31)) & 1u);
+}
+
+void LifeMatrix::set_habit_done_today(int habit, bool done) {
+  ESPTime t = get_display_time();
+  if (!t.is_valid()) return;
+  set_habit_done(habit, t.year, compute_doy(t.year, t.month, t.day_of_month), done);
+}
+
+void LifeMatrix::toggle_habit_today(int habit) {
+  ESPTime t = get_display_time();
+  if (!t.is_valid() || habit < 0 || habit >= habit_count_) return;
+  int doy = compute_doy(t.year, t.month, t.day_of_month);
+  bool done = !is_habit_done(habit, t.year, doy);
+  set_habit_done(habit, t.year, doy, done);
+  request_redraw();
+  ESP_LOGD(TAG, "Habit '%s' %s for today", habit_names_[habit].c_str(), done ? "done" : "cleared");
+}
+
+void LifeMatrix::select_next_habit() {
+  if (habit_count_ == 0) return;
+  habit_selected_ = (habit_selected_ + 1 >= habit_count_) ? -1 : habit_selected_ + 1;
+  request_redraw();
+}
+
+HabitStats LifeMatrix::get_habit_stats(int habit, const ESPTime &time) {
+  HabitStats st;
+  const uint32_t *bits = habit_year_bits_(habit, time.year);
+  if (!bits) return st;
+  int today = compute_doy(time.year, time.month, time.day_of_month);
+  st.days_ytd = today + 1;
+  st.done_ytd = habit_popcount_range(bits, 0, today);
+  st.best_streak = habit_longest_run(bits);
+
+  // Last 30 days, borrowing the tail of the previous year in early January
+  st.done_30d = habit_popcount_range(bits, std::max(0, today - 29), today);
+  if (today < 29) {
+    const uint32_t *prev = habit_year_bits_(habit, time.year - 1);
+    int prev_days = habit_days_in_year(time.year - 1);
+    if (prev) st.done_30d += habit_popcount_range(prev, prev_days - (29 - today), prev_days - 1);
+  }
+
+  // Current streak: an open today doesn't break it, so count back from yesterday
+  int year = time.year;
+  int last = ((bits[today >> 5] >> (today & 31)) & 1u) ? today : today - 1;
+  while (time.year - year < HABIT_YEARS) {
+    if (last < 0) {
+      year--;
+      last = habit_days_in_year(year) - 1;
+      if (time.year - year >= HABIT_YEARS) break;
+    }
+    bool reached_start;
+    st.current_streak += habit_run_ending_at(habit_year_bits_(habit, year), last, &reached_start);
+    if (!reached_start) break;
+    last = -1;
+  }
+  return st;
+}
+
+void LifeMatrix::render_habits_view(display::Display &it, ESPTime &time, const Viewport &vp) {
+  int center_x = it.get_width() / 2;
+  if (habit_count_ == 0) {
+    if (font_small_) {
+      direct_(it).print(center_x, vp.text_y, font_small_, color_active_, display::TextAlign::CENTER, "Habit");
+      direct_(it).print(center_x, vp.viz_y + vp.viz_height / 2 - 5, font_small_, color_highlight_,
+               display::TextAlign::CENTER, "None");
+    }
+    return;
+  }
+
+  int year = time.year;
+  if (year <= 0) return;
+  int today = compute_doy(year, time.month, time.day_of_month);
+  uint8_t days_in_month[12];
+  get_days_in_month(year, days_in_month);
+
+  // Same geometry as the year view: 12 month bands, one column band per day of month
+  const ViewLayout &lay = layout_;
+  int month_h = lay.year_month_h;
+  int day_w = lay.year_day_w;
+  int viz_y = vp.viz_y, viz_height = vp.viz_height;
+
+  // Overview stacks every habit as a horizontal stripe of the month band;
+  // a selected habit fills the whole band
+  int first = habit_selected_ < 0 ? 0 : habit_selected_;
+  int count = habit_selected_ < 0 ? habit_count_ : 1;
+  const uint32_t *bits[HABIT_MAX];
+  Color done_clr[HABIT_MAX], missed_clr[HABIT_MAX], open_clr[HABIT_MAX], future_clr[HABIT_MAX];
+  for (int h = first; h < first + count; h++) {
+    bits[h] = habit_year_bits_(h, year);
+    done_clr[h] = hsv_to_rgb((h * 360) / habit_count_, 1.0f, 1.0f);
+    missed_clr[h] = Color(done_clr[h].r >> 4, done_clr[h].g >> 4, done_clr[h].b >> 4);
+    open_clr[h] = Color(done_clr[h].r >> 2, done_clr[h].g >> 2, done_clr[h].b >> 2);
+    future_clr[h] = dim_future(done_clr[h]);
+  }
+  int stripe_habit[32];
+  for (int py = 0; py < month_h && py < 32; py++) stripe_habit[py] = first + (py * count) / month_h;
+
+  int month_doy = 0;
+  for (int month_idx = 0; month_idx < 12; month_idx++) {
+    int month_base_row = month_idx * month_h;
+    for (int day = 1; day <= days_in_month[month_idx]; day++) {
+      int d = month_doy + day - 1;
+      bool future = d > today;
+      if (future && !show_future_) break;
+      for (int py = 0; py < month_h && py < 32; py++) {
+        int h = stripe_habit[py];
+        Color c;
+        if (future) c = future_clr[h];
+        else if ((bits[h][d >> 5] >> (d & 31)) & 1u) c = done_clr[h];
+        else c = (d == today) ? open_clr[h] : missed_clr[h];
+        if (c.r == 0 && c.g == 0 && c.b == 0) continue;
+        int logical_row = month_base_row + py;
+        int screen_y = fill_direction_bottom_to_top_ ? (viz_y + viz_height - 1 - logical_row) : (viz_y + logical_row);
+        for (int dx = 0; dx < day_w; dx++) draw_pixel(it, lay.year_day_x[day] + dx, screen_y, c);
+      }
+    }
+    month_doy += days_in_month[month_idx];
+  }
+
+  // Column 0: today marker
+  int today_idx = time.month - 1;
+  int today_row = today_idx * month_h + ((time.day_of_month - 1) * month_h) / days_in_month[today_idx];
+  draw_pixel(it, 0, fill_direction_bottom_to_top_ ? (viz_y + viz_height - 1 - today_row) : (viz_y + today_row),
+             color_highlight_);
+
+  // Text area alternates label and stats every 3 s
+  if (text_area_position_ == "None" || !font_small_) return;
+  bool show_stats = (millis() / 3000) % 2;
+  char buf[12];
+  if (habit_selected_ < 0) {
+    if (show_stats) {
+      int done_today = 0;
+      for (int h = 0; h < habit_count_; h++) done_today += (bits[h][today >> 5] >> (today & 31)) & 1u;
+      snprintf(buf, sizeof(buf), "%d/%d", done_today, (int)habit_count_);
+    } else {
+      snprintf(buf, sizeof(buf), "Habit");
+    }
+    direct_(it).print(center_x, vp.text_y, font_small_, color_active_, display::TextAlign::CENTER, buf);
+  } else {
+    if (show_stats) {
+      HabitStats st = get_habit_stats(habit_selected_, time);
+      snprintf(buf, sizeof(buf), "%dd", st.current_streak);
+    } else {
+      snprintf(buf, sizeof(buf), "%.5s", habit_names_[habit_selected_].c_str());
+    }
+    direct_(it).print(center_x, vp.text_y, font_small_, done_clr[habit_selected_], display::TextAlign::CENTER, buf);
+  }
+}
+#endif
+
+#ifndef LIFE_MATRIX_NO_SENSORS
+// ============================================================================
+// SENSOR GRAPHS
+// ============================================================================
+// Samples are folded straight into a min/max bin and not kept otherwise, so the
+// decimated view is always current. Time runs along the rows (oldest at the fill
+// start), value across the bar columns, autoscaled to the visible bins.
+
+void SensorSeries::push(float v) {
+  if (std::isnan(v) || capacity == 0) return;
+  uint32_t i = total++;
+  latest = v;
+  GraphBin &bin = bins[(i / per_bin) % bin_count];
+  if (i % per_bin == 0) {
+    bin.min = bin.max = v;  // first sample of a fresh (or recycled) bin
+  } else {
+    bin.min = std::min(bin.min, v);
+    bin.max = std::max(bin.max, v);
+  }
+}
+
+void LifeMatrix::add_sensor_graph(sensor::Sensor *sens, const std::string &label, uint16_t samples,
+                                  uint32_t interval_ms) {
+  if (sens == nullptr || samples == 0 || graphs_.size() >= GRAPH_MAX_SERIES) return;
+  graphs_.reserve(GRAPH_MAX_SERIES);  // bounded: reserve once so adding a series never reallocates
+  graphs_.emplace_back();
+  SensorSeries &g = graphs_.back();
+  g.sensor = sens;
+  g.label = label;
+  g.interval_ms = interval_ms;
+  g.capacity = samples;
+  g.per_bin = (samples + GRAPH_BINS - 1) / GRAPH_BINS;
+  g.bin_count = (samples + g.per_bin - 1) / g.per_bin;
+  g.bins.assign(g.bin_count, GraphBin{0.0f, 0.0f});
+
+  size_t idx = graphs_.size() - 1;
+  if (interval_ms == 0) {
+    sens->add_on_state_callback([this, idx](float v) { graphs_[idx].push(v); });
   }
+  ESP_LOGD(TAG, "Sensor graph '%s': %u samples, %u per bin, %u bytes", label.c_str(), samples, g.per_bin,
+           (unsigned)g.bytes());
+}
 
-  // ── TEXT AREA: time, phase name, or active milestone label ────────────────
+void LifeMatrix::select_next_graph() {
+  if (graphs_.empty()) return;
+  graph_selected_ = (graph_selected_ + 1) % graphs_.size();
+  request_redraw();
+}
+
+void LifeMatrix::render_sensor_graph_view(display::Display &it, const Viewport &vp) {
+  int center_x = it.get_width() / 2;
+  if (graphs_.empty()) {
+    if (font_small_) {
+      direct_(it).print(center_x, vp.text_y, font_small_, color_active_, display::TextAlign::CENTER, "Graph");
+      direct_(it).print(center_x, vp.viz_y + vp.viz_height / 2 - 5, font_small_, color_highlight_,
+               display::TextAlign::CENTER, "None");
+    }
+    return;
+  }
+  if (graph_selected_ >= graphs_.size()) graph_selected_ = 0;
+  const SensorSeries &g = graphs_[graph_selected_];
+  const ViewLayout &lay = layout_;
+  int rows = vp.viz_height;
+
+  // Text area alternates label and latest value every 3 s
   if (text_area_position_ != "None" && font_small_) {
-    Viewport vp = calculate_viewport(it);
-    if (highlighted_phase >= 0 && lifespan_config_.phase_cycle_s > 0.1f) {
-      it.print(width / 2, vp.text_y, font_small_,
-               get_phase_color(highlighted_phase),
-               display::TextAlign::CENTER,
-               get_phase_short_name(highlighted_phase));
+    char buf[12];
+    if ((millis() / 3000) % 2 == 0 || std::isnan(g.latest)) {
+      snprintf(buf, sizeof(buf), "%.5s", g.label.empty() ? "Graph" : g.label.c_str());
+    } else if (std::fabs(g.latest) >= 100.0f) {
+      snprintf(buf, sizeof(buf), "%.0f", g.latest);
     } else {
-      // Check for active milestone label in the current year
-      const char *label = nullptr;
-      for (const auto &m : lifespan_config_.milestones) {
-        if (m.date.year == current_year && !m.label.empty()) {
-          label = m.label.c_str(); break;
-        }
-      }
-      if (label) {
-        it.print(width / 2, vp.text_y, font_small_,
-                 Color(200, 200, 0), display::TextAlign::CENTER, label);
-      } else {
-        char buf[8];
-        snprintf(buf, sizeof(buf), "%02d:%02d", time.hour, time.minute);
-        it.print(width / 2, vp.text_y, font_small_,
-                 color_active_, display::TextAlign::CENTER, buf);
-      }
+      snprintf(buf, sizeof(buf), "%.1f", g.latest);
+    }
+    direct_(it).print(center_x, vp.text_y, font_small_, color_active_, display::TextAlign::CENTER, buf);
+  }
+  if (g.total == 0 || rows <= 0) return;
+
+  // Visible bins, oldest first: the newest bin may still be filling
+  uint32_t last_bin = (g.total - 1) / g.per_bin;
+  int visible = (int)std::min<uint32_t>(g.bin_count, last_bin + 1);
+  uint32_t first_bin = last_bin + 1 - visible;
+
+  float lo = INFINITY, hi = -INFINITY;
+  for (int k = 0; k < visible; k++) {
+    const GraphBin &b = g.bins[(first_bin + k) % g.bin_count];
+    lo = std::min(lo, b.min);
+    hi = std::max(hi, b.max);
+  }
+  if (hi - lo < 1e-3f) { lo -= 0.5f; hi += 0.5f; }
+  float x_scale = (float)(lay.bar_w - 1) / (hi - lo);
+
+  // One row per bin when they fit (newest at the fill end); otherwise merge bin runs per row
+  int used_rows = std::min(rows, visible);
+  int row0 = rows - used_rows;
+  Color line_clr = color_active_;
+  Color area_clr = Color(line_clr.r >> 3, line_clr.g >> 3, line_clr.b >> 3);
+  for (int r = 0; r < used_rows; r++) {
+    int k0 = (int)((int64_t)r * visible / used_rows);
+    int k1 = (int)((int64_t)(r + 1) * visible / used_rows);
+    float mn = INFINITY, mx = -INFINITY;
+    for (int k = k0; k < k1; k++) {
+      const GraphBin &b = g.bins[(first_bin + k) % g.bin_count];
+      mn = std::min(mn, b.min);
+      mx = std::max(mx, b.max);
     }
+    int x_min = lay.bar_x + (int)((mn - lo) * x_scale + 0.5f);
+    int x_max = lay.bar_x + (int)((mx - lo) * x_scale + 0.5f);
+    int logical_row = row0 + r;
+    int screen_y = fill_direction_bottom_to_top_ ? (vp.viz_y + rows - 1 - logical_row) : (vp.viz_y + logical_row);
+    for (int x = lay.bar_x; x < x_min; x++) draw_pixel(it, x, screen_y, area_clr);
+    for (int x = x_min; x <= x_max; x++) draw_pixel(it, x, screen_y, line_clr);
+  }
+
+  // Column 0: one dot per series, the selected one lit
+  for (int i = 0; i < (int)graphs_.size(); i++) {
+    int y = fill_direction_bottom_to_top_ ? (vp.viz_y + rows - 1 - i * 2) : (vp.viz_y + i * 2);
+    draw_pixel(it, 0, y, i == graph_selected_ ? color_highlight_ : Color(40, 40, 40));
   }
 }
+#endif
 
 // ============================================================================
 // POMODORO TIMER IMPLEMENTATION
 // ============================================================================
+// The preset and round count are settings rows and stay compiled in without the screen.
+
+void LifeMatrix::set_pomo_preset(const std::string &name) {
+  if (name.find("Deep") != std::string::npos)       pomo_preset_ = POMO_PRESET_DEEP_WORK;
+  else if (name.find("Ultra") != std::string::npos) pomo_preset_ = POMO_PRESET_ULTRADIAN;
+  else                                               pomo_preset_ = POMO_PRESET_CLASSIC;
+  ESP_LOGD(TAG, "Pomo preset set: %d", (int)pomo_preset_);
+}
+
+void LifeMatrix::set_pomo_rounds(int rounds) {
+  if (rounds < 2) rounds = 2;
+  if (rounds > 8) rounds = 8;
+  pomo_rounds_before_long_break_ = rounds;
+}
 
+#ifndef LIFE_MATRIX_NO_POMODORO
 PomodoroPresetConfig LifeMatrix::get_preset_config() const {
   switch (pomo_preset_) {
     case POMO_PRESET_DEEP_WORK:  return {50, 10, 20};
@@ -3355,6 +5457,9 @@ int LifeMatrix::get_session_elapsed_sec() const {
 }
 
 void LifeMatrix::start_pomodoro() {
+  pomo_end_session_();  // restarting mid-session still records the work done so far
+  ESPTime now = time_ != nullptr ? time_->now() : ESPTime{};
+  pomo_session_start_epoch_ = now.is_valid() ? (uint32_t)now.timestamp : 0;
   pomo_phase_ = POMO_WORK;
   pomo_phase_start_ms_ = millis();
   pomo_paused_total_ms_ = 0;
@@ -3381,6 +5486,7 @@ void LifeMatrix::resume_pomodoro() {
 }
 
 void LifeMatrix::reset_pomodoro() {
+  pomo_end_session_();
   pomo_phase_ = POMO_IDLE;
   pomo_completed_rounds_ = 0;
   pomo_paused_ = false;
@@ -3402,6 +5508,7 @@ void LifeMatrix::skip_pomodoro_phase() {
 
 void LifeMatrix::advance_pomodoro_phase() {
   // Accumulate session elapsed BEFORE resetting phase timing so the spiral stays continuous
+  if (pomo_phase_ == POMO_WORK) pomo_session_focus_sec_ += get_pomo_elapsed_sec();
   pomo_session_elapsed_at_phase_start_sec_ += get_pomo_elapsed_sec();
   pomo_phase_start_ms_ = millis();
   pomo_paused_total_ms_ = 0;
@@ -3443,6 +5550,7 @@ void LifeMatrix::advance_pomodoro_phase() {
     if (pomo_event_sensor_) pomo_event_sensor_->publish_state("work_started");
 
   } else if (pomo_phase_ == POMO_LONG_BREAK) {
+    pomo_end_session_();  // log now: the COMPLETE screen may not outlive a reboot
     pomo_phase_ = POMO_COMPLETE;
     if (pomo_event_sensor_) pomo_event_sensor_->publish_state("session_complete");
     // Trigger sparkle for session complete
@@ -3486,10 +5594,12 @@ void LifeMatrix::update_pomodoro() {
 
 void LifeMatrix::log_exercise_snack() {
   if (!exercise_list_.empty() && exercise_snack_.exercise_idx < (int)exercise_list_.size()) {
-    std::string result = exercise_list_[exercise_snack_.exercise_idx] + ":" +
-                         std::to_string(exercise_snack_.rep_count);
+    char result[LIFE_MATRIX_LABEL_LEN + 8];
+    snprintf(result, sizeof(result), "%s:%d", exercise_list_[exercise_snack_.exercise_idx].c_str(),
+             exercise_snack_.rep_count);
     if (pomo_exercise_sensor_) pomo_exercise_sensor_->publish_state(result);
-    ESP_LOGD(TAG, "Exercise snack logged: %s", result.c_str());
+    if (pomo_phase_ != POMO_IDLE && pomo_session_snacks_ < 255) pomo_session_snacks_++;
+    ESP_LOGD(TAG, "Exercise snack logged: %s", result);
   }
   exercise_snack_.ui_visible = false;
 }
@@ -3516,37 +5626,35 @@ void LifeMatrix::exercise_prev() {
   exercise_snack_.ui_start_ms = millis();
 }
 
+void LifeMatrix::set_exercise_list(const std::vector<std::string> &list) {
+  exercise_list_.clear();
+  for (const auto &name : list) {
+    FixedLabel label;
+    label.assign(name);
+    if (!exercise_list_.push_back(label)) break;
+  }
+}
+
+// Parsed straight into the fixed list, names trimmed and cut to LIFE_MATRIX_LABEL_LEN - 1
 void LifeMatrix::set_exercise_list_csv(const std::string &csv) {
-  std::vector<std::string> exercises;
-  std::string item;
-  for (size_t i = 0; i <= csv.size(); i++) {
-    if (i == csv.size() || csv[i] == ',') {
-      size_t s = item.find_first_not_of(' ');
-      if (s != std::string::npos) {
-        item = item.substr(s);
-        size_t e = item.find_last_not_of(' ');
-        if (e != std::string::npos) item = item.substr(0, e + 1);
+  exercise_list_.clear();
+  size_t pos = 0;
+  while (pos <= csv.size()) {
+    size_t comma = csv.find(',', pos);
+    if (comma == std::string::npos) comma = csv.size();
+    size_t b = pos, e = comma;
+    while (b < e && csv[b] == ' ') b++;
+    while (e > b && csv[e - 1] == ' ') e--;
+    if (e > b) {
+      FixedLabel label;
+      label.assign(csv.data() + b, e - b);
+      if (!exercise_list_.push_back(label)) {
+        ESP_LOGW(TAG, "Exercise list: more than %u entries, rest ignored", (unsigned)exercise_list_.capacity());
+        break;
       }
-      if (!item.empty()) exercises.push_back(item);
-      item.clear();
-    } else {
-      item += csv[i];
     }
+    pos = comma + 1;
   }
-  set_exercise_list(exercises);
-}
-
-void LifeMatrix::set_pomo_preset(const std::string &name) {
-  if (name.find("Deep") != std::string::npos)       pomo_preset_ = POMO_PRESET_DEEP_WORK;
-  else if (name.find("Ultra") != std::string::npos) pomo_preset_ = POMO_PRESET_ULTRADIAN;
-  else                                               pomo_preset_ = POMO_PRESET_CLASSIC;
-  ESP_LOGD(TAG, "Pomo preset set: %d", (int)pomo_preset_);
-}
-
-void LifeMatrix::set_pomo_rounds(int rounds) {
-  if (rounds < 2) rounds = 2;
-  if (rounds > 8) rounds = 8;
-  pomo_rounds_before_long_break_ = rounds;
 }
 
 void LifeMatrix::set_pomo_phase_override(const std::string &phase) {
@@ -3649,6 +5757,195 @@ void LifeMatrix::set_pomo_phase_override(const std::string &phase) {
   }
 }
 
+// ============================================================================
+// POMODORO SESSION LOG
+// ============================================================================
+// Record n lives in chunk (n / 32) % 8 under key "pl<chunk>"; "pl_base" is the first
+// record of the head chunk and only changes when a new chunk is started, the head itself
+// follows from that chunk's length. Once the ring wraps the oldest chunk is reused.
+// Sessions are stamped with the real clock (not the test time override). Aggregates are
+// one "pl_agg" blob saved every POMO_AGG_SAVE_EVERY sessions with the head it covers;
+// when the log is loaded only the records after that head are replayed from the ring.
+// The head chunk and aggregates (~1.4 KB) are read on first use (a session ending, a
+// focus query, the heatmap) and dropped with the pomodoro screen unless the heatmap is on;
+// a reload reads the same state back, as every session is written through.
+
+
+static void pomo_chunk_key(char *buf, uint32_t record) {
+  snprintf(buf, 8, "pl%u", (unsigned)((record / POMO_LOG_CHUNK_RECORDS) % POMO_LOG_CHUNKS));
+}
+
+int LifeMatrix::pomo_week_index_(int year, int doy) {
+  int jan1_mon0 = (day_of_week_sakamoto(year, 1, 1) + 6) % 7;  // 0 = Monday
+  return (doy + jan1_mon0) / 7;
+}
+
+PomoLogCache &LifeMatrix::pomo_log_() {
+  if (pomo_log_cache_.empty()) {
+    pomo_log_cache_.emplace_back();
+    pomo_log_load_();
+  }
+  return pomo_log_cache_.front();
+}
+
+void LifeMatrix::pomo_log_release_() {
+  pomo_log_cache_.clear();
+  pomo_log_cache_.shrink_to_fit();
+}
+
+void LifeMatrix::pomo_log_load_() {
+  PomoLogCache &c = pomo_log_cache_.front();
+  PomoAggregates &agg = c.agg;
+  nvs_handle_t h;
+  bool agg_ok = false;
+  memset(c.chunk, 0, sizeof(c.chunk));
+  if (lm_nvs_open(h, NVS_READONLY) == ESP_OK) {
+    uint32_t base = 0;
+    if (nvs_get_u32(h, "pl_base", &base) == ESP_OK) {
+      char key[8];
+      pomo_chunk_key(key, base);
+      size_t len = sizeof(c.chunk);
+      if (nvs_get_blob(h, key, c.chunk, &len) == ESP_OK)
+        pomo_log_head_ = base + len / sizeof(PomoSessionRecord);
+    }
+    size_t len = sizeof(agg);
+    agg_ok = nvs_get_blob(h, "pl_agg", &agg, &len) == ESP_OK && len == sizeof(agg) &&
+             agg.version == POMO_AGG_VERSION;
+    nvs_close(h);
+  }
+  if (!agg_ok) memset(&agg, 0, sizeof(agg));
+  pomo_agg_saved_head_ = agg.head;
+  pomo_agg_catch_up_();
+  ESP_LOGD(TAG, "Pomodoro log: %u sessions logged, aggregates for %d", (unsigned)pomo_log_head_, agg.year);
+}
+
+// Folds the records logged since the aggregates were last saved. Aggregates that are
+// missing, ahead of the log or behind the oldest chunk still held are rebuilt from the ring.
+void LifeMatrix::pomo_agg_catch_up_() {
+  PomoAggregates &agg = pomo_log_cache_.front().agg;
+  const uint32_t held = std::min<uint32_t>(pomo_log_head_, POMO_LOG_CHUNKS * POMO_LOG_CHUNK_RECORDS);
+  const uint32_t oldest = pomo_log_head_ - held;
+  if (agg.version != POMO_AGG_VERSION || agg.head > pomo_log_head_ || agg.head < oldest) {
+    memset(&agg, 0, sizeof(agg));
+    agg.version = POMO_AGG_VERSION;
+    agg.head = oldest;
+  }
+  uint32_t from = agg.head;
+  agg.head = pomo_log_head_;
+  if (from == pomo_log_head_) return;
+  nvs_handle_t h;
+  if (lm_nvs_open(h, NVS_READONLY) != ESP_OK) return;
+  // Oldest first, so day_min/week_min end up describing the newest year
+  PomoSessionRecord chunk[POMO_LOG_CHUNK_RECORDS];
+  for (uint32_t i = from; i < pomo_log_head_;) {
+    char key[8];
+    pomo_chunk_key(key, i);
+    memset(chunk, 0, sizeof(chunk));
+    size_t len = sizeof(chunk);
+    nvs_get_blob(h, key, chunk, &len);
+    uint32_t end = std::min(pomo_log_head_, (i / POMO_LOG_CHUNK_RECORDS + 1) * POMO_LOG_CHUNK_RECORDS);
+    for (; i < end; i++) pomo_agg_add_(chunk[i % POMO_LOG_CHUNK_RECORDS]);
+  }
+  nvs_close(h);
+  ESP_LOGD(TAG, "Pomodoro log: %u records replayed into aggregates", (unsigned)(pomo_log_head_ - from));
+}
+
+void LifeMatrix::pomo_agg_add_(const PomoSessionRecord &rec) {
+  if (rec.start_epoch == 0) return;
+  PomoAggregates &agg = pomo_log_cache_.front().agg;
+  ESPTime t = ESPTime::from_epoch_local(rec.start_epoch);
+  int year = t.year;
+  int doy = compute_doy(year, t.month, t.day_of_month);
+
+  PomoYearTotal &yt = agg.years[year % POMO_YEAR_HISTORY];
+  if (yt.year != year) yt = PomoYearTotal{(int16_t)year, 0, 0};
+  yt.sessions++;
+  yt.focus_min += rec.focus_min;
+
+  // A session from a newer year starts fresh day/week arrays; older years only count in totals
+  if (year > agg.year) {
+    agg.year = year;
+    memset(agg.day_min, 0, sizeof(agg.day_min));
+    memset(agg.week_min, 0, sizeof(agg.week_min));
+  }
+  if (year != agg.year) return;
+  uint16_t &day = agg.day_min[doy];
+  day = (uint16_t)std::min(65535, day + rec.focus_min);
+  uint16_t &week = agg.week_min[pomo_week_index_(year, doy)];
+  week = (uint16_t)std::min(65535, week + rec.focus_min);
+}
+
+void LifeMatrix::pomo_log_append_(const PomoSessionRecord &rec) {
+  PomoLogCache &c = pomo_log_();
+  PomoAggregates &agg = c.agg;
+  uint32_t slot = pomo_log_head_ % POMO_LOG_CHUNK_RECORDS;
+  if (slot == 0) memset(c.chunk, 0, sizeof(c.chunk));  // reusing the oldest chunk
+  c.chunk[slot] = rec;
+  pomo_agg_add_(rec);
+  agg.head = pomo_log_head_ + 1;
+
+  nvs_handle_t h;
+  if (lm_nvs_open(h, NVS_READWRITE) == ESP_OK) {
+    char key[8];
+    pomo_chunk_key(key, pomo_log_head_);
+    // Only the head chunk is rewritten, trimmed to the records it holds so far; its
+    // length carries the head, so pl_base moves once per chunk
+    nvs_set_blob(h, key, c.chunk, (slot + 1) * sizeof(PomoSessionRecord));
+    if (slot == 0) nvs_set_u32(h, "pl_base", pomo_log_head_);
+    if (agg.head - pomo_agg_saved_head_ >= POMO_AGG_SAVE_EVERY) {
+      nvs_set_blob(h, "pl_agg", &agg, sizeof(agg));
+      pomo_agg_saved_head_ = agg.head;
+    }
+    nvs_commit(h);
+    nvs_close(h);
+  }
+  pomo_log_head_++;
+}
+
+void LifeMatrix::pomo_end_session_() {
+  if (pomo_phase_ == POMO_IDLE) return;
+  if (pomo_phase_ == POMO_WORK) pomo_session_focus_sec_ += get_pomo_elapsed_sec();
+  // Sessions abandoned within the first minute with nothing logged are not worth a write
+  if (pomo_session_focus_sec_ >= 60 || pomo_session_snacks_ > 0) {
+    PomoSessionRecord rec{};
+    rec.start_epoch = pomo_session_start_epoch_;
+    rec.focus_min = (uint16_t)std::min(pomo_session_focus_sec_ / 60, 65535);
+    rec.preset_rounds = (uint8_t)(((int)pomo_preset_ << 6) | std::min(pomo_completed_rounds_, 63));
+    rec.snacks = pomo_session_snacks_;
+    pomo_log_append_(rec);
+    ESP_LOGD(TAG, "Pomodoro session logged: %u min focus, %d rounds, %u snacks",
+             rec.focus_min, rec.preset_rounds & 0x3F, rec.snacks);
+  }
+  pomo_session_focus_sec_ = 0;
+  pomo_session_snacks_ = 0;
+}
+
+int LifeMatrix::get_focus_minutes_today() {
+  const PomoAggregates &agg = pomo_log_().agg;
+  ESPTime t = time_ != nullptr ? time_->now() : ESPTime{};
+  if (!t.is_valid() || t.year != agg.year) return 0;
+  return agg.day_min[compute_doy(t.year, t.month, t.day_of_month)];
+}
+
+int LifeMatrix::get_focus_minutes_week() {
+  const PomoAggregates &agg = pomo_log_().agg;
+  ESPTime t = time_ != nullptr ? time_->now() : ESPTime{};
+  if (!t.is_valid() || t.year != agg.year) return 0;
+  return agg.week_min[pomo_week_index_(t.year, compute_doy(t.year, t.month, t.day_of_month))];
+}
+
+int LifeMatrix::get_focus_minutes_year(int year) {
+  if (year <= 0) return 0;
+  const PomoAggregates &agg = pomo_log_().agg;
+  const PomoYearTotal &yt = agg.years[year % POMO_YEAR_HISTORY];
+  return yt.year == year ? (int)yt.focus_min : 0;
+}
+
+uint32_t LifeMatrix::get_pomo_sessions_logged() {
+  pomo_log_();  // the head is read with the log
+  return pomo_log_head_;
+}
+
 // ============================================================================
 // POMODORO RENDERING
 // ============================================================================
@@ -3657,8 +5954,9 @@ void LifeMatrix::render_spiral_timer(display::Display &it, int elapsed_sec, int
                                      Viewport vp, Color colors[4]) {
   if (total_sec <= 0) return;
 
+  const ViewLayout &lay = layout_;
   int quarter_h   = std::max(1, vp.viz_height / 4);
-  int quarter_px  = 30 * quarter_h;
+  int quarter_px  = lay.bar_w * quarter_h;
   int total_pixels = 4 * quarter_px;
 
   int filled_pixels = (int)((float)elapsed_sec / total_sec * total_pixels);
@@ -3679,11 +5977,11 @@ void LifeMatrix::render_spiral_timer(display::Display &it, int elapsed_sec, int
       int y_pos = fill_direction_bottom_to_top_
           ? (vp.viz_y + vp.viz_height - 1 - abs_row)
           : (vp.viz_y + abs_row);
-      for (int col = 1; col <= 30; col++) {
-        int pix = row * 30 + (col - 1);
+      for (int col = 0; col < lay.bar_w; col++) {
+        int pix = row * lay.bar_w + col;
         Color draw_c = (pix < q_filled) ? quarter_color : dim_color;
         if (draw_c.r == 0 && draw_c.g == 0 && draw_c.b == 0) continue;
-        draw_pixel(it, col, y_pos, draw_c);
+        draw_pixel(it, lay.bar_x + col, y_pos, draw_c);
       }
     }
   }
@@ -3694,37 +5992,47 @@ void LifeMatrix::render_pomodoro_blocks(display::Display &it, Viewport vp) {
   int n = pomo_rounds_before_long_break_;
   if (n <= 0) return;
 
-  const int block_w = 30;
+  const ViewLayout &lay = layout_;
+  const int block_w = lay.bar_w;
   int block_h = vp.viz_height / n;
   if (block_h <= 0) return;
 
   // Generate clockwise perimeter-spiral starting from the bottom-left corner.
   // Order: bottom row left→right, right col bottom→top, top row right→left,
-  //        left col top→bottom, repeat inward. Max 30×120 = 3600 pixels (n=1 full height).
-  // Cached: only recomputed when block_h changes (geometry is constant during a session).
-  static int   s_cached_block_h = -1;
-  static int   s_spiral_len = 0;
-  static int8_t xs[3600], ys[3600];
-  if (block_h != s_cached_block_h) {
-    s_cached_block_h = block_h;
-    s_spiral_len = 0;
+  //        left col top→bottom, repeat inward. One entry per block pixel, sized from
+  //        the block geometry; 16-bit coordinates cover any panel.
+  // Cached: only recomputed when the block geometry changes (constant during a session).
+  if (block_h != pomo_spiral_h_ || block_w != pomo_spiral_w_) {
+    pomo_spiral_h_ = block_h;
+    pomo_spiral_w_ = block_w;
+    size_t cells = (size_t)block_w * (size_t)block_h;
+    pomo_spiral_x_.clear();
+    pomo_spiral_y_.clear();
+    pomo_spiral_x_.reserve(cells);
+    pomo_spiral_y_.reserve(cells);
     int top = 0, bot = block_h - 1, left = 0, right = block_w - 1;
+    auto push = [&](int x, int y) {
+      pomo_spiral_x_.push_back((uint16_t)x);
+      pomo_spiral_y_.push_back((uint16_t)y);
+    };
     while (top <= bot && left <= right) {
-      for (int x = left; x <= right; x++) { xs[s_spiral_len] = x; ys[s_spiral_len++] = bot; }
+      for (int x = left; x <= right; x++) push(x, bot);
       bot--;
-      for (int y = bot; y >= top; y--) { xs[s_spiral_len] = right; ys[s_spiral_len++] = y; }
+      for (int y = bot; y >= top; y--) push(right, y);
       right--;
       if (top <= bot) {
-        for (int x = right; x >= left; x--) { xs[s_spiral_len] = x; ys[s_spiral_len++] = top; }
+        for (int x = right; x >= left; x--) push(x, top);
         top++;
       }
       if (left <= right) {
-        for (int y = top; y <= bot; y++) { xs[s_spiral_len] = left; ys[s_spiral_len++] = y; }
+        for (int y = top; y <= bot; y++) push(left, y);
         left++;
       }
     }
   }
-  int spiral_len = s_spiral_len;
+  const uint16_t *xs = pomo_spiral_x_.data();
+  const uint16_t *ys = pomo_spiral_y_.data();
+  int spiral_len = (int)pomo_spiral_x_.size();
   if (spiral_len <= 0) return;
 
   // Determine active block index
@@ -3769,12 +6077,14 @@ void LifeMatrix::render_pomodoro_blocks(display::Display &it, Viewport vp) {
   Color break_c = Color(0, 120, 255);
 
   // Precompute per-column rainbow for completed blocks: hue only depends on xs[p]
-  // (column 0–29), so 30 lookups replace spiral_len × n_completed hsv_to_rgb calls.
-  Color completed_col[30];
+  // (column 0…block_w-1), so block_w lookups replace spiral_len × n_completed hsv_to_rgb calls.
+  // Blocks wider than 256 columns share a hue between neighbouring columns.
+  Color completed_col[256];
+  const int hue_cols = std::min(block_w, 256);
   if (pomo_completed_rounds_ > 0) {
     int time_offset = (int)(now_ms / 30) % 360;
-    for (int x = 0; x < 30; x++)
-      completed_col[x] = hsv_to_rgb((x * 12 + time_offset) % 360, 1.0f, 1.0f);
+    for (int k = 0; k < hue_cols; k++)
+      completed_col[k] = hsv_to_rgb((k * 360 / hue_cols + time_offset) % 360, 1.0f, 1.0f);
   }
 
   // Draw each block
@@ -3791,12 +6101,12 @@ void LifeMatrix::render_pomodoro_blocks(display::Display &it, Viewport vp) {
     bool is_active    = (i == active_block) && (pomo_phase_ != POMO_COMPLETE) && (pomo_phase_ != POMO_IDLE);
 
     for (int p = 0; p < spiral_len; p++) {
-      int px = (int)xs[p] + 1;           // column 1..30
+      int px = (int)xs[p] + lay.bar_x;   // column bar_x … bar_x + block_w - 1
       int py = block_origin_y + (int)ys[p];
 
       Color c;
       if (is_completed) {
-        c = completed_col[(int)xs[p]];  // palette precomputed above (30 hsv calls vs spiral_len×n)
+        c = completed_col[(int)xs[p] * hue_cols / block_w];  // precomputed above, one hsv call per column
       } else if (is_active) {
         if (in_transition) {
           // Orange → blue blend across the whole block simultaneously
@@ -3826,27 +6136,27 @@ void LifeMatrix::render_exercise_snack_overlay(display::Display &it) {
   // Black background
   for (int y = overlay_top; y < h; y++) {
     for (int x = 0; x < w; x++) {
-      it.draw_pixel_at(x, y, Color(0, 0, 0));
+      draw_raw_pixel_(it, x, y, Color(0, 0, 0));
     }
   }
 
   // Yellow separator line
   for (int x = 0; x < w; x++) {
-    it.draw_pixel_at(x, overlay_top, Color(255, 200, 0));
+    draw_raw_pixel_(it, x, overlay_top, Color(255, 200, 0));
   }
 
   // Exercise name (uppercase)
   if (!exercise_list_.empty() && exercise_snack_.exercise_idx < (int)exercise_list_.size()) {
-    std::string name = exercise_list_[exercise_snack_.exercise_idx];
-    for (auto &c : name) c = toupper((unsigned char)c);
-    it.print(w / 2, overlay_top + 5, font_small_, Color(255, 200, 0),
+    FixedLabel name = exercise_list_[exercise_snack_.exercise_idx];
+    for (char *c = name.text; *c; c++) *c = toupper((unsigned char)*c);
+    direct_(it).print(w / 2, overlay_top + 5, font_small_, Color(255, 200, 0),
              display::TextAlign::CENTER, name.c_str());
   }
 
   // Rep/time count — plain number, large and centred
   char buf[8];
   snprintf(buf, sizeof(buf), "%d", exercise_snack_.rep_count);
-  it.print(w / 2, overlay_top + 13, font_small_, Color(255, 255, 255),
+  direct_(it).print(w / 2, overlay_top + 13, font_small_, Color(255, 255, 255),
            display::TextAlign::CENTER, buf);
 }
 
@@ -4094,6 +6404,8 @@ static const uint16_t kSplashScreenData[3840] = {
   0x18e4, 0x18e4, 0x18e4, 0x18e4, 0x18e4, 0x18e4, 0x18e4, 0x18e4, 0x18e4, 0x18e4, 0x18e4, 0x18e4, 0x18e4, 0x18e4, 0x18e4, 0x18e4
 };
 
+#endif
+
 // ─────────────────────────────────────────────────────────────────────────────
 // ICON REGISTRY AND RENDERING
 // ─────────────────────────────────────────────────────────────────────────────
@@ -4120,23 +6432,33 @@ static const uint16_t kDefaultPlayIcon[64] = {
   0xF81F, 0xF81F, 0xF81F, 0xF81F, 0xFA2A, 0xF81F, 0xF81F, 0xF81F,
 };
 
+IconData *LifeMatrix::find_icon_(const std::string &icon_id) {
+  for (auto &icon : icons_) {
+    if (icon_id == icon.id.c_str()) return &icon;
+  }
+  return nullptr;
+}
+
 void LifeMatrix::register_icon_frames(const std::string &icon_id, const uint16_t *data, uint8_t frame_count, std::vector<uint16_t> durations) {
   IconData icon;
+  icon.id.assign(icon_id);
   icon.data = data;
   icon.frame_count = frame_count;
   for (size_t i = 0; i < durations.size() && i < MAX_ICON_FRAMES; i++) {
     icon.frame_durations[i] = durations[i];
   }
-  icon_registry_[icon_id] = icon;
-  
-  // Initialize animation state
-  icon_current_frame_[icon_id] = 0;
-  icon_last_frame_time_[icon_id] = 0;
+  if (IconData *existing = find_icon_(icon_id)) {
+    *existing = icon;
+  } else if (!icons_.push_back(icon)) {
+    ESP_LOGW(TAG, "Icon '%s' dropped: registry full (%u)", icon_id.c_str(), (unsigned)icons_.capacity());
+  }
 }
 
 bool LifeMatrix::has_icon(const std::string &icon_id) const {
   // Check registry first, then fall back to built-in defaults
-  if (icon_registry_.find(icon_id) != icon_registry_.end()) return true;
+  for (const auto &icon : icons_) {
+    if (icon_id == icon.id.c_str()) return true;
+  }
   if (icon_id == "play") return true;  // Built-in default
   return false;
 }
@@ -4144,20 +6466,15 @@ bool LifeMatrix::has_icon(const std::string &icon_id) const {
 void LifeMatrix::update_icon_animations() {
   uint32_t now = millis();
   
-  for (auto &kv : icon_registry_) {
-    const std::string &icon_id = kv.first;
-    IconData &icon_data = kv.second;
-    
+  for (auto &icon_data : icons_) {
     if (icon_data.frame_count <= 1) continue;  // Static icon
     
-    uint8_t current_frame = icon_current_frame_[icon_id];
-    uint32_t last_time = icon_last_frame_time_[icon_id];
-    uint16_t duration = icon_data.frame_durations[current_frame];
+    uint16_t duration = icon_data.frame_durations[icon_data.current_frame];
     
-    if (now - last_time >= duration) {
+    if (now - icon_data.last_frame_ms >= duration) {
       // Advance to next frame
-      icon_current_frame_[icon_id] = (current_frame + 1) % icon_data.frame_count;
-      icon_last_frame_time_[icon_id] = now;
+      icon_data.current_frame = (icon_data.current_frame + 1) % icon_data.frame_count;
+      icon_data.last_frame_ms = now;
     }
   }
 }
@@ -4172,16 +6489,10 @@ void LifeMatrix::draw_icon(display::Display &it, const std::string &icon_id, int
   uint8_t current_frame = 0;
   
   // Look up icon in registry
-  auto it_icon = icon_registry_.find(icon_id);
-  if (it_icon != icon_registry_.end()) {
-    IconData &icon = it_icon->second;
-    data = icon.data;
-    frame_count = icon.frame_count;
-    // Get current frame for animated icons
-    auto it_frame = icon_current_frame_.find(icon_id);
-    if (it_frame != icon_current_frame_.end()) {
-      current_frame = it_frame->second;
-    }
+  if (IconData *icon = find_icon_(icon_id)) {
+    data = icon->data;
+    frame_count = icon->frame_count;
+    current_frame = icon->current_frame;
   } else if (icon_id == "play") {
     // Fall back to built-in default
     data = kDefaultPlayIcon;
@@ -4215,7 +6526,9 @@ void LifeMatrix::draw_icon(display::Display &it, const std::string &icon_id, int
   }
 }
 
+#ifndef LIFE_MATRIX_NO_POMODORO
 void LifeMatrix::render_pomo_idle_logo(display::Display &it, Viewport vp) {
+  int x0 = std::max(0, (layout_.width - 32) / 2);  // 32×120 artwork, centred on wider panels
   for (int y = 0; y < 120 && y < vp.viz_height; y++) {
     int dy = vp.viz_y + y;
     for (int x = 0; x < 32; x++) {
@@ -4224,7 +6537,7 @@ void LifeMatrix::render_pomo_idle_logo(display::Display &it, Viewport vp) {
       uint8_t r = ((px >> 11) & 0x1F) * 255 / 31;
       uint8_t g = ((px >> 5)  & 0x3F) * 255 / 63;
       uint8_t b = (px         & 0x1F) * 255 / 31;
-      draw_pixel(it, x, dy, Color(r, g, b));
+      draw_pixel(it, x0 + x, dy, Color(r, g, b));
     }
   }
 }
@@ -4280,7 +6593,7 @@ void LifeMatrix::render_pomodoro_view(display::Display &it, ESPTime &time, Viewp
         if (row > bounds[b]) { seg_row_start = bounds[b] + 1; seg_t_start = t_bounds[b]; }
       }
       if (is_sep) {
-        for (int col = 1; col <= 30; col++) it.draw_pixel_at(col, y_pos, Color(0, 0, 0));
+        for (int col = layout_.bar_x; col < layout_.bar_x + layout_.bar_w; col++) draw_raw_pixel_(it, col, y_pos, Color(0, 0, 0));
         continue;
       }
 
@@ -4294,12 +6607,12 @@ void LifeMatrix::render_pomodoro_view(display::Display &it, ESPTime &time, Viewp
       int seg_duration = seg_t_end - seg_t_start;
       int seg_elapsed  = std::min(std::max(0, sess_elapsed - seg_t_start), seg_duration);
       int seg_rows     = seg_row_end - seg_row_start + 1;
-      int seg_pixels   = seg_rows * 30;
+      int seg_pixels   = seg_rows * layout_.bar_w;
       int seg_filled   = (seg_duration > 0)
           ? (int)((long long)seg_elapsed * seg_pixels / seg_duration)
           : 0;
 
-      int local_pix_base = (row - seg_row_start) * 30;
+      int local_pix_base = (row - seg_row_start) * layout_.bar_w;
 
       Color bright_c;
       if (style_ == STYLE_GRADIENT)
@@ -4310,11 +6623,11 @@ void LifeMatrix::render_pomodoro_view(display::Display &it, ESPTime &time, Viewp
         bright_c = color_active_;
       Color dim_c = dim_future(bright_c);
 
-      for (int col = 1; col <= 30; col++) {
-        int local_pix = local_pix_base + (col - 1);
+      for (int col = 0; col < layout_.bar_w; col++) {
+        int local_pix = local_pix_base + col;
         Color draw_c = (local_pix < seg_filled) ? bright_c : dim_c;
         if (draw_c.r == 0 && draw_c.g == 0 && draw_c.b == 0) continue;
-        draw_pixel(it, col, y_pos, draw_c);
+        draw_pixel(it, layout_.bar_x + col, y_pos, draw_c);
       }
     }
   }
@@ -4328,7 +6641,7 @@ void LifeMatrix::render_pomodoro_view(display::Display &it, ESPTime &time, Viewp
   if (font_small_ && text_area_position_ != "None" && pomo_phase_ != POMO_IDLE) {
     char text_buf[8];
     if (pomo_phase_ == POMO_COMPLETE) {
-      it.print(center_x, vp.text_y, font_small_, color_highlight_,
+      direct_(it).print(center_x, vp.text_y, font_small_, color_highlight_,
                display::TextAlign::CENTER, "DONE!");
     } else {
       // Just MM:SS — phase is obvious from spiral warm/cool colors; avoid clipping
@@ -4336,7 +6649,7 @@ void LifeMatrix::render_pomodoro_view(display::Display &it, ESPTime &time, Viewp
       if (remaining < 0) remaining = 0;
       snprintf(text_buf, sizeof(text_buf), "%02d:%02d", remaining / 60, remaining % 60);
       Color text_color = pomo_paused_ ? Color(120, 120, 120) : color_active_;
-      it.print(center_x, vp.text_y, font_small_, text_color,
+      direct_(it).print(center_x, vp.text_y, font_small_, text_color,
                display::TextAlign::CENTER, text_buf);
     }
   }
@@ -4350,19 +6663,28 @@ void LifeMatrix::render_pomodoro_view(display::Display &it, ESPTime &time, Viewp
 
   // ── EXERCISE SNACK OVERLAY ────────────────────────────────────────────────
   if (exercise_snack_.ui_visible) {
-    render_exercise_snack_overlay(it);
+    render_exercise_snack_overlay(direct_(it));
   }
 }
+#endif
 
 // ============================================================================
 // INPUT HANDLERS
 // ============================================================================
 
 void LifeMatrix::enc1_clockwise() {
+  if (note_user_input_()) return;
+#ifndef LIFE_MATRIX_NO_POMODORO
   if (get_current_screen_id() == SCREEN_POMODORO && is_exercise_ui_visible()) {
     exercise_next();
-  } else if (ui_mode_ == SETTINGS) {
+  } else
+#endif
+  if (ui_mode_ == SETTINGS) {
     next_settings_cursor();
+#ifndef LIFE_MATRIX_NO_GOL
+  } else if (ui_paused_ && rewind_cap_ > 0 && get_current_screen_id() == SCREEN_GAME_OF_LIFE) {
+    rewind_scrub_(+1);
+#endif
   } else {
     set_ui_mode(MANUAL_BROWSE);
     next_screen();
@@ -4370,10 +6692,18 @@ void LifeMatrix::enc1_clockwise() {
 }
 
 void LifeMatrix::enc1_anticlockwise() {
+  if (note_user_input_()) return;
+#ifndef LIFE_MATRIX_NO_POMODORO
   if (get_current_screen_id() == SCREEN_POMODORO && is_exercise_ui_visible()) {
     exercise_prev();
-  } else if (ui_mode_ == SETTINGS) {
+  } else
+#endif
+  if (ui_mode_ == SETTINGS) {
     prev_settings_cursor();
+#ifndef LIFE_MATRIX_NO_GOL
+  } else if (ui_paused_ && rewind_cap_ > 0 && get_current_screen_id() == SCREEN_GAME_OF_LIFE) {
+    rewind_scrub_(-1);
+#endif
   } else {
     set_ui_mode(MANUAL_BROWSE);
     prev_screen();
@@ -4381,49 +6711,60 @@ void LifeMatrix::enc1_anticlockwise() {
 }
 
 void LifeMatrix::adjust_display_brightness(int delta) {
-  if (!ha_display_brightness_) return;
-  // Use entity state if valid, otherwise fall back to current tracked value
-  float cur = std::isnan(ha_display_brightness_->state) ? base_brightness_pct_ : ha_display_brightness_->state;
-  float new_pct = std::max(1.0f, std::min(100.0f, cur + (float)delta));
-  // Apply to device immediately — don't rely solely on the callback chain
-  set_base_brightness_pct(new_pct);
-  // Sync HA entity so the web interface stays in sync (also fires callback, harmless)
-  auto call = ha_display_brightness_->make_call();
-  call.set_value(new_pct);
-  call.perform();
+  // Clamped by the settings row; syncs the HA entity and its NVS slot when bound
+  apply_setting(SET_BRIGHTNESS, (int)base_brightness_pct_ + delta);
 }
 
 void LifeMatrix::enc2_clockwise() {
+  if (note_user_input_()) return;
+#ifndef LIFE_MATRIX_NO_POMODORO
   if (get_current_screen_id() == SCREEN_POMODORO && is_exercise_ui_visible()) {
     exercise_adjust_reps(+1);
-  } else if (ui_mode_ == SETTINGS) {
+  } else
+#endif
+  if (ui_mode_ == SETTINGS) {
     if (settings_cursor_ == 0)
       adjust_display_brightness(+5);
     else
       adjust_setting(+1);
+#ifndef LIFE_MATRIX_NO_LIFESPAN
+  } else if (get_current_screen_id() == SCREEN_LIFESPAN) {
+    zoom_lifespan(+1);
+#endif
   } else {
     adjust_display_brightness(+5);
   }
 }
 
 void LifeMatrix::enc2_anticlockwise() {
+  if (note_user_input_()) return;
+#ifndef LIFE_MATRIX_NO_POMODORO
   if (get_current_screen_id() == SCREEN_POMODORO && is_exercise_ui_visible()) {
     exercise_adjust_reps(-1);
-  } else if (ui_mode_ == SETTINGS) {
+  } else
+#endif
+  if (ui_mode_ == SETTINGS) {
     if (settings_cursor_ == 0)
       adjust_display_brightness(-5);
     else
       adjust_setting(-1);
+#ifndef LIFE_MATRIX_NO_LIFESPAN
+  } else if (get_current_screen_id() == SCREEN_LIFESPAN) {
+    zoom_lifespan(-1);
+#endif
   } else {
     adjust_display_brightness(-5);
   }
 }
 
 void LifeMatrix::toggle_settings_mode() {
+  if (note_user_input_()) return;
   set_ui_mode(ui_mode_ == SETTINGS ? AUTO_CYCLE : SETTINGS);
 }
 
 void LifeMatrix::enc2_press() {
+  if (note_user_input_()) return;
+#ifndef LIFE_MATRIX_NO_POMODORO
   if (get_current_screen_id() == SCREEN_POMODORO) {
     if (is_exercise_ui_visible())
       log_exercise_snack();
@@ -4433,17 +6774,39 @@ void LifeMatrix::enc2_press() {
       resume_pomodoro();
     else
       pause_pomodoro();
-  } else {
-    toggle_pause();
+    return;
+  }
+#endif
+#ifndef LIFE_MATRIX_NO_HABITS
+  if (get_current_screen_id() == SCREEN_HABITS && habit_selected_ >= 0) {
+    toggle_habit_today(habit_selected_);
+    return;
   }
+#endif
+  toggle_pause();
+}
+
+void LifeMatrix::button_up_press() {
+  if (note_user_input_()) return;
+  toggle_pause();
 }
 
 void LifeMatrix::button_down_press() {
-  int screen = get_current_screen_id();
-  if (screen == SCREEN_GAME_OF_LIFE)
-    reset_game_of_life();
-  else if (screen == SCREEN_POMODORO)
-    skip_pomodoro_phase();
+  if (note_user_input_()) return;
+  switch (get_current_screen_id()) {
+#ifndef LIFE_MATRIX_NO_GOL
+    case SCREEN_GAME_OF_LIFE: reset_game_of_life(); break;
+#endif
+#ifndef LIFE_MATRIX_NO_POMODORO
+    case SCREEN_POMODORO:     skip_pomodoro_phase(); break;
+#endif
+#ifndef LIFE_MATRIX_NO_HABITS
+    case SCREEN_HABITS:       select_next_habit(); break;
+#endif
+#ifndef LIFE_MATRIX_NO_SENSORS
+    case SCREEN_SENSORS:      select_next_graph(); break;
+#endif
+  }
 }
 
 // ============================================================================
@@ -4500,6 +6863,12 @@ ESPTime LifeMatrix::get_display_time() const {
 
 void LifeMatrix::apply_brightness() {
   if (!brightness_fn_) return;
+  if (sleeping_) {
+    brightness_target_ = brightness_applied_ = 0;
+    power_limiting_ = false;
+    brightness_fn_(0);
+    return;
+  }
   int b = (int)(base_brightness_pct_ * 2.55f);
   if (night_mode_level_ > 0) {
     auto t = get_display_time();
@@ -4513,120 +6882,835 @@ void LifeMatrix::apply_brightness() {
       }
     }
   }
-  brightness_fn_((uint8_t)b);
+  brightness_target_ = (uint8_t)b;
+  power_apply_();
+}
+
+// ============================================================================
+// POWER ESTIMATOR / BRIGHTNESS LIMITER
+// ============================================================================
+// Panel current ≈ idle + channel_current × Σ(r+g+b)/255 × brightness/255. The power limit
+// turns the palette canvas on, so the channel sum is gathered while the canvas is blitted
+// (one add per pixel out of a per-slot table), plus any pixels a frame wrote straight to
+// the panel: a transition, or the rest of a frame after a palette overflow.
+
+void LifeMatrix::power_note_(display::Display &it, Color c) {
+  if (&it == frame_target_) power_sum_ += (uint32_t)c.r + c.g + c.b;
+}
+
+// Runs once the frame is drawn and before the display flushes it
+void LifeMatrix::finish_frame_() {
+  if (power_limit_enabled_) power_frame_();
+}
+
+void LifeMatrix::set_power_limit(int max_current_ma, float channel_current_ma, int idle_current_ma) {
+  power_max_ma_ = (float)max_current_ma;
+  power_channel_ma_ = channel_current_ma;
+  power_idle_ma_ = (float)idle_current_ma;
+  power_limit_enabled_ = true;
+  ESP_LOGD(TAG, "Power limit %d mA (%.2f mA/channel, %d mA idle)", max_current_ma, channel_current_ma, idle_current_ma);
+}
+
+void LifeMatrix::power_frame_() {
+  power_apply_();
+  uint32_t now = millis();
+  if (now - power_report_ms_ >= 10000) {
+    power_report_ms_ = now;
+    if (power_current_sensor_) power_current_sensor_->publish_state(get_estimated_current_ma());
+  }
+}
+
+float LifeMatrix::get_estimated_current_ma() const {
+  float lit = (float)power_sum_ / 255.0f;  // fully lit channel equivalents
+  return power_idle_ma_ + power_channel_ma_ * lit * (float)brightness_applied_ / 255.0f;
 }
 
+void LifeMatrix::power_apply_() {
+  if (!brightness_fn_) return;
+  int b = brightness_target_;
+  if (power_limit_enabled_ && power_sum_ > 0) {
+    float ma_per_step = power_channel_ma_ * (float)power_sum_ / (255.0f * 255.0f);
+    int limit = (int)((power_max_ma_ - power_idle_ma_) / ma_per_step);
+    if (limit < b) b = std::max(1, limit);
+  }
+  // Cut at once; after a cut, climb back 8 steps per frame so a strobing effect
+  // doesn't pump the brightness
+  if (power_limiting_ && b > brightness_applied_) b = std::min(b, brightness_applied_ + 8);
+  bool limiting = b < brightness_target_;
+  if (b != brightness_applied_) {
+    brightness_applied_ = (uint8_t)b;
+    brightness_fn_((uint8_t)b);
+  }
+  if (limiting != power_limiting_) {
+    power_limiting_ = limiting;
+    ESP_LOGD(TAG, "Power limit %s: brightness %d/%d, ~%.0f mA", limiting ? "engaged" : "released",
+             b, brightness_target_, get_estimated_current_ma());
+  }
+}
 
 // ============================================================================
-// ENTITY REGISTRATION
+// FRAME SNAPSHOT (PNG)
 // ============================================================================
-void LifeMatrix::add_screen_switch(int screen_id, switch_::Switch *sw) {
-  if (screen_id >= 0 && screen_id < 8) {
-    screen_switches_[screen_id] = sw;
-    sw->add_on_state_callback([this, screen_id](bool state) {
-      this->register_screen(screen_id, state);
-    });
+// The presented frame is encoded as an RGB PNG at SNAPSHOT_SCALE× nearest-neighbour, read
+// in logical order straight from the palette canvas through the resolved palette, text and
+// overlays included; the snapshot turns the canvas on, so no copy of the frame is kept.
+// Frames the canvas didn't hold whole (a transition, more than 255 colors, live input)
+// are skipped and the previous snapshot stays up. Deflate uses the fixed Huffman code and two
+// back-references that cost nothing to find: a pixel run repeats the previous 3 bytes
+// (distance 3), and an upscaled or unchanged row repeats the previous output row
+// (distance = row stride). Flat views encode to a few KB.
+// Encoding runs in loop(), only while the endpoint has been polled in the last
+// SNAPSHOT_IDLE_MS and at most once per interval; the web handler just hands out the
+// newest finished buffer of two.
+
+static const int SNAPSHOT_SCALE = 4;
+static const uint32_t SNAPSHOT_IDLE_MS = 30000;
+
+static const uint16_t DEFLATE_LEN_BASE[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                                              35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+static const uint8_t DEFLATE_LEN_EXTRA[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+                                              3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+static const uint16_t DEFLATE_DIST_BASE[30] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+                                               257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+                                               8193, 12289, 16385, 24577};
+
+// Fixed-Huffman deflate bit writer with a running Adler-32 of the uncompressed bytes
+struct DeflateWriter {
+  ColdVector<uint8_t> &out;
+  uint32_t bits{0};
+  int nbits{0};
+  uint32_t s1{1}, s2{0};
+  int pending{0};  // bytes since the last Adler modulo (deferred up to 5552)
+
+  explicit DeflateWriter(ColdVector<uint8_t> &o) : out(o) {}
+
+  void put(uint32_t v, int n) {  // LSB-first
+    bits |= v << nbits;
+    nbits += n;
+    while (nbits >= 8) {
+      out.push_back((uint8_t)bits);
+      bits >>= 8;
+      nbits -= 8;
+    }
+  }
+  void put_code(uint32_t code, int n) {  // Huffman codes are packed MSB-first
+    uint32_t r = 0;
+    for (int i = 0; i < n; i++) r |= ((code >> i) & 1u) << (n - 1 - i);
+    put(r, n);
+  }
+  void symbol(int v) {
+    if (v < 144) put_code(0x30 + v, 8);
+    else if (v < 256) put_code(0x190 + v - 144, 9);
+    else if (v < 280) put_code(v - 256, 7);
+    else put_code(0xC0 + v - 280, 8);
+  }
+  void adler(uint8_t b) {
+    s1 += b;
+    s2 += s1;
+    if (++pending == 5552) {
+      s1 %= 65521;
+      s2 %= 65521;
+      pending = 0;
+    }
+  }
+  void literal(uint8_t b) {
+    symbol(b);
+    adler(b);
+  }
+  void match(int len, int dist) {
+    int lc = 28;
+    while (DEFLATE_LEN_BASE[lc] > len) lc--;
+    symbol(257 + lc);
+    if (DEFLATE_LEN_EXTRA[lc]) put(len - DEFLATE_LEN_BASE[lc], DEFLATE_LEN_EXTRA[lc]);
+    int dc = 29;
+    while (DEFLATE_DIST_BASE[dc] > dist) dc--;
+    put_code(dc, 5);
+    int extra = dc < 4 ? 0 : (dc - 2) / 2;
+    if (extra) put(dist - DEFLATE_DIST_BASE[dc], extra);
+  }
+  // len ≥ 3 bytes copied from dist back; the caller feeds the copied bytes to adler()
+  void repeat(int len, int dist) {
+    while (len > 0) {
+      int chunk = std::min(len, 258);
+      if (len - chunk > 0 && len - chunk < 3) chunk = len - 3;
+      match(chunk, dist);
+      len -= chunk;
+    }
+  }
+  void finish() {
+    symbol(256);
+    if (nbits > 0) out.push_back((uint8_t)bits);
+    bits = 0;
+    nbits = 0;
+  }
+  uint32_t adler32() const { return ((s2 % 65521) << 16) | (s1 % 65521); }
+};
+
+static uint32_t png_crc(const uint8_t *data, size_t len) {
+  static const uint32_t NIBBLE[16] = {
+      0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+      0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C};
+  uint32_t crc = 0xFFFFFFFFu;
+  for (size_t i = 0; i < len; i++) {
+    crc ^= data[i];
+    crc = (crc >> 4) ^ NIBBLE[crc & 0x0F];
+    crc = (crc >> 4) ^ NIBBLE[crc & 0x0F];
   }
+  return ~crc;
+}
+
+static void put_be32(ColdVector<uint8_t> &out, uint32_t v) {
+  out.push_back((uint8_t)(v >> 24));
+  out.push_back((uint8_t)(v >> 16));
+  out.push_back((uint8_t)(v >> 8));
+  out.push_back((uint8_t)v);
 }
 
-void LifeMatrix::set_ha_style(select::Select *s) {
-  ha_style_ = s;
-  s->add_on_state_callback([this, s](size_t index) { this->set_style(s->current_option().str()); });
+// Chunk whose type + data already sit at out[start + 4 ..]: patch length, append CRC
+static void png_close_chunk(ColdVector<uint8_t> &out, size_t start) {
+  uint32_t len = (uint32_t)(out.size() - start - 8);
+  for (int i = 0; i < 4; i++) out[start + i] = (uint8_t)(len >> (24 - 8 * i));
+  put_be32(out, png_crc(&out[start + 4], len + 4));
 }
 
-void LifeMatrix::set_ha_text_area_position(select::Select *s) {
-  ha_text_area_position_ = s;
-  s->add_on_state_callback([this, s](size_t index) { this->set_text_area_position(s->current_option().str()); });
+static size_t png_open_chunk(ColdVector<uint8_t> &out, const char *type) {
+  size_t start = out.size();
+  out.resize(start + 4);
+  out.insert(out.end(), type, type + 4);
+  return start;
 }
 
-void LifeMatrix::set_ha_fill_direction(select::Select *s) {
-  ha_fill_direction_ = s;
-  s->add_on_state_callback([this, s](size_t index) { this->set_fill_direction(s->current_option().str()); });
+void LifeMatrix::set_snapshot_interval(uint32_t interval_ms) {
+  snapshot_interval_ms_ = interval_ms;
+  snapshot_enabled_ = true;
 }
 
-void LifeMatrix::set_ha_gradient_type(select::Select *s) {
-  ha_gradient_type_ = s;
-  s->add_on_state_callback([this, s](size_t index) { this->set_gradient_type(s->current_option().str()); });
+bool LifeMatrix::encode_snapshot_png(ColdVector<uint8_t> &out) const {
+  const int lw = canvas_lw_, lh = canvas_lh_;
+  if (lw <= 0 || !palette_frame_whole_ || palette_index_buf_.size() != (size_t)lw * (size_t)lh)
+    return false;  // no whole frame in the canvas
+  const int width = lw * SNAPSHOT_SCALE;
+  const int height = lh * SNAPSHOT_SCALE;
+  const int stride = 1 + width * 3;
+  static const uint8_t SIGNATURE[8] = {137, 80, 78, 71, 13, 10, 26, 10};
+
+  out.clear();
+  out.insert(out.end(), SIGNATURE, SIGNATURE + 8);
+  size_t chunk = png_open_chunk(out, "IHDR");
+  put_be32(out, width);
+  put_be32(out, height);
+  const uint8_t ihdr_tail[5] = {8, 2, 0, 0, 0};  // 8-bit RGB, deflate, no filter/interlace
+  out.insert(out.end(), ihdr_tail, ihdr_tail + 5);
+  png_close_chunk(out, chunk);
+
+  chunk = png_open_chunk(out, "IDAT");
+  out.push_back(0x78);  // zlib: deflate, 32 KB window
+  out.push_back(0x01);
+  DeflateWriter z(out);
+  z.put(1, 1);  // BFINAL
+  z.put(1, 2);  // fixed Huffman
+
+  std::vector<uint32_t> row(lw), prev(lw);  // 0xRRGGBB
+  for (int y = 0; y < lh; y++) {
+    for (int x = 0; x < lw; x++) row[x] = palette_[palette_index_buf_[canvas_origin_ + x * canvas_step_x_ + y * canvas_step_y_]];
+    int copies = SNAPSHOT_SCALE;  // output rows left to emit for this source row
+    if (y == 0 || row != prev) {
+      z.literal(0);  // filter type: none
+      for (int x = 0; x < lw;) {
+        int n = 1;
+        while (x + n < lw && row[x + n] == row[x]) n++;
+        Color c((uint8_t)(row[x] >> 16), (uint8_t)(row[x] >> 8), (uint8_t)row[x]);
+        z.literal(c.r);
+        z.literal(c.g);
+        z.literal(c.b);
+        z.repeat(3 * SNAPSHOT_SCALE * n - 3, 3);
+        for (int i = 1; i < SNAPSHOT_SCALE * n; i++) {
+          z.adler(c.r);
+          z.adler(c.g);
+          z.adler(c.b);
+        }
+        x += n;
+      }
+      prev = row;
+      copies--;
+    }
+    z.repeat(copies * stride, stride);
+    for (int k = 0; k < copies; k++) {
+      z.adler(0);
+      for (int x = 0; x < lw; x++) {
+        Color c((uint8_t)(row[x] >> 16), (uint8_t)(row[x] >> 8), (uint8_t)row[x]);
+        for (int s = 0; s < SNAPSHOT_SCALE; s++) {
+          z.adler(c.r);
+          z.adler(c.g);
+          z.adler(c.b);
+        }
+      }
+    }
+  }
+  z.finish();
+  put_be32(out, z.adler32());
+  png_close_chunk(out, chunk);
+
+  png_close_chunk(out, png_open_chunk(out, "IEND"));
+  return true;
 }
 
-void LifeMatrix::set_ha_marker_style(select::Select *s) {
-  ha_marker_style_ = s;
-  s->add_on_state_callback([this, s](size_t index) { this->set_marker_style(s->current_option().str()); });
+void LifeMatrix::update_snapshot_() {
+  uint32_t now = millis();
+  uint32_t requested = snapshot_requested_ms_.load();
+  if (requested == 0 || now - requested > SNAPSHOT_IDLE_MS) return;  // nobody is looking
+  int front = snapshot_front_.load();
+  if (front >= 0 && now - snapshot_encoded_ms_ < snapshot_interval_ms_) return;
+  // A request copying the front slot may have loaded it before the last flip, and the back
+  // slot is that old front: wait for it to finish
+  if (snapshot_readers_.load() > 0) return;
+  int back = (front == 0) ? 1 : 0;
+  uint32_t start_us = micros();
+  if (!encode_snapshot_png(snapshot_png_[back])) return;
+  snapshot_front_.store(back);
+  snapshot_encoded_ms_ = now;
+  ESP_LOGD(TAG, "Snapshot: %u bytes in %u us", (unsigned)snapshot_png_[back].size(), (unsigned)(micros() - start_us));
+}
+
+#ifdef USE_LIFE_MATRIX_SNAPSHOT
+class SnapshotHandler : public AsyncWebHandler {
+ public:
+  explicit SnapshotHandler(LifeMatrix *parent) : parent_(parent) {}
+  bool canHandle(AsyncWebServerRequest *request) const override {
+    return request->method() == HTTP_GET && request->url() == "/snapshot.png";
+  }
+  void handleRequest(AsyncWebServerRequest *request) override { parent_->serve_snapshot(request); }
+
+ protected:
+  LifeMatrix *parent_;
+};
+
+void LifeMatrix::set_snapshot_web_server(web_server_base::WebServerBase *base) {
+  base->add_handler(new SnapshotHandler(this));  // NOLINT(cppcoreguidelines-owning-memory)
 }
 
-void LifeMatrix::set_ha_marker_color(select::Select *s) {
-  ha_marker_color_ = s;
-  s->add_on_state_callback([this, s](size_t index) { this->set_marker_color(s->current_option().str()); });
+// Runs on the web server's task: only touches the atomics and a finished buffer. The
+// response gets its own copy, since the backend may still be sending it after loop()
+// has moved on and re-encoded this slot.
+void LifeMatrix::serve_snapshot(AsyncWebServerRequest *request) {
+  snapshot_requested_ms_.store(millis());
+  snapshot_readers_.fetch_add(1);  // before loading front, so loop() sees the reader first
+  int front = snapshot_front_.load();
+  if (front < 0) {
+    snapshot_readers_.fetch_sub(1);
+    request->send(503, "text/plain", "Snapshot not ready, retry in a moment");
+    return;
+  }
+  const ColdVector<uint8_t> &png = snapshot_png_[front];
+  AsyncResponseStream *response = request->beginResponseStream("image/png");
+#ifdef USE_ESP_IDF
+  response->print(std::string(reinterpret_cast<const char *>(png.data()), png.size()));
+#else
+  response->write(png.data(), png.size());
+#endif
+  snapshot_readers_.fetch_sub(1);
+  response->addHeader("Cache-Control", "no-store");
+  request->send(response);
 }
+#endif
+
+// ============================================================================
+// LIVE PIXEL INPUT (DDP / E1.31)
+// ============================================================================
+// Payloads are blitted with Display::draw_pixels_at() straight out of the receive
+// buffer, so there is no frame copy and no per-pixel draw_pixel(). The stream maps
+// row-major onto the full display. While live, the display poller is stopped and
+// auto-clear is off, so undrawn pixels keep their contents and the panel only updates
+// on a push: the DDP push flag, or the E1.31 universe that carries the last pixel.
+// Latency runs from the frame's first packet leaving the socket to the end of that
+// update(). Loss comes from DDP's 4-bit or E1.31's per-universe 8-bit sequence numbers.
+
+static inline uint32_t read_be32(const uint8_t *p) {
+  return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static inline uint16_t read_be16(const uint8_t *p) { return (uint16_t)((p[0] << 8) | p[1]); }
+
+void LifeMatrix::set_live_input(int protocol, uint16_t port, uint32_t timeout_ms, uint16_t start_universe) {
+  live_protocol_ = (LiveProtocol)protocol;
+  live_port_ = port;
+  live_timeout_ms_ = timeout_ms;
+  live_universe_ = start_universe;
+  live_packet_buf_.resize(LIVE_PACKET_SIZE);
+}
+
+void LifeMatrix::poll_live_() {
+#ifdef USE_LIFE_MATRIX_LIVE
+  if (!live_socket_) {
+    // lwIP is not up until the network component has started; retry until it is
+    if (!network::is_connected() || (live_open_ms_ != 0 && millis() - live_open_ms_ < 5000)) return;
+    live_open_ms_ = millis();
+    auto sock = socket::socket_ip(SOCK_DGRAM, IPPROTO_UDP);
+    if (!sock) return;
+    struct sockaddr_storage addr;
+    socklen_t sl = socket::set_sockaddr_any((struct sockaddr *) &addr, sizeof(addr), live_port_);
+    if (sock->bind((struct sockaddr *) &addr, sl) != 0) {
+      ESP_LOGW(TAG, "Live input: bind to UDP %u failed", live_port_);
+      return;
+    }
+    sock->setblocking(false);
+    live_socket_ = std::move(sock);
+    ESP_LOGI(TAG, "Live input listening on UDP %u (%s)", live_port_, live_protocol_ == LIVE_DDP ? "DDP" : "E1.31");
+  }
+
+  // Bounded drain so a flood can't starve the rest of loop()
+  for (int i = 0; i < 32; i++) {
+    ssize_t len = live_socket_->read(live_packet_buf_.data(), live_packet_buf_.size());
+    if (len <= 0) break;
+    if (sleeping_ || display_ == nullptr) continue;  // sleep wins; the stream is discarded
+    live_packet_(live_packet_buf_.data(), (int)len, micros());
+  }
+#endif
 
-void LifeMatrix::set_ha_day_fill(select::Select *s) {
-  ha_day_fill_ = s;
-  s->add_on_state_callback([this, s](size_t index) { this->set_day_fill(s->current_option().str()); });
+  uint32_t now = millis();
+  if (live_active_ && now - live_last_packet_ms_ >= live_timeout_ms_) exit_live_();
+
+  if (live_frames_ > 0 && now - live_window_ms_ >= 10000) {
+    float avg_ms = (float)live_latency_sum_us_ / (float)live_frames_ / 1000.0f;
+    float max_ms = (float)live_latency_max_us_ / 1000.0f;
+    ESP_LOGD(TAG, "Live: %u frames, %u dropped (%u packets lost), latency avg %.1f ms, max %.1f ms",
+             live_frames_, live_frames_dropped_, live_packets_lost_, avg_ms, max_ms);
+    if (live_latency_sensor_) live_latency_sensor_->publish_state(max_ms);
+    if (live_dropped_sensor_) live_dropped_sensor_->publish_state((float)live_frames_dropped_);
+    live_frames_ = 0;
+    live_frames_dropped_ = 0;
+    live_packets_lost_ = 0;
+    live_latency_sum_us_ = 0;
+    live_latency_max_us_ = 0;
+    live_window_ms_ = now;
+  } else if (live_frames_ == 0) {
+    live_window_ms_ = now;
+  }
+}
+
+void LifeMatrix::live_packet_(const uint8_t *pkt, int len, uint32_t recv_us) {
+  bool push = false;
+  uint32_t pixel_offset;
+  uint32_t pixels;
+  const uint8_t *rgb;
+
+  if (live_protocol_ == LIVE_DDP) {
+    // flags: VV.T SRQP — version 1; storage, reply and query packets carry no pixels
+    if (len < 10 || (pkt[0] & 0xC0) != 0x40 || (pkt[0] & 0x0E) != 0) return;
+    // data type: C R TTT SSS — only RGB at 8 bits per channel (0x0B), or 0 as most senders use
+    if (pkt[2] != 0x00 && pkt[2] != 0x0B) return;
+    if (pkt[3] != 1 && pkt[3] != 255) return;  // id 1 = display, 255 = all
+    int header = (pkt[0] & 0x10) ? 14 : 10;  // optional timecode
+    uint16_t data_len = read_be16(pkt + 8);
+    if (header + data_len > len) return;
+    uint8_t seq = pkt[1] & 0x0F;  // 1..15, 0 = unsequenced
+    if (seq != 0) {
+      if (live_ddp_seq_ != 0) {
+        int gap = (seq - (live_ddp_seq_ % 15 + 1) + 15) % 15;
+        if (gap) {
+          live_packets_lost_ += gap;
+          live_frame_lossy_ = true;
+        }
+      }
+      live_ddp_seq_ = seq;
+    }
+    pixel_offset = read_be32(pkt + 4) / 3;
+    pixels = data_len / 3;
+    rgb = pkt + header;
+    push = (pkt[0] & 0x01) != 0;
+  } else {
+    // Root layer ACN id + data vectors, then a DMP block of dimmer slots (start code 0)
+    static const uint8_t ACN_ID[12] = {'A', 'S', 'C', '-', 'E', '1', '.', '1', '7', 0, 0, 0};
+    if (len < 126 || memcmp(pkt + 4, ACN_ID, sizeof(ACN_ID)) != 0) return;
+    if (pkt[21] != 0x04 || pkt[43] != 0x02 || pkt[117] != 0x02 || pkt[125] != 0) return;
+    int u = (int)read_be16(pkt + 113) - (int)live_universe_;
+    if (u < 0 || u >= LIVE_E131_MAX_UNIVERSES) return;
+    if (pkt[112] & 0x40) {  // stream terminated
+      if (live_active_) exit_live_();
+      return;
+    }
+    int slots = (int)read_be16(pkt + 123) - 1;  // minus the start code
+    if (slots <= 0 || 126 + slots > len) return;
+    uint8_t seq = pkt[111];
+    if (live_e131_seen_ & (1ULL << u)) {
+      int gap = (int8_t)(seq - (uint8_t)(live_e131_seq_[u] + 1));
+      if (gap > 0) {
+        live_packets_lost_ += gap;
+        live_frame_lossy_ = true;
+      } else if (gap < 0 && gap >= -20) {
+        return;  // late duplicate (E1.31 §6.7.2)
+      }
+    }
+    live_e131_seq_[u] = seq;
+    live_e131_seen_ |= 1ULL << u;
+    pixel_offset = (uint32_t)u * LIVE_E131_PIXELS;
+    pixels = std::min(slots / 3, LIVE_E131_PIXELS);
+    rgb = pkt + 126;
+    uint32_t panel_pixels = (uint32_t)(display_->get_width() * display_->get_height());
+    push = (pixel_offset + LIVE_E131_PIXELS >= panel_pixels);
+  }
+
+  if (!live_active_) enter_live_();
+  live_last_packet_ms_ = millis();
+  if (live_frame_start_us_ == 0) live_frame_start_us_ = recv_us;
+  live_blit_(pixel_offset, rgb, pixels);
+  if (push) live_present_();
+}
+
+void LifeMatrix::live_blit_(uint32_t pixel_offset, const uint8_t *rgb, uint32_t pixels) {
+  int w = display_->get_width();
+  uint32_t total = (uint32_t)(w * display_->get_height());
+  if (w <= 0 || pixel_offset >= total) return;
+  pixels = std::min(pixels, total - pixel_offset);
+  int x = (int)(pixel_offset % (uint32_t)w);
+  int y = (int)(pixel_offset / (uint32_t)w);
+  // The estimate covers the pixels sent for this frame, which is the whole frame for
+  // senders that push full frames
+  bool sum = power_limit_enabled_;
+  while (pixels > 0) {
+    // Whole rows in one call when aligned, otherwise the partial row up to the edge
+    int cols = (x == 0 && pixels >= (uint32_t)w) ? w : std::min((int)pixels, w - x);
+    int rows = (cols == w) ? (int)(pixels / (uint32_t)w) : 1;
+    display_->draw_pixels_at(x, y, cols, rows, rgb, display::COLOR_ORDER_RGB, display::COLOR_BITNESS_888, true);
+    if (sum) {
+      for (uint32_t i = 0; i < (uint32_t)(cols * rows) * 3; i++) power_sum_ += rgb[i];
+    }
+    uint32_t n = (uint32_t)(cols * rows);
+    rgb += n * 3;
+    pixels -= n;
+    x += cols;
+    if (x >= w) {
+      x = 0;
+      y += rows;
+    }
+  }
 }
 
-void LifeMatrix::set_ha_year_event_style(select::Select *s) {
-  ha_year_event_style_ = s;
-  s->add_on_state_callback([this, s](size_t index) { this->set_year_event_style(s->current_option().str()); });
+void LifeMatrix::live_present_() {
+  if (power_limit_enabled_) power_frame_();
+  power_sum_ = 0;
+  display_->update();
+  uint32_t latency = micros() - live_frame_start_us_;
+  live_latency_sum_us_ += latency;
+  if (latency > live_latency_max_us_) live_latency_max_us_ = latency;
+  live_frames_++;
+  if (live_frame_lossy_) live_frames_dropped_++;
+  live_frame_start_us_ = 0;
+  live_frame_lossy_ = false;
+}
+
+void LifeMatrix::enter_live_() {
+  ESP_LOGI(TAG, "Live input: stream started");
+  live_active_ = true;
+  transition_active_ = false;
+  celebration_active_ = false;
+  live_ddp_seq_ = 0;
+  live_e131_seen_ = 0;
+  live_frame_start_us_ = 0;
+  live_frame_lossy_ = false;
+  palette_frame_whole_ = false;  // the canvas no longer shows what the panel does
+  power_sum_ = 0;
+  display_->stop_poller();
+  display_->set_auto_clear(false);
+  display_->fill(Color(0, 0, 0));  // pixels the sender never covers stay dark
+}
+
+void LifeMatrix::exit_live_() {
+  ESP_LOGI(TAG, "Live input: stream ended, resuming screens");
+  live_active_ = false;
+  display_->set_auto_clear(true);
+  if (!sleeping_) display_->start_poller();
+  redraw_requested_ = true;
+}
+
+#ifdef USE_LIFE_MATRIX_SOAK
+// ============================================================================
+// SOAK MODE
+// ============================================================================
+// A scripted user that never stops. Each step moves the display clock 37 minutes on
+// (through the time override, as the HA text would), shows the next screen and nudges
+// one setting through its entity. Every few steps it also advances pomodoro (logging a
+// snack so sessions get recorded), toggles a screen off and back on so its state is freed
+// and reallocated, fires a celebration and rewrites the config text. Persistent writes are
+// refused in this build (lm_nvs_open), so a unit can soak for weeks without flash wear.
+
+void LifeMatrix::soak_step_() {
+  uint32_t n = soak_steps_++;
+  if (n == 0) {
+    // Every built screen takes part, whatever its switch was restored to
+    for (auto &screen : screens_) {
+      if (!screen.enabled) soak_set_screen_(screen.id, true);
+    }
+    ESPTime now = time_ != nullptr ? time_->now() : ESPTime{};
+    soak_year_ = now.is_valid() ? now.year : 2026;
+    soak_month_ = now.is_valid() ? now.month : 1;
+    soak_day_ = now.is_valid() ? now.day_of_month : 1;
+    ESP_LOGI(TAG, "Soak: step %u ms, report every %u ms", (unsigned)soak_step_ms_, (unsigned)soak_report_ms_);
+  }
+
+  soak_advance_clock_();
+  next_screen();
+
+  // One setting per step, walked through its range; the cycle time and sleep stay put
+  SettingID id = (SettingID)(n % SET_COUNT);
+  if (id != SET_CYCLE_TIME && id != SET_SLEEP_SCHEDULE && id != SET_SLEEP_NOW) {
+    const SettingDesc &d = SETTING_TABLE[id];
+    int v = get_setting(id) + d.step;
+    apply_setting(id, v > d.max_value ? d.min_value : v);
+  }
+
+#ifndef LIFE_MATRIX_NO_POMODORO
+  if (n % 3 == 0) {
+    if (n % 48 == 0) {
+      reset_pomodoro();
+    } else {
+      skip_pomodoro_phase();
+      if (pomo_phase_ == POMO_WORK) log_exercise_snack();
+    }
+  }
+#endif
+
+  // The previously disabled screen comes back before the next one goes
+  if (n % 8 == 7 && screens_.size() > 1) {
+    if (soak_disabled_screen_ >= 0) soak_set_screen_(soak_disabled_screen_, true);
+    soak_disabled_screen_ = screens_[(n / 8) % screens_.size()].id;
+    soak_set_screen_(soak_disabled_screen_, false);
+  }
+
+  if (n % 32 == 13) start_celebration_();
+
+  // Config text alternates between two shapes, so every parser shrinks and grows its tables
+  if (n % 16 == 5) {
+    bool alt = (n / 16) % 2 == 1;
+    set_year_events(alt ? "01-01,03-14,07-04,10-31,12-24" : "02-14,06-21");
+    set_lifespan_milestones(alt ? "2012-06-15:Graduated,2016-09-01:New job" : "2020-03-01:Moved");
+    set_lifespan_custom_phases(alt ? "19-23:Band,2016-09-01/2019-06-30:Berlin:FF6600" : "40-:Later");
+#ifndef LIFE_MATRIX_NO_POMODORO
+    set_exercise_list_csv(alt ? "Squats,Pushups,Plank" : "Lunges,Burpees");
+#endif
+#ifndef LIFE_MATRIX_NO_HABITS
+    set_habit_list_csv(alt ? "Exercise,Read,Meditate" : "Read,Water");
+#endif
+  }
+}
+
+void LifeMatrix::soak_advance_clock_() {
+  soak_minutes_ += SOAK_MINUTES_PER_STEP;
+  if (soak_minutes_ >= 24 * 60) {
+    soak_minutes_ -= 24 * 60;
+    uint8_t days[12];
+    get_days_in_month(soak_year_, days);
+    if (++soak_day_ > days[soak_month_ - 1]) {
+      soak_day_ = 1;
+      if (++soak_month_ > 12) {
+        soak_month_ = 1;
+        if (++soak_year_ > 2099) soak_year_ = 2000;  // range accepted by the override
+      }
+    }
+  }
+  char buf[24];
+  snprintf(buf, sizeof(buf), "%04d-%02d-%02d %02d:%02d:00", soak_year_, soak_month_, soak_day_,
+           soak_minutes_ / 60, soak_minutes_ % 60);
+  set_time_override(buf);
 }
 
-void LifeMatrix::set_ha_conway_speed(select::Select *s) {
-  ha_conway_speed_ = s;
-  s->add_on_state_callback([this, s](size_t index) { this->set_game_update_interval(s->current_option().str()); });
+// Through the screen's switch when it has one, like a toggle from HA
+void LifeMatrix::soak_set_screen_(int screen_id, bool enabled) {
+  switch_::Switch *sw = (screen_id >= 0 && screen_id < SCREEN_COUNT) ? screen_switches_[screen_id] : nullptr;
+  if (sw == nullptr) {
+    register_screen(screen_id, enabled);
+  } else if (enabled) {
+    sw->turn_on();
+  } else {
+    sw->turn_off();
+  }
 }
 
-void LifeMatrix::set_ha_pomo_preset(select::Select *s) {
-  ha_pomo_preset_ = s;
-  s->add_on_state_callback([this, s](size_t index) { this->set_pomo_preset(s->current_option().str()); });
+// One line per window with fixed fields, so logs from days apart line up. Heap deltas are
+// against the first window, p99s cover this window only, and drift is millis() minus the
+// wall clock since it first became valid (SNTP keeps the latter honest).
+void LifeMatrix::soak_report_() {
+  const uint32_t caps = MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT;
+  size_t free_b = heap_caps_get_free_size(caps);
+  size_t largest = heap_caps_get_largest_free_block(caps);
+  uint32_t now_ms = millis();
+  if (soak_reports_++ == 0) {
+    soak_base_free_ = free_b;
+    soak_base_largest_ = largest;
+  }
+
+  int32_t drift_ms = 0;
+  ESPTime wall = time_ != nullptr ? time_->now() : ESPTime{};
+  if (wall.is_valid()) {
+    if (soak_wall_start_s_ == 0) {
+      soak_wall_start_s_ = (uint32_t)wall.timestamp;
+      soak_wall_start_ms_ = now_ms;
+    }
+    uint32_t wall_ms = ((uint32_t)wall.timestamp - soak_wall_start_s_) * 1000u;
+    drift_ms = (int32_t)((now_ms - soak_wall_start_ms_) - wall_ms);
+  }
+
+  ESP_LOGI(TAG,
+           "Soak #%u: up %u s, %llu frames, %u steps | heap %u B (%+d), largest %u B (%+d), low-water %u B"
+           " | loop p99 %u us (max %u) | render p99 %u us (max %u) | drift %+d ms",
+           (unsigned)soak_reports_, (unsigned)(now_ms / 1000), (unsigned long long)soak_frames_,
+           (unsigned)soak_steps_, (unsigned)free_b, (int)free_b - (int)soak_base_free_, (unsigned)largest,
+           (int)largest - (int)soak_base_largest_, (unsigned)heap_caps_get_minimum_free_size(caps),
+           (unsigned)soak_loop_hist_.percentile(0.99f), (unsigned)soak_loop_hist_.max_us,
+           (unsigned)soak_render_hist_.percentile(0.99f), (unsigned)soak_render_hist_.max_us, (int)drift_ms);
+  soak_loop_hist_.reset();
+  soak_render_hist_.reset();
 }
+#endif
+
+// ============================================================================
+// DISPLAY SLEEP
+// ============================================================================
 
-void LifeMatrix::set_ha_show_future(switch_::Switch *sw) {
-  ha_show_future_ = sw;
-  sw->add_on_state_callback([this](bool state) { this->set_show_future(state); });
+bool LifeMatrix::in_sleep_window_(const ESPTime &t) const {
+  int bed = time_segments_.bed_time_hour, wake = time_segments_.wake_time_hour;
+  if (bed == wake) return false;
+  return (bed < wake) ? (t.hour >= bed && t.hour < wake) : (t.hour >= bed || t.hour < wake);
 }
 
-void LifeMatrix::set_ha_complex_patterns(switch_::Switch *sw) {
-  ha_complex_patterns_ = sw;
-  sw->add_on_state_callback([this](bool state) { this->set_complex_patterns(state); });
+// Called first in loop(); returns true while asleep so loop() does nothing else.
+// The sleep decision is re-evaluated once per second; input wakes immediately.
+bool LifeMatrix::update_sleep_() {
+  uint32_t now = millis();
+  if (sleep_wake_requested_) {
+    sleep_wake_requested_ = false;
+    // Someone is at the panel: a manual sleep ends for good, a scheduled one is held off
+    if (sleep_now_) apply_setting(SET_SLEEP_NOW, 0);
+    exit_sleep_();
+    sleep_checked_ms_ = now;
+    return false;
+  }
+  if (sleep_checked_ms_ != 0 && now - sleep_checked_ms_ < 1000) return sleeping_;
+  sleep_checked_ms_ = now;
+
+  if (!sleeping_ && now - busy_window_ms_ >= BUSY_WINDOW_MS) {
+    float rate = (float)busy_us_ * 1000.0f / (float)(now - busy_window_ms_);
+    awake_busy_us_per_s_ = (awake_busy_us_per_s_ == 0.0f) ? rate : awake_busy_us_per_s_ * 0.75f + rate * 0.25f;
+    busy_us_ = 0;
+    busy_window_ms_ = now;
+  }
+
+  bool want = sleep_now_;
+  if (!want && sleep_schedule_ && now - sleep_last_input_ms_ >= SLEEP_INPUT_HOLD_MS) {
+    ESPTime t = get_display_time();
+    want = t.is_valid() && in_sleep_window_(t);
+  }
+#ifndef LIFE_MATRIX_NO_POMODORO
+  // A running pomodoro means someone is working; sleep waits for the session to end
+  if (want && pomo_phase_ != POMO_IDLE && pomo_phase_ != POMO_COMPLETE) want = false;
+#endif
+
+  if (want && !sleeping_) enter_sleep_();
+  else if (!want && sleeping_) exit_sleep_();
+  return sleeping_;
 }
 
-void LifeMatrix::set_ha_exercise_snacks(switch_::Switch *sw) {
-  ha_exercise_snacks_ = sw;
-  sw->add_on_state_callback([this](bool state) { this->set_exercise_snacks_enabled(state); });
+void LifeMatrix::enter_sleep_() {
+  uint32_t now = millis();
+  ESP_LOGI(TAG, "Display sleep (%s), awake cost %.0f us/s", sleep_now_ ? "manual" : "schedule", awake_busy_us_per_s_);
+  celebration_active_ = false;
+  if (live_active_) exit_live_();
+  if (game_is_stable_ && game_stable_since_ > 0)
+    game_stable_paused_elapsed_ = now - game_stable_since_;
+  sleeping_ = true;
+  apply_brightness();
+  if (display_ != nullptr) {
+    display_->update();  // render() is a no-op now: pushes a blank frame
+    display_->stop_poller();
+  }
+  redraw_requested_ = false;
+  input_pending_ = false;
+  busy_us_ = 0;
+  sleep_start_ms_ = now;
 }
 
-void LifeMatrix::set_ha_display_brightness(number::Number *n) {
-  ha_display_brightness_ = n;
-  n->add_on_state_callback([this](float val) { this->set_base_brightness_pct(val); });
+void LifeMatrix::exit_sleep_() {
+  if (!sleeping_) return;
+  uint32_t now = millis();
+  sleeping_ = false;
+  if (game_is_stable_ && game_stable_paused_elapsed_ > 0)
+    game_stable_since_ = now - game_stable_paused_elapsed_;
+  // GoL's logical clock stops for the night, hidden or not
+  if (!gol_was_visible_) gol_hidden_ms_ += now - sleep_start_ms_;
+  apply_brightness();
+  if (display_ != nullptr) display_->start_poller();
+  redraw_requested_ = true;
+
+  // Saved = what the awake loop + render would have spent over the slept span, minus
+  // what the sleeping loop actually spent. The display's own flush is not counted, so
+  // this is a lower bound.
+  float slept_s = (float)(now - sleep_start_ms_) / 1000.0f;
+  float saved_s = (awake_busy_us_per_s_ * slept_s - (float)busy_us_) / 1e6f;
+  if (saved_s < 0.0f) saved_s = 0.0f;
+  ESP_LOGI(TAG, "Display wake after %.0f min: %.1f s CPU saved (%.0f us spent asleep)",
+           slept_s / 60.0f, saved_s, (float)busy_us_);
+  if (sleep_cpu_saved_sensor_) sleep_cpu_saved_sensor_->publish_state(saved_s);
+  busy_us_ = 0;
+  busy_window_ms_ = now;
 }
 
-void LifeMatrix::set_ha_night_mode_level(number::Number *n) {
-  ha_night_mode_level_ = n;
-  n->add_on_state_callback([this](float val) { this->set_night_mode_level((int)val); });
+
+// ============================================================================
+// ENTITY REGISTRATION
+// ============================================================================
+void LifeMatrix::add_screen_switch(int screen_id, switch_::Switch *sw) {
+  if (screen_id >= 0 && screen_id < SCREEN_COUNT) {
+    screen_switches_[screen_id] = sw;
+    sw->add_on_state_callback([this, screen_id](bool state) {
+      this->register_screen(screen_id, state);
+    });
+  }
 }
 
-void LifeMatrix::set_ha_cycle_time(number::Number *n) {
-  ha_cycle_time_ = n;
-  n->add_on_state_callback([this](float val) { this->set_screen_cycle_time(val); });
+// HA entities bound to a settings row: state changes run the row's setter by
+// option index, and the boot restore walks the same rows
+static uint32_t setting_object_hash(const char *object_id) {
+  uint32_t hash = 2166136261UL;
+  for (const char *c = object_id; *c; c++) hash = (hash * 16777619UL) ^ (uint8_t)*c;
+  return hash;
 }
 
-void LifeMatrix::set_ha_bed_time_hour(number::Number *n) {
-  ha_bed_time_hour_ = n;
-  n->add_on_state_callback([this](float val) { this->set_bed_time_hour((int)val); });
+bool LifeMatrix::bind_setting_entity_(SettingID id, EntityBase *e, SettingKind kind) {
+  if (id >= SET_COUNT || SETTING_TABLE[id].kind != kind) {
+    ESP_LOGE(TAG, "Setting %d bound to an entity of the wrong kind", (int)id);
+    return false;
+  }
+  if (e->get_object_id_hash() != setting_object_hash(SETTING_TABLE[id].object_id))
+    ESP_LOGW(TAG, "Setting %s: entity object id differs from '%s'", SETTING_TABLE[id].label, SETTING_TABLE[id].object_id);
+  setting_entities_[id] = e;
+  return true;
 }
 
-void LifeMatrix::set_ha_work_start_hour(number::Number *n) {
-  ha_work_start_hour_ = n;
-  n->add_on_state_callback([this](float val) { this->set_work_start_hour((int)val); });
+void LifeMatrix::bind_setting(SettingID id, select::Select *s) {
+  if (!bind_setting_entity_(id, s, SETTING_SELECT)) return;
+  static_cast<LMSelect *>(s)->set_nvs_key(SETTING_TABLE[id].nvs_key);
+  const SettingDesc &d = SETTING_TABLE[id];
+  const auto &opts = s->traits.get_options();
+  bool match = (opts.size() == (size_t)d.max_value + 1);
+  for (size_t i = 0; match && i < opts.size(); i++) match = (strcmp(opts[i], d.options[i]) == 0);
+  if (!match) ESP_LOGW(TAG, "Setting %s: HA options differ from the settings table", d.label);
+  s->add_on_state_callback([this, id](size_t index) {
+    if (index <= (size_t)SETTING_TABLE[id].max_value) SETTING_ACCESS[id].set(*this, (int)index);
+  });
 }
 
-void LifeMatrix::set_ha_work_end_hour(number::Number *n) {
-  ha_work_end_hour_ = n;
-  n->add_on_state_callback([this](float val) { this->set_work_end_hour((int)val); });
+void LifeMatrix::bind_setting(SettingID id, number::Number *n) {
+  if (!bind_setting_entity_(id, n, SETTING_NUMBER)) return;
+  static_cast<LMNumber *>(n)->set_nvs_key(SETTING_TABLE[id].nvs_key);
+  n->add_on_state_callback([this, id](float val) {
+    if (!std::isnan(val)) SETTING_ACCESS[id].set(*this, (int)lroundf(val));
+  });
 }
 
-void LifeMatrix::set_ha_pomo_rounds(number::Number *n) {
-  ha_pomo_rounds_ = n;
-  n->add_on_state_callback([this](float val) { this->set_pomo_rounds((int)val); });
+void LifeMatrix::bind_setting(SettingID id, switch_::Switch *sw) {
+  if (!bind_setting_entity_(id, sw, SETTING_SWITCH)) return;
+  static_cast<LMSwitch *>(sw)->set_nvs_key(SETTING_TABLE[id].nvs_key);
+  sw->add_on_state_callback([this, id](bool state) { SETTING_ACCESS[id].set(*this, state ? 1 : 0); });
 }
 
 void LifeMatrix::set_ls_moved_out_entity(number::Number *n) {
@@ -4659,18 +7743,30 @@ void LifeMatrix::set_year_events_entity(text::Text *t) {
   t->add_on_state_callback([this](std::string val) { this->update_year_events(val); });
 }
 
+#ifndef LIFE_MATRIX_NO_POMODORO
 void LifeMatrix::set_exercise_list_entity(text::Text *t) {
   exercise_list_entity_ = t;
   t->add_on_state_callback([this](std::string val) { this->update_exercise_list_csv(val); });
 }
+#endif
 
 void LifeMatrix::set_time_override_entity(text::Text *t) {
   t->add_on_state_callback([this](std::string val) { this->set_time_override_from_str(val); });
 }
 
+#ifndef LIFE_MATRIX_NO_GOL
+void LifeMatrix::set_gol_rle_entity(text::Text *t) {
+  t->add_on_state_callback([this](std::string val) {
+    if (!val.empty()) this->load_rle(val.c_str());
+  });
+}
+#endif
+
+#ifndef LIFE_MATRIX_NO_POMODORO
 void LifeMatrix::set_pomo_test_phase_entity(text::Text *t) {
   t->add_on_state_callback([this](std::string val) { this->set_pomo_phase_override(val); });
 }
+#endif
 
 void LifeMatrix::set_ls_birthday_entity(text::Text *t) {
   ls_birthday_entity_ = t;
@@ -4707,9 +7803,16 @@ void LifeMatrix::set_ls_marriage_ranges_entity(text::Text *t) {
   t->add_on_state_callback([this](std::string v) { this->update_lifespan_marriage_ranges(v); });
 }
 
+void LifeMatrix::set_ls_custom_phases_entity(text::Text *t) {
+  ls_custom_phases_entity_ = t;
+  t->add_on_state_callback([this](std::string v) { this->update_lifespan_custom_phases(v); });
+}
+
+#ifndef LIFE_MATRIX_NO_POMODORO
 void LifeMatrix::set_ha_pomo_start_button(button::Button *b) {
   b->add_on_press_callback([this]() { this->start_pomodoro(); });
 }
+#endif
 
 // Helper to restore a text entity from NVS and return the value
 static bool restore_text_from_nvs_(text::Text *entity, const char *key, std::string &out_value) {
@@ -4811,6 +7914,12 @@ void LifeMatrix::restore_lifespan_entities_from_nvs_() {
     const auto &init = static_cast<LMText*>(ls_marriage_ranges_entity_)->get_initial_value();
     if (!init.empty()) ls_marriage_ranges_entity_->publish_state(init);
   }
+  if (restore_text_from_nvs_(ls_custom_phases_entity_, "ls_phases", val_str)) {
+    set_lifespan_custom_phases(val_str);
+  } else if (ls_custom_phases_entity_) {
+    const auto &init = static_cast<LMText*>(ls_custom_phases_entity_)->get_initial_value();
+    if (!init.empty()) ls_custom_phases_entity_->publish_state(init);
+  }
 
   // Number entities - restore from NVS if exists, then sync to internal config
   // If no NVS value, publish YAML initial so web interface shows it (triggers callback to save to NVS)
@@ -4848,7 +7957,7 @@ void LifeMatrix::restore_lifespan_entities_from_nvs_() {
   // Screen switches - use hash-based keys
   nvs_handle_t h;
   if (lm_nvs_open(h, NVS_READONLY) == ESP_OK) {
-    for (int i = 0; i < 8; i++) {
+    for (int i = 0; i < SCREEN_COUNT; i++) {
       if (screen_switches_[i]) {
         char key[12];
         lm_nvs_key(key, screen_switches_[i]->get_object_id_hash() ^ 0x5753U);
@@ -4863,14 +7972,12 @@ void LifeMatrix::restore_lifespan_entities_from_nvs_() {
         }
       }
     }
-    // Config switches: NVS restore with fallback to restore_mode default
-    switch_::Switch *cfg_sw[] = {ha_show_future_, ha_complex_patterns_, ha_exercise_snacks_};
-    for (auto *sw : cfg_sw) {
-      if (!sw) continue;
-      char key[12];
-      lm_nvs_key(key, sw->get_object_id_hash() ^ 0x5753U);
+    // Settings switches: NVS restore with fallback to restore_mode default
+    for (int i = 0; i < SET_COUNT; i++) {
+      if (SETTING_TABLE[i].kind != SETTING_SWITCH || !setting_entities_[i]) continue;
+      auto *sw = static_cast<switch_::Switch *>(setting_entities_[i]);
       uint8_t val;
-      if (nvs_get_u8(h, key, &val) == ESP_OK) {
+      if (nvs_get_u8(h, SETTING_TABLE[i].nvs_key, &val) == ESP_OK) {
         if (val) sw->turn_on(); else sw->turn_off();
       } else {
         static_cast<LMSwitch*>(sw)->publish_initial_state();
@@ -4886,6 +7993,7 @@ void LifeMatrix::restore_lifespan_entities_from_nvs_() {
     const auto &init = static_cast<LMText*>(year_events_entity_)->get_initial_value();
     if (!init.empty()) year_events_entity_->publish_state(init);
   }
+#ifndef LIFE_MATRIX_NO_POMODORO
   // exercise_list: NVS-saved value takes priority; fall back to YAML initial
   if (restore_text_from_nvs_(exercise_list_entity_, "exercise_list", val_str)) {
     set_exercise_list_csv(val_str);
@@ -4893,14 +8001,13 @@ void LifeMatrix::restore_lifespan_entities_from_nvs_() {
     const auto &init = static_cast<LMText*>(exercise_list_entity_)->get_initial_value();
     if (!init.empty()) exercise_list_entity_->publish_state(init);
   }
+#endif
 
-  // Restore HA number entities: NVS-saved value takes priority; fall back to YAML initial
-  auto pub_num = [](number::Number *n) {
+  // Restore settings number/select entities: NVS-saved value takes priority; fall back to YAML initial
+  auto pub_num = [](number::Number *n, const char *key) {
     if (!n) return;
     nvs_handle_t h;
     if (lm_nvs_open(h, NVS_READONLY) == ESP_OK) {
-      char key[12];
-      lm_nvs_key(key, n->get_object_id_hash() ^ 0x4E4DU);
       float val = NAN;
       size_t sz = sizeof(float);
       if (nvs_get_blob(h, key, &val, &sz) == ESP_OK && !std::isnan(val)) {
@@ -4913,22 +8020,13 @@ void LifeMatrix::restore_lifespan_entities_from_nvs_() {
     float init = static_cast<LMNumber*>(n)->get_initial_value();
     if (!std::isnan(init)) n->publish_state(init);
   };
-  pub_num(ha_bed_time_hour_);
-  pub_num(ha_work_start_hour_);
-  pub_num(ha_work_end_hour_);
-  pub_num(ha_cycle_time_);
-  pub_num(ha_display_brightness_);
-  pub_num(ha_night_mode_level_);
-  pub_num(ha_pomo_rounds_);
 
   // Restore HA select entities: NVS-saved index takes priority; fall back to YAML initial
-  auto pub_sel = [](select::Select *s) {
+  auto pub_sel = [](select::Select *s, const char *key) {
     if (!s) return;
     auto *lms = static_cast<LMSelect*>(s);
     nvs_handle_t h;
     if (lm_nvs_open(h, NVS_READONLY) == ESP_OK) {
-      char key[12];
-      lm_nvs_key(key, s->get_object_id_hash() ^ 0x4C53U);
       uint8_t idx = 255;
       if (nvs_get_u8(h, key, &idx) == ESP_OK) {
         const auto &opts = lms->traits.get_options();
@@ -4943,16 +8041,11 @@ void LifeMatrix::restore_lifespan_entities_from_nvs_() {
     const auto &init = lms->get_initial_option();
     if (!init.empty()) s->publish_state(init);
   };
-  pub_sel(ha_style_);
-  pub_sel(ha_gradient_type_);
-  pub_sel(ha_fill_direction_);
-  pub_sel(ha_marker_style_);
-  pub_sel(ha_marker_color_);
-  pub_sel(ha_text_area_position_);
-  pub_sel(ha_day_fill_);
-  pub_sel(ha_year_event_style_);
-  pub_sel(ha_conway_speed_);
-  pub_sel(ha_pomo_preset_);
+  for (int i = 0; i < SET_COUNT; i++) {
+    const SettingDesc &d = SETTING_TABLE[i];
+    if (d.kind == SETTING_NUMBER) pub_num(static_cast<number::Number *>(setting_entities_[i]), d.nvs_key);
+    if (d.kind == SETTING_SELECT) pub_sel(static_cast<select::Select *>(setting_entities_[i]), d.nvs_key);
+  }
 
   // Refresh lifespan data with any restored values
   apply_lifespan_year_events();
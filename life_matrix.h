@@ -14,13 +14,23 @@
 #include "esphome/components/text/text.h"
 #include "esphome/components/button/button.h"
 #include "nvs.h"
+#include "settings_table.h"
+#ifdef USE_LIFE_MATRIX_SNAPSHOT
+#include "esphome/components/web_server_base/web_server_base.h"
+#endif
+#ifdef USE_LIFE_MATRIX_LIVE
+#include "esphome/components/socket/socket.h"
+#include "esphome/components/network/util.h"
+#endif
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <functional>
+#include <memory>
 #include <vector>
 #include <string>
-#include <map>
 #include <cmath>
+#include <cstring>
 
 namespace esphome {
 namespace life_matrix {
@@ -34,12 +44,23 @@ namespace life_matrix {
 // Using a fixed namespace avoids collisions with ESPHome's own preferences
 // and makes keys stable regardless of component registration order.
 static inline esp_err_t lm_nvs_open(nvs_handle_t &handle, nvs_open_mode_t mode) {
+#ifdef USE_LIFE_MATRIX_SOAK
+  // Soak firmware rewrites settings and sessions for days: keep it off the flash
+  // and leave the saved configuration as it was
+  if (mode == NVS_READWRITE) return ESP_ERR_NVS_READ_ONLY;
+#endif
   return nvs_open("lm_cfg", mode, &handle);
 }
 // Build a stable 8-char NVS key from an entity's object_id hash + type salt.
 static inline void lm_nvs_key(char *buf, uint32_t hash) {
   snprintf(buf, 12, "%08" PRIX32, hash);
 }
+// Key of an entity's saved value: the settings row's key when bound to one, else the hash key
+static inline const char *lm_entity_nvs_key(char *buf, const char *row_key, uint32_t hash) {
+  if (row_key != nullptr) return row_key;
+  lm_nvs_key(buf, hash);
+  return buf;
+}
 
 class LMSwitch : public switch_::Switch {
  public:
@@ -73,18 +94,19 @@ class LMSwitch : public switch_::Switch {
         this->restore_mode == switch_::SwitchRestoreMode::SWITCH_RESTORE_DEFAULT_OFF) {
       nvs_handle_t h;
       if (lm_nvs_open(h, NVS_READWRITE) == ESP_OK) {
-        char key[12];
-        lm_nvs_key(key, this->get_object_id_hash() ^ 0x5753U);
-        nvs_set_u8(h, key, (uint8_t)state);
+        char buf[12];
+        nvs_set_u8(h, lm_entity_nvs_key(buf, nvs_key_, this->get_object_id_hash() ^ 0x5753U), (uint8_t)state);
         nvs_commit(h);
         nvs_close(h);
       }
     }
   }
   void set_optimistic(bool) {}
+  void set_nvs_key(const char *key) { nvs_key_ = key; }
  private:
   std::string lm_name_;
   uint8_t lm_entity_cat_{0};
+  const char *nvs_key_{nullptr};
 };
 
 class LMSelect : public select::Select {
@@ -111,8 +133,8 @@ class LMSelect : public select::Select {
     if (!this->restore_value_) return;
     nvs_handle_t h;
     if (lm_nvs_open(h, NVS_READWRITE) == ESP_OK) {
-      char key[12];
-      lm_nvs_key(key, this->get_object_id_hash() ^ 0x4C53U);
+      char buf[12];
+      const char *key = lm_entity_nvs_key(buf, nvs_key_, this->get_object_id_hash() ^ 0x4C53U);
       const auto &opts = this->traits.get_options();
       for (size_t i = 0; i < opts.size(); i++) {
         if (std::string(opts[i]) == value) { nvs_set_u8(h, key, (uint8_t)i); break; }
@@ -126,11 +148,13 @@ class LMSelect : public select::Select {
   void set_initial_option(const std::string &s) { initial_option_ = s; }
   const std::string &get_initial_option() const { return initial_option_; }
   void set_optimistic(bool) {}
+  void set_nvs_key(const char *key) { nvs_key_ = key; }
  protected:
   bool restore_value_{false};
   std::string initial_option_;
   std::string lm_name_;
   uint8_t lm_entity_cat_{0};
+  const char *nvs_key_{nullptr};
 };
 
 class LMNumber : public number::Number {
@@ -158,9 +182,8 @@ class LMNumber : public number::Number {
     if (!this->restore_value_) return;
     nvs_handle_t h;
     if (lm_nvs_open(h, NVS_READWRITE) == ESP_OK) {
-      char key[12];
-      lm_nvs_key(key, this->get_object_id_hash() ^ 0x4E4DU);
-      nvs_set_blob(h, key, &value, sizeof(float));
+      char buf[12];
+      nvs_set_blob(h, lm_entity_nvs_key(buf, nvs_key_, this->get_object_id_hash() ^ 0x4E4DU), &value, sizeof(float));
       nvs_commit(h);
       nvs_close(h);
     }
@@ -170,11 +193,13 @@ class LMNumber : public number::Number {
   float get_initial_value() const { return initial_value_; }
   void set_mode(number::NumberMode m) { this->traits.set_mode(m); }
   void set_optimistic(bool) {}
+  void set_nvs_key(const char *key) { nvs_key_ = key; }
  protected:
   bool restore_value_{false};
   float initial_value_{NAN};
   std::string lm_name_;
   uint8_t lm_entity_cat_{0};
+  const char *nvs_key_{nullptr};
 };
 
 class LMText : public text::Text {
@@ -244,6 +269,116 @@ class LMButton : public button::Button {
   uint8_t lm_entity_cat_{0};
 };
 
+// ---------------------------------------------------------------------------
+// Fixed-capacity containers for runtime-edited configuration
+// ---------------------------------------------------------------------------
+// Lists that HA text entities rewrite (year events, lifespan biography, exercises)
+// and the screen/icon tables live inline in LifeMatrix, so a re-parse reuses the same
+// bytes instead of freeing and reallocating heap blocks. Limits can be raised from
+// YAML (`limits:`), which emits these defines.
+
+#ifndef LIFE_MATRIX_MAX_YEAR_EVENTS
+#define LIFE_MATRIX_MAX_YEAR_EVENTS 48    // year_events text + lifespan birthdays
+#endif
+#ifndef LIFE_MATRIX_MAX_LIFE_DATES
+#define LIFE_MATRIX_MAX_LIFE_DATES 8      // per list: kids, siblings
+#endif
+#ifndef LIFE_MATRIX_MAX_LIFE_RANGES
+#define LIFE_MATRIX_MAX_LIFE_RANGES 4     // per list: partner, marriage
+#endif
+#ifndef LIFE_MATRIX_MAX_MILESTONES
+#define LIFE_MATRIX_MAX_MILESTONES 16
+#endif
+#ifndef LIFE_MATRIX_MAX_CUSTOM_PHASES
+#define LIFE_MATRIX_MAX_CUSTOM_PHASES 16  // at most 55 (64 phase bits minus the built-ins)
+#endif
+#ifndef LIFE_MATRIX_MAX_EXERCISES
+#define LIFE_MATRIX_MAX_EXERCISES 16
+#endif
+#ifndef LIFE_MATRIX_MAX_ICONS
+#define LIFE_MATRIX_MAX_ICONS 4
+#endif
+#ifndef LIFE_MATRIX_LABEL_LEN
+#define LIFE_MATRIX_LABEL_LEN 16          // milestone, custom phase and exercise labels, NUL included
+#endif
+
+// Vector with inline storage for up to N items. push_back() returns false once full;
+// removed slots are reset so owned resources (e.g. a Screen) are released.
+template<typename T, size_t N> class InlineVector {
+ public:
+  bool push_back(T value) {
+    if (size_ >= N) return false;
+    items_[size_++] = std::move(value);
+    return true;
+  }
+  void pop_back() {
+    if (size_ > 0) items_[--size_] = T();
+  }
+  void clear() {
+    while (size_ > 0) items_[--size_] = T();
+  }
+  size_t size() const { return size_; }
+  static constexpr size_t capacity() { return N; }
+  bool empty() const { return size_ == 0; }
+  bool full() const { return size_ >= N; }
+  T &operator[](size_t i) { return items_[i]; }
+  const T &operator[](size_t i) const { return items_[i]; }
+  T &front() { return items_[0]; }
+  const T &front() const { return items_[0]; }
+  T &back() { return items_[size_ - 1]; }
+  const T &back() const { return items_[size_ - 1]; }
+  T *data() { return items_.data(); }
+  const T *data() const { return items_.data(); }
+  T *begin() { return items_.data(); }
+  T *end() { return items_.data() + size_; }
+  const T *begin() const { return items_.data(); }
+  const T *end() const { return items_.data() + size_; }
+
+ private:
+  std::array<T, N> items_{};
+  size_t size_{0};
+};
+
+// NUL-terminated string stored inline; longer input is truncated
+template<size_t N> struct FixedString {
+  char text[N]{};
+  void assign(const char *s, size_t n) {
+    n = std::min(n, N - 1);
+    std::memcpy(text, s, n);
+    text[n] = '\0';
+  }
+  void assign(const std::string &s) { assign(s.data(), s.size()); }
+  const char *c_str() const { return text; }
+  bool empty() const { return text[0] == '\0'; }
+};
+using FixedLabel = FixedString<LIFE_MATRIX_LABEL_LEN>;
+
+// ---------------------------------------------------------------------------
+// Memory placement
+// ---------------------------------------------------------------------------
+// Large buffers declare where they belong. HOT ones are walked every frame or every
+// generation and stay in internal RAM; COLD ones (history, caches, tables read once
+// per frame) go to PSRAM when the board has it, so they do not compete with the WiFi
+// buffers. Each falls back to the other pool instead of failing.
+enum class MemPlacement : uint8_t { HOT, COLD };
+
+void *placed_alloc(size_t bytes, MemPlacement where);
+void placed_free(void *ptr);
+bool placed_in_psram(const void *ptr);
+
+template<typename T, MemPlacement P> struct PlacedAllocator {
+  using value_type = T;
+  template<typename U> struct rebind { using other = PlacedAllocator<U, P>; };
+  PlacedAllocator() = default;
+  template<typename U> PlacedAllocator(const PlacedAllocator<U, P> &) {}  // NOLINT(google-explicit-constructor)
+  T *allocate(size_t n) { return static_cast<T *>(placed_alloc(n * sizeof(T), P)); }
+  void deallocate(T *ptr, size_t) { placed_free(ptr); }
+  bool operator==(const PlacedAllocator &) const { return true; }
+  bool operator!=(const PlacedAllocator &) const { return false; }
+};
+template<typename T> using HotVector = std::vector<T, PlacedAllocator<T, MemPlacement::HOT>>;
+template<typename T> using ColdVector = std::vector<T, PlacedAllocator<T, MemPlacement::COLD>>;
+
 // Grid dimensions (after 90° rotation: 32w × 120h)
 static const int GRID_WIDTH = 32;
 static const int GRID_HEIGHT = 120;
@@ -258,14 +393,18 @@ static const uint16_t ICON_TRANSPARENT = 0xF81F;
 
 // Maximum frames per animated icon
 static const int MAX_ICON_FRAMES = 64;
+static const int ICON_ID_LEN = 24;  // icon_id incl. NUL (checked at config time)
 
 // Icon data stored as contiguous array of frames
 struct IconData {
+  FixedString<ICON_ID_LEN> id;
   const uint16_t *data{nullptr};       // Pointer to all frame data (contiguous)
   uint16_t frame_durations[MAX_ICON_FRAMES]; // Duration of each frame in ms
   uint8_t frame_count{1};
   uint8_t width{ICON_SIZE};
   uint8_t height{ICON_SIZE};
+  uint8_t current_frame{0};            // animation state
+  uint32_t last_frame_ms{0};
 };
 
 // UI modes
@@ -284,7 +423,9 @@ enum ScreenID {
   SCREEN_HABITS = 4,
   SCREEN_LIFESPAN = 5,
   SCREEN_GAME_OF_LIFE = 6,
-  SCREEN_POMODORO     = 7
+  SCREEN_POMODORO     = 7,
+  SCREEN_SENSORS      = 8,
+  SCREEN_COUNT        = 9
 };
 
 // Life phases for the lifespan view
@@ -319,9 +460,71 @@ struct LifeRange {
 // A named life milestone
 struct LifeMilestone {
   LifeDate date;
-  std::string label;
+  FixedLabel label;
 };
 
+// A user-defined phase, written "range:label[:RRGGBB]". The range is an age span
+// ("16-24", "30-" = open) or a date range ("2012-03-01/2015-08-31", end optional).
+struct LifeCustomPhase {
+  FixedLabel label;
+  Color color;
+  bool has_color{false};
+  bool by_age{true};
+  int16_t start_age{0};
+  int16_t end_age{-1};     // exclusive, -1 = open-ended
+  LifeRange range;         // when !by_age
+};
+
+// Phase table entry: built-ins occupy the LifePhase ids, custom phases follow
+static const int LIFESPAN_MAX_PHASES = 64;
+static_assert(LIFE_MATRIX_MAX_CUSTOM_PHASES <= LIFESPAN_MAX_PHASES - PHASE_COUNT,
+              "custom phases share the 64-bit phase mask with the built-ins");
+struct LifePhaseDef {
+  const char *label;  // built-in name or LifeCustomPhase::label
+  Color color;
+};
+
+// Elementary age interval [start_age, next start_age) over which the set of active
+// phases is constant; its blended color is computed once when the index is built
+struct LifePhaseSegment {
+  int16_t start_age;
+  uint64_t mask;
+  Color blend;
+};
+
+// Phase interval in days from Jan 1 of the birth year (366 per calendar year), so date
+// ranges keep their month and day for the zoomed grids; ages map to Jan 1 of that year
+struct LifePhaseSpan {
+  int32_t start_day;
+  int32_t end_day;  // exclusive
+  uint8_t phase;
+};
+
+// Lifespan zoom levels, coarse → fine; YEARS is the one-row-per-year view
+enum LifespanZoom : uint8_t {
+  LS_ZOOM_DECADES = 0,  // a row per decade, a cell per year
+  LS_ZOOM_YEARS   = 1,
+  LS_ZOOM_MONTHS  = 2,  // a row per year, a cell per month
+  LS_ZOOM_WEEKS   = 3,  // life in weeks: 52 cells per year
+  LS_ZOOM_COUNT   = 4
+};
+
+// Marker bits of a lifespan zoom cell
+static const uint8_t LS_CELL_UNBORN    = 0x01;
+static const uint8_t LS_CELL_EVENT     = 0x02;
+static const uint8_t LS_CELL_MILESTONE = 0x04;
+
+// Cell table of one zoom level. Cell i lies in calendar year birth_year + i / per_year;
+// month and week cells resolve their phases at the cell's own date, not the whole year.
+struct LifespanZoomTable {
+  uint8_t per_year{1};
+  ColdVector<uint8_t> marks;  // LS_CELL_* bits, life_expectancy_age * per_year cells
+  ColdVector<uint8_t> seg;    // per cell, index into lifespan_zoom_segs_
+};
+
+using LifeDateList = InlineVector<LifeDate, LIFE_MATRIX_MAX_LIFE_DATES>;
+using LifeRangeList = InlineVector<LifeRange, LIFE_MATRIX_MAX_LIFE_RANGES>;
+
 // Full biographical config for the lifespan view
 struct LifespanConfig {
   LifeDate birthday;           // required anchor
@@ -332,11 +535,12 @@ struct LifespanConfig {
   float phase_cycle_s{3.0f};   // 0 = disabled
   LifeRange parents[2];
   int parent_count{0};
-  std::vector<LifeDate> kids;
-  std::vector<LifeDate> siblings;
-  std::vector<LifeRange> partner_ranges;
-  std::vector<LifeRange> marriage_ranges;
-  std::vector<LifeMilestone> milestones;
+  LifeDateList kids;
+  LifeDateList siblings;
+  LifeRangeList partner_ranges;
+  LifeRangeList marriage_ranges;
+  InlineVector<LifeMilestone, LIFE_MATRIX_MAX_MILESTONES> milestones;
+  InlineVector<LifeCustomPhase, LIFE_MATRIX_MAX_CUSTOM_PHASES> custom_phases;
 };
 
 // Pomodoro timer presets
@@ -431,6 +635,61 @@ enum ColorTransformMode {
   CTM_HUE_SHIFT = 1  // rotate all pixel hues using precomputed circulant matrix
 };
 
+// Screen transition styles (played when the current screen changes)
+enum TransitionStyle {
+  TRANSITION_NONE      = 0,
+  TRANSITION_CROSSFADE = 1,
+  TRANSITION_SLIDE     = 2
+};
+
+enum TransitionEasing {
+  EASE_LINEAR   = 0,
+  EASE_IN_OUT   = 1,  // smoothstep
+  EASE_OUT      = 2   // cubic, fast start
+};
+
+// Live pixel input: raw RGB frames over UDP take over the panel until they stop
+enum LiveProtocol {
+  LIVE_DDP  = 0,  // Distributed Display Protocol, port 4048
+  LIVE_E131 = 1   // E1.31 / sACN unicast, port 5568, 170 pixels per universe
+};
+static const int LIVE_PACKET_SIZE = 1472;      // largest UDP payload without fragmentation
+static const int LIVE_E131_PIXELS = 170;       // 510 of 512 channels per universe
+static const int LIVE_E131_MAX_UNIVERSES = 64;
+
+// Soup search: random 30% soups are replayed headless as 32-bit rows and scored by how long
+// they run before the visible game would call them stable; the best seeds are kept in NVS
+static const int SOUP_TABLE_SIZE = 8;
+static const int SOUP_MAX_GENERATIONS = 5000;  // a soup lasting this long is as good as it gets
+struct SoupSeed {
+  uint32_t seed;
+  uint16_t lifetime;    // generations until extinct / population < 58 / 30 flat generations
+  uint16_t population;  // population at that point (tie-break)
+};
+struct SoupTable {
+  uint16_t grid_w, grid_h;  // seeds only reproduce on the grid they were scored on
+  SoupSeed seeds[SOUP_TABLE_SIZE];  // best first, lifetime 0 = empty
+};
+
+// GoL rewind: history is a list of segments, each a bit-packed keyframe followed by up to
+// REWIND_KEYFRAME_INTERVAL - 1 delta records (u16 length, then a bitmap of the frame bytes
+// that changed and their XOR values; length 0 = identical generation)
+static const int REWIND_KEYFRAME_INTERVAL = 32;
+struct RewindSegment {
+  int first_gen;
+  int count;  // generations held, keyframe included
+  ColdVector<uint8_t> data;
+};
+
+// Palette-indexed render mode: views write 8-bit slots, colors are resolved once per frame
+static const int PALETTE_SIZE = 256;        // slot 0 = untouched pixel, presented black
+static const int PALETTE_HASH_SIZE = 512;   // open-addressed color → slot table, power of two
+static const int PALETTE_BLIT_PIXELS = 256;  // RGB565 staging block per draw_pixels_at() call
+
+// Year view day flags, cached per year in LifeMatrix::year_day_flags_
+static const uint8_t YEAR_DAY_WEEKEND = 0x01;
+static const uint8_t YEAR_DAY_EVENT   = 0x02;
+
 // Event storage structure
 struct YearEvent {
   uint8_t month;  // 1-12
@@ -447,11 +706,42 @@ enum PatternType {
   PATTERN_MIXED
 };
 
+// Packed GoL pattern: rows of (width + 7) / 8 bytes, bit 0 = leftmost cell. The built-ins
+// and the RLE files compiled by __init__.py stay in flash; placing one is a bit blit.
+struct LifePattern {
+  const char *name;
+  const uint8_t *bits;
+  uint16_t width;
+  uint16_t height;
+};
+struct PatternPlacement {
+  LifePattern pattern;
+  int16_t x, y;
+};
+
+struct Viewport;
+
+// One view behind the screen scheduler. The object, and whatever buffers it needs, exists
+// only while the view is enabled: register_screen() creates it on enable and destroys it
+// on disable, so state of views a device never shows is never allocated.
+class Screen {
+ public:
+  virtual ~Screen() = default;
+  // Settle caches and lazy state before the first visible frame (pre-warm or switch frame)
+  virtual void prepare(ESPTime &time) {}
+  // Per-loop() work while visible, once next_change_time() has passed
+  virtual void step(uint32_t now_ms) {}
+  virtual void render(display::Display &it, ESPTime &time, const Viewport &vp) = 0;
+  // millis() at which the view next changes on its own; now_ms when it may change any time
+  virtual uint32_t next_change_time(uint32_t now_ms) { return now_ms; }
+};
+
 // Configuration structures
 struct ScreenConfig {
-  int id;
-  bool enabled;
-  std::string name;
+  int id{-1};
+  bool enabled{false};
+  const char *name{""};
+  std::unique_ptr<Screen> screen;  // null while disabled
 };
 
 struct TimeSegmentsConfig {
@@ -475,12 +765,186 @@ struct Viewport {
   int text_y;
 };
 
+// Per-view geometry derived from the real display size and viewport. Built once by
+// update_layout() whenever either changes; views read cell sizes, margins and walk
+// orders from here instead of assuming a 32×120 panel.
+struct ViewLayout {
+  int width{0};
+  int height{0};
+  int viz_y{-1};
+  int viz_height{0};
+
+  // Bar area shared by day/hour/lifespan/pomodoro; the outer columns are left for markers
+  int bar_x{1};
+  int bar_w{30};
+
+  // Day view: minute-of-day where each row starts
+  std::vector<uint16_t> day_row_minute;
+
+  // Hour view: second-of-hour where each row starts (extra trailing entry = 3600)
+  std::vector<uint16_t> hour_row_second;
+  // Hour view Time Segments: each quarter is a bar_w × quarter_h clockwise spiral
+  int quarter_h{30};
+  std::vector<uint16_t> quarter_spiral;  // row * bar_w + col, in fill order
+
+  // Month view grid: days flow left→right, top→bottom
+  int month_cols{4};
+  int month_rows{8};
+  int month_cell_w{8};
+  int month_cell_h{14};
+  int month_x0{0};
+
+  // Year view: 12 month bands, one column band per day of month
+  int year_month_h{9};
+  int year_day_w{1};
+  uint16_t year_day_x[32]{};  // [day 1-31] first column of that day
+};
+
+// Habit tracker: one bit per day-of-year, 366 bits = 46 bytes per habit-year in NVS.
+// In RAM each year is padded to 12 words so streaks/rates reduce to popcount/clz.
+static const int HABIT_MAX = 8;
+static const int HABIT_YEARS = 4;        // years of history kept resident (ring by year)
+static const int HABIT_WORDS = 12;
+static const int HABIT_BLOB_BYTES = 46;
+
+struct HabitStats {
+  int current_streak{0};   // consecutive done days ending today (or yesterday if today is open)
+  int best_streak{0};      // longest run within the current year
+  int done_ytd{0};
+  int done_30d{0};
+  int days_ytd{0};
+};
+
+// Pomodoro session log: 8-byte records appended to an NVS ring of fixed-size chunks,
+// so each append rewrites one 256-byte chunk instead of the whole history.
+struct PomoSessionRecord {
+  uint32_t start_epoch;    // 0 = clock not synced at session start
+  uint16_t focus_min;      // completed + partial work time
+  uint8_t preset_rounds;   // preset << 6 | rounds completed (max 63)
+  uint8_t snacks;          // exercise snacks logged
+};
+static const int POMO_LOG_CHUNK_RECORDS = 32;
+static const int POMO_LOG_CHUNKS = 8;              // 256 sessions of raw history
+static const int POMO_YEAR_HISTORY = 8;
+static const int POMO_AGG_SAVE_EVERY = 8;          // sessions between aggregate writes
+static const int POMO_HEAT_FULL_MIN = 240;         // focus minutes that fill a heatmap cell
+
+struct PomoYearTotal {
+  int16_t year;
+  uint16_t sessions;
+  uint32_t focus_min;
+};
+
+// Running totals updated once per logged session; views read these, never the log
+struct PomoAggregates {
+  uint16_t version;
+  int16_t year;                              // year day_min/week_min describe
+  uint32_t head;                             // log records folded in
+  uint16_t day_min[366];                     // focus minutes per day-of-year
+  uint16_t week_min[54];                     // per Monday-start week of `year`
+  PomoYearTotal years[POMO_YEAR_HISTORY];    // ring by year
+};
+
+// Head chunk of the session log and the aggregates, held only while in use
+struct PomoLogCache {
+  PomoSessionRecord chunk[POMO_LOG_CHUNK_RECORDS];  // chunk holding the head
+  PomoAggregates agg;
+};
+
+// Sensor graph screen: each HA sensor keeps up to GRAPH_BINS min/max bins that samples
+// are folded into as they arrive, so a frame reads at most GRAPH_BINS bins.
+static const int GRAPH_BINS = 120;
+static const int GRAPH_MAX_SERIES = 4;
+
+struct GraphBin {
+  float min;
+  float max;
+};
+
+struct SensorSeries {
+  sensor::Sensor *sensor{nullptr};
+  std::string label;
+  uint32_t interval_ms{0};        // 0 = sample on every state update
+  uint16_t capacity{0};           // samples of history shown
+  uint16_t per_bin{1};            // samples folded into each bin
+  uint16_t bin_count{0};          // ceil(capacity / per_bin) <= GRAPH_BINS
+  std::vector<GraphBin> bins;     // ring indexed by (sample / per_bin) % bin_count
+  uint32_t total{0};              // samples ever pushed
+  float latest{NAN};
+
+  void push(float v);
+  size_t bytes() const { return bins.capacity() * sizeof(GraphBin); }
+};
+
+#ifdef USE_LIFE_MATRIX_SOAK
+// Log-linear latency histogram: exact below 16 us, then 8 buckets per power of two
+// (at most 12.5% over) up to ~2 min. Fixed size, so recording never allocates.
+struct LatencyHistogram {
+  static const int BUCKETS = 16 + 24 * 8;
+  uint32_t counts[BUCKETS]{};
+  uint32_t total{0};
+  uint32_t max_us{0};
+
+  void record(uint32_t us);
+  uint32_t percentile(float p) const;  // upper bound of the bucket holding rank p * total
+  void reset() { *this = LatencyHistogram{}; }
+};
+#endif
+
+// Off-screen RGB565 frame used by the transition engine. Views (text included) render
+// into it exactly as they would into the panel, so two frames can be blended afterwards.
+class FrameCanvas : public display::Display {
+ public:
+  void resize(int width, int height);
+  void clear() { std::fill(buf_.begin(), buf_.end(), 0); }
+  uint16_t *pixels() { return buf_.data(); }
+  // Two RGB565 pixels per word; buffer length is rounded up to an even pixel count
+  uint32_t *words() { return reinterpret_cast<uint32_t *>(buf_.data()); }
+  int pixel_count() const { return w_ * h_; }
+  size_t bytes() const { return buf_.size() * sizeof(uint16_t); }
+
+  void draw_pixel_at(int x, int y, Color color) override;
+  display::DisplayType get_display_type() override { return display::DisplayType::DISPLAY_TYPE_COLOR; }
+  void update() override {}
+
+ protected:
+  int get_width_internal() override { return w_; }
+  int get_height_internal() override { return h_; }
+
+  HotVector<uint16_t> buf_;  // blended or copied whole every transition frame
+  int w_{0};
+  int h_{0};
+};
+
+// ============================================================================
+// SETTINGS DESCRIPTORS
+// ============================================================================
+// Each user setting is one row of SETTING_TABLE, indexed by SettingID: menu label and
+// value text, range, HA options, object id and NVS key. The rows are generated into
+// settings_table.h from settings_table.py, which __init__.py reads for the HA entities;
+// LifeMatrix::SETTING_ACCESS adds the getter and setter. The settings menu, HA entity
+// callbacks and the boot restore all read the row.
+
+class LifeMatrix;
+
+// Accessors of a settings row, kept in C++ next to the members they reach
+struct SettingAccess {
+  SettingID id;
+  int (*get)(const LifeMatrix &);
+  void (*set)(LifeMatrix &, int);
+};
+
 class LifeMatrix : public Component {
  public:
   void setup() override;
   void loop() override;
   float get_setup_priority() const override { return setup_priority::PROCESSOR; }
 
+  // The palette canvas and other per-frame state live inline in the component, so the
+  // object itself is a hot buffer; screen-owned caches are ColdVectors
+  static void *operator new(size_t bytes) { return placed_alloc(bytes, MemPlacement::HOT); }
+  static void operator delete(void *ptr) { placed_free(ptr); }
+
   // Component configuration
   void set_display(display::Display *display) { display_ = display; }
   void set_time(time::RealTimeClock *time) { time_ = time; }
@@ -489,10 +953,20 @@ class LifeMatrix : public Component {
   void set_status_led(light::LightState *led) { status_led_ = led; }
   void set_gol_final_generation_sensor(sensor::Sensor *sensor) { gol_final_generation_sensor_ = sensor; }
   void set_gol_final_population_sensor(sensor::Sensor *sensor) { gol_final_population_sensor_ = sensor; }
+  void set_input_latency_sensor(sensor::Sensor *sensor) { input_latency_sensor_ = sensor; }
+  void set_sleep_cpu_saved_sensor(sensor::Sensor *sensor) { sleep_cpu_saved_sensor_ = sensor; }
+  void set_heap_fragmentation_sensor(sensor::Sensor *sensor) { heap_fragmentation_sensor_ = sensor; }
   void set_grid_dimensions(int width, int height);
   void set_screen_cycle_time(float seconds) { screen_cycle_time_ = seconds; }
   void set_text_area_position(const std::string &position) { text_area_position_ = position; }
   void set_fill_direction(const std::string &direction) { fill_direction_bottom_to_top_ = (direction == "Bottom to Top"); }
+  void set_palette_render(bool enabled) { palette_render_ = enabled; }
+  void set_prewarm_screens(bool enabled) { prewarm_screens_ = enabled; }
+  void set_celebration_sequence(const std::vector<uint8_t> &styles);  // CelebrationStyle values, up to 4
+  void set_transition_style(const std::string &style);
+  void set_transition_easing(const std::string &easing);
+  void set_transition_duration(uint32_t ms) { transition_duration_ms_ = ms; }
+  void set_native_canvas(bool enabled) { native_canvas_ = enabled; }
 
   // Color configuration
   void set_color_active(Color c) { color_active_ = c; }
@@ -525,6 +999,7 @@ class LifeMatrix : public Component {
   void set_lifespan_siblings(const std::string &dates);
   void set_lifespan_partner_ranges(const std::string &ranges);
   void set_lifespan_marriage_ranges(const std::string &ranges);
+  void set_lifespan_custom_phases(const std::string &phases);
   void set_lifespan_milestones(const std::string &milestones_str);
   void set_lifespan_retirement_age(int age) { lifespan_config_.retirement_age = age; }
   void set_lifespan_life_expectancy(int age) { lifespan_config_.life_expectancy_age = age; }
@@ -559,6 +1034,7 @@ class LifeMatrix : public Component {
   void update_lifespan_milestones(const std::string &d)    { set_lifespan_milestones(d);     save_to_nvs("ls_milestones", d);  refresh_lifespan(); }
   void update_lifespan_partner_ranges(const std::string &d){ set_lifespan_partner_ranges(d); save_to_nvs("ls_partner", d);     refresh_lifespan(); }
   void update_lifespan_marriage_ranges(const std::string &d){ set_lifespan_marriage_ranges(d); save_to_nvs("ls_marriage", d);    refresh_lifespan(); }
+  void update_lifespan_custom_phases(const std::string &d) { set_lifespan_custom_phases(d);   save_to_nvs("ls_phases", d);      refresh_lifespan(); }
   void update_lifespan_moved_out_age(int v)    { set_lifespan_moved_out_age(v);    save_to_nvs("ls_moved_out", (float)v);    refresh_lifespan(); }
   void update_lifespan_school_years(int v)     { set_lifespan_school_years(v);     save_to_nvs("ls_school_yr", (float)v);     refresh_lifespan(); }
   void update_lifespan_retirement_age(int v)   { set_lifespan_retirement_age(v);   save_to_nvs("ls_retirement", (float)v);    refresh_lifespan(); }
@@ -567,7 +1043,15 @@ class LifeMatrix : public Component {
 
   // Year events / exercise list updaters (NVS-backed, for on_value callbacks)
   void update_year_events(const std::string &v)       { set_year_events(v);        save_to_nvs("year_events", v);   apply_lifespan_year_events(); }
+#ifndef LIFE_MATRIX_NO_POMODORO
   void update_exercise_list_csv(const std::string &v) { set_exercise_list_csv(v);  save_to_nvs("exercise_list", v); }
+#endif
+
+#ifndef LIFE_MATRIX_NO_LIFESPAN
+  // Lifespan zoom — steps toward weeks (+1) or decades (-1), clamped
+  void zoom_lifespan(int delta);
+  int get_lifespan_zoom() const { return lifespan_zoom_; }
+#endif
 
   // Input handlers — called directly from YAML encoder/button on_press
   void enc1_clockwise();
@@ -576,6 +1060,7 @@ class LifeMatrix : public Component {
   void enc2_anticlockwise();
   void toggle_settings_mode();
   void enc2_press();
+  void button_up_press();
   void button_down_press();
   void adjust_display_brightness(int delta);
 
@@ -591,11 +1076,13 @@ class LifeMatrix : public Component {
   // Main rendering
   void render(display::Display &it, ESPTime &time);
 
+  void set_game_update_interval(int ms) { game_config_.update_interval_ms = ms; }
+
+#ifndef LIFE_MATRIX_NO_GOL
   // Game of Life
   void initialize_game_of_life(PatternType pattern = PATTERN_MIXED);
   void update_game_of_life();
   void reset_game_of_life();
-  void set_game_update_interval(int ms) { game_config_.update_interval_ms = ms; }
   void set_demo_mode(bool enabled);
   uint8_t get_cell(int x, int y);
   void set_cell(int x, int y, uint8_t value);
@@ -605,30 +1092,44 @@ class LifeMatrix : public Component {
   int get_generation() { return game_generation_; }
   void place_pattern(int x, int y, PatternType pattern);
   void randomize_cells(int density_percent);
+  void place_pattern(int x, int y, const LifePattern &pattern);
+  // Pattern library (PATTERN_MIXED layout) and runtime RLE: streamed straight into a cleared
+  // grid, centred when the "x = .., y = .." header is present
+  void add_pattern(const char *name, const uint8_t *bits, uint16_t width, uint16_t height, int x, int y);
+  bool load_rle(const char *rle);
+#endif
 
   // UI state management
   void set_ui_mode(UIMode mode);
   UIMode get_ui_mode() { return ui_mode_; }
   void handle_input();
+  // Marks the frame dirty; loop() then renders out-of-band instead of waiting for the
+  // display's next poll. Not an input signal: HA updates and internal state use it too.
+  void request_redraw();
   void check_ui_timeout();
   void toggle_pause();
   void set_paused(bool paused) { ui_paused_ = paused; }
   bool is_paused() { return ui_paused_; }
   void update_status_led();
 
-  // Settings system
+  // Settings system — menu, HA entities and restore all driven by SETTING_TABLE
+  static const SettingAccess SETTING_ACCESS[SET_COUNT];
   void adjust_setting(int direction);
   void next_settings_cursor();
   void prev_settings_cursor();
   void set_settings_cursor(int pos) { settings_cursor_ = pos; }
   int get_settings_cursor() { return settings_cursor_; }
-  std::string get_current_setting_name();
-  std::string get_current_setting_value();
+  const char *get_current_setting_name();
+  const char *get_current_setting_value();  // formatted into a member buffer
+  int get_setting(SettingID id) const { return SETTING_ACCESS[id].get(*this); }
+  void apply_setting(SettingID id, int value);
+  size_t format_setting_value(SettingID id, char *buf, size_t len) const;
 
   // Time segments configuration
   void set_time_segments(const TimeSegmentsConfig &config) { time_segments_ = config; }
   TimeSegmentsConfig get_time_segments() { return time_segments_; }
   void set_bed_time_hour(int h) { time_segments_.bed_time_hour = h; apply_brightness(); }
+  void set_wake_time_hour(int h) { time_segments_.wake_time_hour = h; apply_brightness(); }
   void set_work_start_hour(int h) { time_segments_.work_start_hour = h; }
   void set_work_end_hour(int h) { time_segments_.work_end_hour = h; }
 
@@ -646,6 +1147,12 @@ class LifeMatrix : public Component {
   ESPTime get_time_override() { return fake_time_; }
   ESPTime get_display_time() const;  // current time respecting any active override
 
+  // Pomodoro settings (settings rows, so compiled in without the screen)
+  void set_exercise_snacks_enabled(bool en) { exercise_snacks_enabled_ = en; }
+  void set_pomo_preset(const std::string &name);
+  void set_pomo_rounds(int rounds);
+
+#ifndef LIFE_MATRIX_NO_POMODORO
   // Pomodoro control
   void start_pomodoro();
   void pause_pomodoro();
@@ -656,13 +1163,25 @@ class LifeMatrix : public Component {
   void exercise_adjust_reps(int delta);
   void exercise_next();
   void exercise_prev();
-  void set_exercise_list(std::vector<std::string> list) { exercise_list_ = list; }
+  void set_exercise_list(const std::vector<std::string> &list);
   void set_exercise_list_csv(const std::string &csv);
-  void set_exercise_snacks_enabled(bool en) { exercise_snacks_enabled_ = en; }
-  void set_pomo_preset(const std::string &name);
-  void set_pomo_rounds(int rounds);
   void set_pomo_phase_override(const std::string &phase);
-
+#endif
+
+#ifndef LIFE_MATRIX_NO_HABITS
+  // Habit tracker
+  void set_habit_list_csv(const std::string &csv);
+  int get_habit_count() const { return habit_count_; }
+  int get_selected_habit() const { return habit_selected_; }
+  void set_habit_done(int habit, int year, int doy, bool done);
+  bool is_habit_done(int habit, int year, int doy);
+  void set_habit_done_today(int habit, bool done);
+  void toggle_habit_today(int habit);
+  void select_next_habit();
+  HabitStats get_habit_stats(int habit, const ESPTime &time);
+#endif
+
+#ifndef LIFE_MATRIX_NO_POMODORO
   // Pomodoro state accessors (for YAML lambdas)
   int get_pomo_phase() { return (int)pomo_phase_; }
   int get_pomo_completed_rounds() { return pomo_completed_rounds_; }
@@ -672,14 +1191,28 @@ class LifeMatrix : public Component {
   int get_pomo_total_sec() const;
   int get_session_elapsed_sec() const;
   PomodoroPresetConfig get_preset_config() const;
+#endif
+
+#ifndef LIFE_MATRIX_NO_SENSORS
+  // Sensor graphs
+  void add_sensor_graph(sensor::Sensor *sens, const std::string &label, uint16_t samples, uint32_t interval_ms);
+  void select_next_graph();
+  int get_graph_count() const { return (int)graphs_.size(); }
+#endif
+
+#ifndef LIFE_MATRIX_NO_POMODORO
+  // Focus-time aggregates from the session log (minutes; 0 when no data for that period)
+  void set_pomo_heatmap(bool enabled) { pomo_heatmap_ = enabled; }
+  int get_focus_minutes_today();
+  int get_focus_minutes_week();
+  int get_focus_minutes_year(int year);
+  uint32_t get_pomo_sessions_logged();
 
   // Pomodoro entity registration
-  void set_ha_pomo_preset(select::Select *s);
-  void set_ha_pomo_rounds(number::Number *n);
-  void set_ha_exercise_snacks(switch_::Switch *s);
   void set_pomo_event_sensor(text_sensor::TextSensor *ts) { pomo_event_sensor_ = ts; }
   void set_pomo_exercise_sensor(text_sensor::TextSensor *ts) { pomo_exercise_sensor_ = ts; }
   void set_ha_pomo_start_button(button::Button *b);
+#endif
 
   // Night mode brightness control
   void set_base_brightness_pct(float pct);
@@ -689,30 +1222,73 @@ class LifeMatrix : public Component {
   float get_base_brightness_pct() const { return base_brightness_pct_; }
   float get_screen_cycle_time()   const { return screen_cycle_time_; }
 
-  // HA entity sync — register entities, wire callbacks (called from __init__.py to_code)
-  void set_ha_complex_patterns(switch_::Switch *sw);
-  void set_ha_conway_speed(select::Select *s);
-  void set_ha_style(select::Select *s);
-  void set_ha_gradient_type(select::Select *s);
-  void set_ha_fill_direction(select::Select *s);
-  void set_ha_marker_style(select::Select *s);
-  void set_ha_marker_color(select::Select *s);
-  void set_ha_text_area_position(select::Select *s);
-  void set_ha_day_fill(select::Select *s);
-  void set_ha_year_event_style(select::Select *s);
-  void set_ha_bed_time_hour(number::Number *n);
-  void set_ha_work_start_hour(number::Number *n);
-  void set_ha_work_end_hour(number::Number *n);
-  void set_ha_cycle_time(number::Number *n);
-  void set_ha_display_brightness(number::Number *n);
-  void set_ha_night_mode_level(number::Number *n);
-  void set_ha_show_future(switch_::Switch *s);
+  // Display sleep: between bed and wake hour (schedule) or on request, the panel is
+  // blanked, the display poller stops and loop() only watches for input or wake time
+  void set_sleep_schedule(bool enabled) { sleep_schedule_ = enabled; sleep_checked_ms_ = 0; }
+  void set_sleep_now(bool sleep) { sleep_now_ = sleep; sleep_checked_ms_ = 0; }
+  bool is_sleeping() const { return sleeping_; }
+
+  // Power limiter: panel current is estimated from the presented frame's channel sum and
+  // the applied brightness; brightness is scaled down while it would exceed max_current_ma
+  void set_power_limit(int max_current_ma, float channel_current_ma, int idle_current_ma);
+  void set_power_current_sensor(sensor::Sensor *sensor) { power_current_sensor_ = sensor; }
+  float get_estimated_current_ma() const;
+
+  // Snapshot: the presented frame as a 4× PNG, re-encoded in loop() at most once per
+  // interval and only while it is being fetched (GET /snapshot.png with web_server)
+  void set_snapshot_interval(uint32_t interval_ms);
+  bool encode_snapshot_png(ColdVector<uint8_t> &out) const;
+
+  // Live input: DDP or E1.31 frames are blitted from the packet buffer straight into the
+  // display and shown on push; the normal screens return timeout_ms after the last packet
+  void set_live_input(int protocol, uint16_t port, uint32_t timeout_ms, uint16_t start_universe);
+  void set_live_latency_sensor(sensor::Sensor *sensor) { live_latency_sensor_ = sensor; }
+  void set_live_dropped_sensor(sensor::Sensor *sensor) { live_dropped_sensor_ = sensor; }
+  bool is_live() const { return live_active_; }
+
+#ifdef USE_LIFE_MATRIX_SOAK
+  // Soak mode (test firmware): every step_ms the display clock jumps ahead and the screen,
+  // one setting, pomodoro state and, less often, config text and celebrations are churned;
+  // heap, loop/render p99 and millis() drift are logged every report_ms
+  void set_soak(uint32_t step_ms, uint32_t report_ms) {
+    soak_step_ms_ = step_ms;
+    soak_report_ms_ = report_ms;
+  }
+#endif
+
+#ifndef LIFE_MATRIX_NO_GOL
+  // Soup search: an idle-priority task scores random soups; PATTERN_RANDOM starts from the table
+  void set_soup_search(bool enabled) { soup_search_ = enabled; }
+  void set_soup_rate_sensor(sensor::Sensor *sensor) { soup_rate_sensor_ = sensor; }
+
+  // GoL rewind: the last generations are kept as XOR deltas within memory_bytes; paused on
+  // the GoL screen, encoder 1 scrubs through them (-1 = showing the live generation)
+  void set_gol_rewind_memory(uint32_t bytes) { rewind_cap_ = bytes; }
+  int get_rewind_generation() const { return rewind_gen_; }
+  uint32_t get_rewind_bytes() const { return rewind_bytes_; }
+#endif
+#ifdef USE_LIFE_MATRIX_SNAPSHOT
+  void set_snapshot_web_server(web_server_base::WebServerBase *base);
+  void serve_snapshot(AsyncWebServerRequest *request);
+#endif
+
+  // HA entity sync — bind a settings row to its entity (called from __init__.py to_code)
+  void bind_setting(SettingID id, select::Select *s);
+  void bind_setting(SettingID id, number::Number *n);
+  void bind_setting(SettingID id, switch_::Switch *sw);
 
   // Text / number / button entity wiring (auto-generated entities)
   void set_year_events_entity(text::Text *t);
+#ifndef LIFE_MATRIX_NO_POMODORO
   void set_exercise_list_entity(text::Text *t);
+#endif
   void set_time_override_entity(text::Text *t);
+#ifndef LIFE_MATRIX_NO_GOL
+  void set_gol_rle_entity(text::Text *t);
+#endif
+#ifndef LIFE_MATRIX_NO_POMODORO
   void set_pomo_test_phase_entity(text::Text *t);
+#endif
   void set_ls_birthday_entity(text::Text *t);
   void set_ls_kids_entity(text::Text *t);
   void set_ls_parents_entity(text::Text *t);
@@ -720,6 +1296,7 @@ class LifeMatrix : public Component {
   void set_ls_milestones_entity(text::Text *t);
   void set_ls_partner_ranges_entity(text::Text *t);
   void set_ls_marriage_ranges_entity(text::Text *t);
+  void set_ls_custom_phases_entity(text::Text *t);
   void set_ls_moved_out_entity(number::Number *n);
   void set_ls_school_years_entity(number::Number *n);
   void set_ls_retirement_entity(number::Number *n);
@@ -742,6 +1319,9 @@ class LifeMatrix : public Component {
   light::LightState *status_led_{nullptr};
   sensor::Sensor *gol_final_generation_sensor_{nullptr};
   sensor::Sensor *gol_final_population_sensor_{nullptr};
+  sensor::Sensor *input_latency_sensor_{nullptr};
+  sensor::Sensor *sleep_cpu_saved_sensor_{nullptr};
+  sensor::Sensor *heap_fragmentation_sensor_{nullptr};
 
   // Colors
   Color color_active_{255, 255, 255};
@@ -764,26 +1344,49 @@ class LifeMatrix : public Component {
   MarkerColor marker_color_{MARKER_BLUE};
 
   // Year view configuration
-  std::vector<YearEvent> year_events_;
+  InlineVector<YearEvent, LIFE_MATRIX_MAX_YEAR_EVENTS> year_events_;
+#ifndef LIFE_MATRIX_NO_YEAR
+  uint8_t year_day_flags_[13][32]{};  // [month 1-12][day 1-31] YEAR_DAY_* bits
+  int year_days_year_{-1};            // year the flags were built for, -1 = stale
+#endif
   DayFillStyle day_fill_style_{DAY_FILL_MIXED};
   YearEventStyle year_event_style_{YEAR_EVENT_MARKERS};
 
+  // Geometry tables for the current display + viewport (see update_layout())
+  ViewLayout layout_;
+#ifndef LIFE_MATRIX_NO_DAY
+  std::vector<uint8_t> day_row_type_;      // per-frame scratch, sized with the layout
+  std::vector<float> day_life_progress_;
+#endif
+
   // Screen management
-  switch_::Switch *screen_switches_[8]{nullptr};
-  std::vector<ScreenConfig> screens_;
-  std::vector<int> enabled_screen_ids_;
+  switch_::Switch *screen_switches_[SCREEN_COUNT]{nullptr};
+  InlineVector<ScreenConfig, SCREEN_COUNT> screens_;
+  InlineVector<int, SCREEN_COUNT> enabled_screen_ids_;
   int current_screen_idx_{0};
   unsigned long last_switch_time_{0};
 
   // Rendering helpers
+  void render_screen_(display::Display &it, int screen_id, ESPTime &time, const Viewport &vp);
   Viewport calculate_viewport(display::Display &it);
+  const ViewLayout &update_layout(display::Display &it, const Viewport &vp);
   void render_year_view(display::Display &it, ESPTime &time, int viz_y, int viz_height);
   void render_month_view(display::Display &it, ESPTime &time, int viz_y, int viz_height);
   void render_day_view(display::Display &it, ESPTime &time, int viz_y, int viz_height);
   void render_hour_view(display::Display &it, ESPTime &time, int viz_y, int viz_height);
+#ifndef LIFE_MATRIX_NO_GOL
   void render_game_of_life(display::Display &it, int viz_y, int viz_height);
+  void render_big_bang_animation(display::Display &it, int viz_y, int viz_height);
+#endif
   void render_lifespan_view(display::Display &it, ESPTime &time, int viz_y, int viz_height);
-
+#ifndef LIFE_MATRIX_NO_HABITS
+  void render_habits_view(display::Display &it, ESPTime &time, const Viewport &vp);
+#endif
+#ifndef LIFE_MATRIX_NO_SENSORS
+  void render_sensor_graph_view(display::Display &it, const Viewport &vp);
+#endif
+
+#ifndef LIFE_MATRIX_NO_POMODORO
   // Pomodoro rendering
   void render_pomodoro_view(display::Display &it, ESPTime &time, Viewport vp);
   void render_exercise_snack_overlay(display::Display &it);
@@ -792,21 +1395,28 @@ class LifeMatrix : public Component {
   void render_pomodoro_blocks(display::Display &it, Viewport vp);
   void advance_pomodoro_phase();
   void update_pomodoro();
+#endif
 
   // Lifespan helpers
   void apply_lifespan_year_events();
   void precompute_lifespan_phases();
+#ifndef LIFE_MATRIX_NO_LIFESPAN
   void update_lifespan_phase_cycle();
-  uint16_t get_active_phases(int age, int row_year) const;
-  Color blend_phase_colors(uint16_t phase_mask) const;
+  void precompute_lifespan_zoom_();
+  void render_lifespan_zoom_view_(display::Display &it, ESPTime &time, int viz_y, int viz_height, int highlighted_phase);
+  void render_lifespan_text_(display::Display &it, ESPTime &time, int highlighted_phase);
+  Color lifespan_base_color_(const LifePhaseSegment *seg, int age, int highlighted_phase);
+#endif
+  const LifePhaseSegment *phase_segment_at(int age) const;
+  uint64_t get_active_phases(int age) const;
+  Color blend_phase_colors(uint64_t phase_mask) const;
   Color get_phase_color(int phase) const;
   const char *get_phase_short_name(int phase) const;
   LifeDate parse_life_date(const std::string &s) const;
   LifeRange parse_life_range(const std::string &s) const;
-  void parse_comma_dates(const std::string &s, std::vector<LifeDate> &out) const;
-  void parse_comma_ranges(const std::string &s, std::vector<LifeRange> &out) const;
+  void parse_comma_dates(const std::string &s, LifeDateList &out) const;
+  void parse_comma_ranges(const std::string &s, LifeRangeList &out) const;
   int compute_doy(int year, int month, int day) const;
-  void render_big_bang_animation(display::Display &it, int viz_y, int viz_height);
   void render_ui_overlays(display::Display &it);
   void check_celebration(ESPTime &time);
   void render_celebration_overlay(display::Display &it, uint32_t elapsed_ms);
@@ -816,6 +1426,49 @@ class LifeMatrix : public Component {
   uint32_t get_celeb_duration(CelebrationStyle style);
   // draw_pixel: routes main-display pixels through the active per-frame color transform (CTM_HUE_SHIFT)
   void draw_pixel(display::Display &it, int x, int y, Color c);
+  Color apply_color_transform(Color c) const;
+  // Palette render: begin clears the index canvas, present resolves the palette and blits it
+  void palette_begin_(display::Display &it);
+  void configure_canvas_(display::Display &it);
+  bool palette_put_(int x, int y, Color c, bool raw);  // false: off the canvas or palette full
+  void palette_present_();
+  display::Display &direct_(display::Display &it);  // the canvas's text front while a palette frame is open
+  // Overlay pixel without the color transform, still counted by the power estimator
+  void draw_raw_pixel_(display::Display &it, int x, int y, Color c);
+  // Adds a pixel written straight to the panel to the frame's channel sum
+  void power_note_(display::Display &it, Color c);
+  void finish_frame_();
+  void power_frame_();
+  void power_apply_();
+  void update_snapshot_();
+  // Live input: drain the socket, blit payloads, present on push, time out
+  void poll_live_();
+  void live_packet_(const uint8_t *pkt, int len, uint32_t recv_us);
+  void live_blit_(uint32_t pixel_offset, const uint8_t *rgb, uint32_t pixels);
+  void live_present_();
+  void enter_live_();
+  void exit_live_();
+  void start_celebration_();
+#ifdef USE_LIFE_MATRIX_SOAK
+  void soak_step_();
+  void soak_advance_clock_();
+  void soak_set_screen_(int screen_id, bool enabled);
+  void soak_report_();
+#endif
+#ifndef LIFE_MATRIX_NO_GOL
+  // Soup search: task body (off the main loop), result merge + NVS persistence in loop()
+  static void soup_task_(void *arg);
+  void soup_search_run_();
+  void update_soup_search_();
+  bool seed_soup_from_table_();
+  void soup_search_start_();
+  // GoL rewind: record the current generation, seek the view to one, move the scrub position
+  void rewind_clear_();
+  void rewind_push_();
+  bool rewind_seek_(int gen);
+  void rewind_scrub_(int delta);
+#endif
+  int palette_intern_(Color c, bool raw);
   Color get_complementary_color(Color c);
   Color hsv_to_rgb(int hue, float saturation, float value);
   Color get_gradient_color(float progress);
@@ -827,6 +1480,7 @@ class LifeMatrix : public Component {
 
   // Year view helpers
   void parse_year_events(const std::string &events_str);
+  void prepare_year_days_(int year);
   int day_of_week_sakamoto(int y, int m, int d);
   void get_days_in_month(int year, uint8_t days_out[12]);
   Color get_activity_color(int month_idx, int activity_type, bool use_scheme_color);
@@ -834,9 +1488,30 @@ class LifeMatrix : public Component {
   uint8_t get_activity_type(int pixel_y, int month_h, bool is_weekend);
 
  protected:
-  // Game of Life state
-  std::array<uint8_t, GRID_SIZE> game_grid_{};       // Age of each cell (0 = dead)
-  std::array<uint8_t, GRID_SIZE> game_grid_back_{};  // Back buffer for updates
+  // Screen plugins, defined in the .cpp; nested so they can drive the view code
+  class ViewScreen;
+  class YearScreen;
+  class MonthScreen;
+  class DayScreen;
+  class HourScreen;
+  class HabitsScreen;
+  class LifespanScreen;
+  class GolScreen;
+  class PomodoroScreen;
+  class SensorsScreen;
+  std::unique_ptr<Screen> create_screen_(int screen_id);
+  Screen *find_screen_(int screen_id);
+
+  // Game of Life state (grids are allocated by the GoL screen while it is enabled)
+#ifndef LIFE_MATRIX_NO_GOL
+  HotVector<uint8_t> game_grid_;       // Age of each cell (0 = dead), grid_width_ stride
+  HotVector<uint8_t> game_grid_back_;  // Back buffer for updates
+  std::vector<PatternPlacement> pattern_library_;
+  void begin_world_();
+  void step_game_of_life_(unsigned long now);
+  // Hidden GoL: missed generations are replayed on return, bounded by a µs budget
+  void catch_up_game_of_life_(uint32_t hidden_ms);
+#endif
   bool game_initialized_{false};
   unsigned long game_last_update_{0};
   unsigned long game_start_time_{0};
@@ -856,6 +1531,39 @@ class LifeMatrix : public Component {
   bool game_reset_animation_{false};
   unsigned long game_reset_animation_start_{0};
   GameOfLifeConfig game_config_{200, true, true, 60000, false};
+  unsigned long gol_hidden_ms_{0};
+
+  // Low-latency input: dirty flag + input-to-frame latency window (reported every 10 s)
+  bool redraw_requested_{false};
+  bool input_pending_{false};
+  uint32_t input_event_us_{0};
+  uint32_t input_latency_sum_us_{0};
+  uint32_t input_latency_max_us_{0};
+  uint16_t input_latency_samples_{0};
+  uint16_t oob_redraws_{0};
+  uint32_t input_latency_window_ms_{0};
+
+  // Heap report: free internal heap vs its largest block, once a minute
+  void report_heap_();
+  void report_placement_();
+  uint32_t heap_report_ms_{0};
+
+  // Display sleep state + busy-time accounting (loop + render µs) for the CPU-saved report
+  bool update_sleep_();
+  bool note_user_input_();
+  bool in_sleep_window_(const ESPTime &t) const;
+  void enter_sleep_();
+  void exit_sleep_();
+  bool sleep_schedule_{false};
+  bool sleep_now_{false};
+  bool sleeping_{false};
+  bool sleep_wake_requested_{false};
+  uint32_t sleep_checked_ms_{0};
+  uint32_t sleep_last_input_ms_{0};
+  uint32_t sleep_start_ms_{0};
+  uint64_t busy_us_{0};
+  uint32_t busy_window_ms_{0};
+  float awake_busy_us_per_s_{0.0f};
 
   // UI state
   UIMode ui_mode_{AUTO_CYCLE};
@@ -882,33 +1590,168 @@ class LifeMatrix : public Component {
   ColorTransformMode ctm_{CTM_NONE};
   float hue_mat_a_{1.f}, hue_mat_b_{0.f}, hue_mat_c_{0.f};  // identity by default
 
+  // Screen transitions: outgoing and incoming frames rendered off-screen, then blended.
+  // The outgoing frame is rendered once when the transition starts and then held.
+  void start_transition_(int from_screen_id, int direction);
+  bool render_transition_(display::Display &it, ESPTime &time, const Viewport &vp);
+  void blit565_(display::Display &it, int y, int rows, const uint16_t *px);
+  TransitionStyle transition_style_{TRANSITION_NONE};
+  TransitionEasing transition_easing_{EASE_IN_OUT};
+  uint32_t transition_duration_ms_{400};
+  bool transition_active_{false};
+  int transition_from_screen_{-1};
+  bool transition_from_ready_{false};          // transition_from_ holds the outgoing frame
+  int8_t transition_dir_{1};                   // +1 = next (new frame enters from below), -1 = prev
+  uint32_t transition_start_ms_{0};
+  FrameCanvas transition_from_;
+  FrameCanvas transition_to_;
+
+  // Switch pre-warm: within the last frame period before an auto-cycle switch the next
+  // screen is prepared, and with transitions on also rendered once into transition_to_
+  // (unused between transitions), so its caches and lazy loads are settled before its first
+  // visible frame. prewarm_pass_ is set meanwhile; views then leave demo timers and phase
+  // cycles to the visible frame.
+  // Switch frames are timed against steady frames.
+  void update_prewarm_();
+  bool prewarm_screens_{true};
+  bool prewarm_pass_{false};
+  int prewarmed_screen_{-1};
+  uint32_t last_render_ms_{0};
+  uint32_t frame_period_ms_{0};      // EMA of render() intervals
+  int last_frame_screen_{-1};
+  uint32_t steady_frame_us_{0};      // EMA of non-switch, non-transition frames
+  uint32_t switch_frame_sum_us_{0};
+  uint32_t switch_frame_max_us_{0};
+  uint8_t switch_frames_{0};
+  uint8_t switch_frames_warm_{0};
+
+  // Font-engine front of the palette canvas: direct_() hands it out while a frame is open,
+  // so text lands in the canvas as raw slots; after an overflow it writes to the panel
+  class PaletteText : public display::Display {
+   public:
+    explicit PaletteText(LifeMatrix *lm) : lm_(lm) {}
+    void draw_pixel_at(int x, int y, Color color) override { lm_->draw_raw_pixel_(*lm_->palette_target_, x, y, color); }
+    display::DisplayType get_display_type() override { return display::DisplayType::DISPLAY_TYPE_COLOR; }
+    void update() override {}
+
+   protected:
+    int get_width_internal() override { return lm_->canvas_lw_; }
+    int get_height_internal() override { return lm_->canvas_lh_; }
+
+    LifeMatrix *lm_;
+  };
+
+  // Palette-indexed render state (one index byte per pixel instead of per-pixel RGB)
+  bool palette_render_{false};
+  bool palette_frame_active_{false};                     // between palette_begin_() and palette_present_()
+  bool palette_frame_whole_{false};                      // the canvas holds the last presented frame
+  display::Display *palette_target_{nullptr};            // panel the open frame presents to
+  PaletteText palette_text_{this};
+  HotVector<uint8_t> palette_index_buf_;                 // canvas_lw_ × canvas_lh_, canvas_w_ stride, 0 = untouched
+  uint32_t palette_[PALETTE_SIZE]{};                     // 0xRRGGBB; bit 24 marks a raw slot until present resolves it
+  uint16_t palette_count_{1};                            // next free slot (slot 0 reserved)
+  uint8_t palette_hash_[PALETTE_HASH_SIZE]{};            // color → slot, 0 = empty; cleared per frame
+  uint32_t palette_last_key_{UINT32_MAX};                // run cache: views draw long same-color spans
+  uint8_t palette_last_idx_{0};
+  // Canvas geometry: index = origin + x*step_x + y*step_y; row cy of the canvas is
+  // native panel row canvas_ny0_+cy starting at column canvas_nx0_. The logical size
+  // follows layout_, so the canvas covers the whole display.
+  bool native_canvas_{true};
+  bool canvas_native_{false};
+  display::DisplayRotation canvas_rotation_{(display::DisplayRotation) -1};  // forces first configure
+  int canvas_lw_{0};  // logical width x height, 0 until the first frame
+  int canvas_lh_{0};
+  int canvas_w_{GRID_WIDTH};
+  int canvas_h_{GRID_HEIGHT};
+  int canvas_nx0_{0};
+  int canvas_ny0_{0};
+  int canvas_origin_{0};
+  int canvas_step_x_{1};
+  int canvas_step_y_{GRID_WIDTH};
+
+#ifndef LIFE_MATRIX_NO_HABITS
+  // Habit tracker state
+  FixedLabel habit_names_[HABIT_MAX];
+  uint8_t habit_count_{0};
+  int8_t habit_selected_{-1};                                 // -1 = overview of all habits
+  ColdVector<uint32_t> habit_bits_;                           // [slot][habit][word], empty until first use
+  int16_t habit_slot_year_[HABIT_YEARS]{};                    // year held by each slot, 0 = empty
+  uint8_t habit_dirty_[HABIT_YEARS]{};                        // per-slot bitmask of habits to persist
+  uint32_t *habit_slot_bits_(int slot, int habit) {
+    return &habit_bits_[((size_t)slot * habit_count_ + habit) * HABIT_WORDS];
+  }
+  uint32_t *habit_year_bits_(int habit, int year);
+  void habit_save_();
+  void habit_release_();  // saves pending years and frees the bits
+#endif
+
+#ifndef LIFE_MATRIX_NO_SENSORS
+  // Sensor graph state
+  std::vector<SensorSeries> graphs_;
+  uint8_t graph_selected_{0};
+#endif
+
   // Lifespan view state
   LifespanConfig lifespan_config_{};
-  std::vector<YearEvent> lifespan_year_events_;   // birthdays extracted from lifespan config
-  std::vector<int> lifespan_active_phases_;        // phases that have active years (for cycling)
+  InlineVector<YearEvent, LIFE_MATRIX_MAX_YEAR_EVENTS> lifespan_year_events_;  // birthdays from lifespan config
+  InlineVector<int, LIFESPAN_MAX_PHASES> lifespan_active_phases_;     // phases that have active years (for cycling)
+  InlineVector<LifePhaseDef, LIFESPAN_MAX_PHASES> lifespan_phase_defs_;  // indexed by phase id
+  std::vector<LifePhaseSegment> lifespan_segments_;    // sorted by start_age, gap-free from age 0
   int  lifespan_highlighted_phase_{-1};            // -1 = no highlight
   uint8_t lifespan_phase_idx_{0};                  // index into lifespan_active_phases_
   uint32_t lifespan_phase_changed_ms_{0};
-
+#ifndef LIFE_MATRIX_NO_LIFESPAN
+  LifespanZoomTable lifespan_zoom_tables_[LS_ZOOM_COUNT];  // YEARS renders directly, its table stays empty
+  std::vector<LifePhaseSpan> lifespan_spans_;              // date-resolved phase intervals
+  std::vector<LifePhaseSegment> lifespan_zoom_segs_;       // distinct phase sets of zoom cells
+  uint8_t lifespan_zoom_{LS_ZOOM_YEARS};
+  uint32_t lifespan_zoom_changed_ms_{0};
+#endif
+
+  // Pomodoro settings
+  PomodoroPreset pomo_preset_{POMO_PRESET_CLASSIC};
+  int pomo_rounds_before_long_break_{4};
+  bool exercise_snacks_enabled_{true};
+#ifndef LIFE_MATRIX_NO_POMODORO
   // Pomodoro state
   PomodoroPhase pomo_phase_{POMO_IDLE};
-  PomodoroPreset pomo_preset_{POMO_PRESET_CLASSIC};
   unsigned long pomo_phase_start_ms_{0};
   bool pomo_paused_{false};
   unsigned long pomo_pause_start_ms_{0};
   unsigned long pomo_paused_total_ms_{0};
   int pomo_completed_rounds_{0};
-  int pomo_rounds_before_long_break_{4};
   int pomo_session_elapsed_at_phase_start_sec_{0};
   unsigned long pomo_work_done_anim_end_ms_{0};
   ExerciseSnackState exercise_snack_;
-  bool exercise_snacks_enabled_{true};
-  std::vector<std::string> exercise_list_;
-  select::Select *ha_pomo_preset_{nullptr};
-  number::Number *ha_pomo_rounds_{nullptr};
-  switch_::Switch *ha_exercise_snacks_{nullptr};
+  InlineVector<FixedLabel, LIFE_MATRIX_MAX_EXERCISES> exercise_list_;
   text_sensor::TextSensor *pomo_event_sensor_{nullptr};
   text_sensor::TextSensor *pomo_exercise_sensor_{nullptr};
+
+  // Block fill order (clockwise perimeter spiral), built for the current block size and
+  // released with the pomodoro screen
+  ColdVector<uint16_t> pomo_spiral_x_;  // read sequentially once per frame
+  ColdVector<uint16_t> pomo_spiral_y_;
+  int pomo_spiral_w_{-1};
+  int pomo_spiral_h_{-1};
+
+  // Pomodoro session log + aggregates
+  void pomo_end_session_();
+  PomoLogCache &pomo_log_();  // loads the cache on first use
+  void pomo_log_release_();
+  void pomo_log_load_();
+  void pomo_log_append_(const PomoSessionRecord &rec);
+  void pomo_agg_add_(const PomoSessionRecord &rec);
+  void pomo_agg_catch_up_();
+  int pomo_week_index_(int year, int doy);
+  uint32_t pomo_session_start_epoch_{0};
+  int pomo_session_focus_sec_{0};
+  uint8_t pomo_session_snacks_{0};
+  uint32_t pomo_log_head_{0};                                    // records ever appended
+  uint32_t pomo_agg_saved_head_{0};                              // aggregates' head last persisted
+  ColdVector<PomoLogCache> pomo_log_cache_;                      // one entry while loaded
+  bool pomo_heatmap_{false};
+#endif
+
   // Time override for testing
   bool time_override_active_{false};
   ESPTime fake_time_{};
@@ -919,29 +1762,122 @@ class LifeMatrix : public Component {
   int night_mode_level_{0};
   uint8_t last_brightness_hour_{255};
   std::function<void(uint8_t)> brightness_fn_;
-
-  // HA entity pointers for bidirectional sync
-  switch_::Switch *ha_complex_patterns_{nullptr};
-  select::Select *ha_conway_speed_{nullptr};
-  select::Select *ha_style_{nullptr};
-  select::Select *ha_gradient_type_{nullptr};
-  select::Select *ha_fill_direction_{nullptr};
-  select::Select *ha_marker_style_{nullptr};
-  select::Select *ha_marker_color_{nullptr};
-  select::Select *ha_text_area_position_{nullptr};
-  select::Select *ha_day_fill_{nullptr};
-  select::Select *ha_year_event_style_{nullptr};
-  number::Number *ha_bed_time_hour_{nullptr};
-  number::Number *ha_work_start_hour_{nullptr};
-  number::Number *ha_work_end_hour_{nullptr};
-  number::Number *ha_cycle_time_{nullptr};
-  number::Number *ha_display_brightness_{nullptr};
-  number::Number *ha_night_mode_level_{nullptr};
-  switch_::Switch *ha_show_future_{nullptr};
+  uint8_t brightness_target_{0};   // what apply_brightness() asked for
+  uint8_t brightness_applied_{0};  // what the panel got after the power limit
+
+  display::Display *frame_target_{nullptr};  // the real panel; transition canvases don't count
+
+  // Power limiter
+  bool power_limit_enabled_{false};
+  bool power_limiting_{false};
+  uint32_t power_sum_{0};  // Σ(r+g+b) of the presented frame
+  float power_max_ma_{0.0f};
+  float power_channel_ma_{0.6f};
+  float power_idle_ma_{0.0f};
+  uint32_t power_report_ms_{0};
+  sensor::Sensor *power_current_sensor_{nullptr};
+
+  // Snapshot double buffer: loop() encodes into the back slot, then publishes it.
+  // Web requests copy the front slot out under snapshot_readers_; no slot is re-encoded
+  // while a copy is in progress, so a published buffer is never torn or freed under a reader.
+  bool snapshot_enabled_{false};
+  uint32_t snapshot_interval_ms_{5000};
+  uint32_t snapshot_encoded_ms_{0};
+  std::atomic<uint32_t> snapshot_requested_ms_{0};
+  std::atomic<int> snapshot_front_{-1};
+  std::atomic<int> snapshot_readers_{0};
+  ColdVector<uint8_t> snapshot_png_[2];
+
+  // Live input state + packet-to-pixel latency / loss window (reported every 10 s)
+#ifdef USE_LIFE_MATRIX_LIVE
+  std::unique_ptr<socket::Socket> live_socket_;
+#endif
+  LiveProtocol live_protocol_{LIVE_DDP};
+  uint16_t live_port_{0};
+  uint16_t live_universe_{1};
+  uint32_t live_timeout_ms_{2000};
+  uint32_t live_open_ms_{0};              // last socket open attempt (retried until the network is up)
+  bool live_active_{false};
+  uint32_t live_last_packet_ms_{0};
+  std::vector<uint8_t> live_packet_buf_;
+  uint32_t live_frame_start_us_{0};       // first packet of the frame being assembled, 0 = none
+  bool live_frame_lossy_{false};
+  uint8_t live_ddp_seq_{0};
+  uint8_t live_e131_seq_[LIVE_E131_MAX_UNIVERSES]{};
+  uint64_t live_e131_seen_{0};            // universes with a valid sequence number
+  uint32_t live_frames_{0};
+  uint32_t live_frames_dropped_{0};
+  uint32_t live_packets_lost_{0};
+  uint32_t live_latency_sum_us_{0};
+  uint32_t live_latency_max_us_{0};
+  uint32_t live_window_ms_{0};
+  sensor::Sensor *live_latency_sensor_{nullptr};
+  sensor::Sensor *live_dropped_sensor_{nullptr};
+
+#ifdef USE_LIFE_MATRIX_SOAK
+  uint32_t soak_step_ms_{1000};
+  uint32_t soak_report_ms_{60000};
+  uint32_t soak_steps_{0};
+  uint32_t soak_step_at_ms_{0};
+  uint32_t soak_window_ms_{0};
+  uint32_t soak_reports_{0};
+  uint64_t soak_frames_{0};
+  size_t soak_base_free_{0};              // first window, for heap deltas
+  size_t soak_base_largest_{0};
+  uint32_t soak_wall_start_s_{0};         // wall clock (SNTP) and millis() when it was first valid
+  uint32_t soak_wall_start_ms_{0};
+  int soak_year_{0};                      // accelerated display clock, fed to the time override
+  int soak_month_{1};
+  int soak_day_{1};
+  int soak_minutes_{0};
+  int soak_disabled_screen_{-1};
+  LatencyHistogram soak_loop_hist_;
+  LatencyHistogram soak_render_hist_;
+#endif
+
+#ifndef LIFE_MATRIX_NO_GOL
+  // Soup search: the task posts one result at a time; loop() owns the table
+  bool soup_search_{false};
+  bool soup_task_started_{false};  // the task is never deleted; start at most once
+  SoupTable soup_table_{};
+  bool soup_table_dirty_{false};
+  uint32_t soup_saved_ms_{0};
+  uint32_t soup_report_ms_{0};
+  uint32_t soup_report_count_{0};
+  std::atomic<bool> soup_paused_{false};
+  std::atomic<bool> soup_result_ready_{false};
+  std::atomic<uint32_t> soup_floor_{0};   // packed score a result must beat to be posted
+  std::atomic<uint32_t> soups_tested_{0};
+  SoupSeed soup_result_{};
+  sensor::Sensor *soup_rate_sensor_{nullptr};
+
+  // GoL rewind history (rewind_bytes_ covers segments and the packed/age work buffers)
+  uint32_t rewind_cap_{0};
+  uint32_t rewind_bytes_{0};
+  uint32_t rewind_report_ms_{0};
+  std::vector<RewindSegment> rewind_segments_;
+  // Work buffers are walked every generation or scrub frame; only segment data is cold
+  HotVector<uint8_t> rewind_last_;    // newest generation, packed (delta base)
+  HotVector<uint8_t> rewind_pack_;    // generation being recorded, packed
+  HotVector<uint8_t> rewind_view_;    // generation being shown while scrubbing, packed
+  HotVector<uint8_t> rewind_ages_;    // its cell ages, game_grid_ layout
+  int rewind_gen_{-1};
+  int rewind_view_gen_{-1};
+  size_t rewind_view_pos_{0};          // offset of the record after rewind_view_gen_
+#endif
+
+  // Settings rows bound to HA entities (kind per SETTING_TABLE[id].kind)
+  EntityBase *setting_entities_[SET_COUNT]{};
+  char setting_value_buf_[16]{};
+  bool bind_setting_entity_(SettingID id, EntityBase *e, SettingKind kind);
+  int menu_setting_count_(int screen_id) const;
+  SettingID menu_setting_at_(int screen_id, int cursor) const;
 
   // Non-lifespan entities needing initial-value publish
   text::Text *year_events_entity_{nullptr};
+#ifndef LIFE_MATRIX_NO_POMODORO
   text::Text *exercise_list_entity_{nullptr};
+#endif
 
   // Lifespan entities (stored for NVS restoration)
   text::Text *ls_birthday_entity_{nullptr};
@@ -951,6 +1887,7 @@ class LifeMatrix : public Component {
   text::Text *ls_milestones_entity_{nullptr};
   text::Text *ls_partner_ranges_entity_{nullptr};
   text::Text *ls_marriage_ranges_entity_{nullptr};
+  text::Text *ls_custom_phases_entity_{nullptr};
   number::Number *ls_moved_out_entity_{nullptr};
   number::Number *ls_school_years_entity_{nullptr};
   number::Number *ls_retirement_entity_{nullptr};
@@ -960,12 +1897,9 @@ class LifeMatrix : public Component {
   // Helper to restore lifespan entities from NVS
   void restore_lifespan_entities_from_nvs_();
 
-  // Icon registry: maps icon_id string to animated icon data
-  std::map<std::string, IconData> icon_registry_;
-
-  // Icon animation state: tracks current frame for each animated icon
-  std::map<std::string, uint8_t> icon_current_frame_;
-  std::map<std::string, uint32_t> icon_last_frame_time_;
+  // Icon registry: animated icon data and frame state, looked up by icon_id
+  InlineVector<IconData, LIFE_MATRIX_MAX_ICONS> icons_;
+  IconData *find_icon_(const std::string &icon_id);
 };
 
 }  // namespace life_matrix
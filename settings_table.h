@@ -0,0 +1,105 @@
+// Generated by settings_table.py from its SETTINGS rows; edit those and rerun it.
+#pragma once
+
+#include <cstdint>
+
+namespace esphome {
+namespace life_matrix {
+
+enum SettingID : uint8_t {
+  SET_BRIGHTNESS = 0,
+  SET_CYCLE_TIME,
+  SET_TEXT_AREA,
+  SET_STYLE,
+  SET_GRADIENT,
+  SET_FILL_DIRECTION,
+  SET_MARKER_STYLE,
+  SET_MARKER_COLOR,
+  SET_DAY_FILL,
+  SET_YEAR_EVENTS,
+  SET_BED_HOUR,
+  SET_WAKE_HOUR,
+  SET_WORK_START,
+  SET_WORK_END,
+  SET_GOL_SPEED,
+  SET_GOL_COMPLEX,
+  SET_POMO_PRESET,
+  SET_POMO_ROUNDS,
+  SET_EXERCISE_SNACKS,
+  SET_SHOW_FUTURE,
+  SET_NIGHT_MODE,
+  SET_SLEEP_SCHEDULE,
+  SET_SLEEP_NOW,
+  SET_COUNT
+};
+
+enum SettingKind : uint8_t {
+  SETTING_SELECT = 0,  // value = option index
+  SETTING_SWITCH = 1,  // value = 0 / 1
+  SETTING_NUMBER = 2,  // value = integer in [min_value, max_value]
+};
+
+struct SettingDesc {
+  SettingID id;
+  SettingKind kind;
+  const char *label;               // menu label, 5 glyphs max
+  const char *object_id;           // HA object id
+  const char *nvs_key;             // NVS key of the bound entity's value
+  int16_t min_value;
+  int16_t max_value;
+  int8_t step;                     // per encoder detent
+  bool wrap;
+  const char *const *options;      // SELECT: HA option strings, max_value + 1 of them
+  const char *const *short_names;  // SELECT / SWITCH: menu value text
+  const char *value_fmt;           // NUMBER: menu value format
+};
+
+inline constexpr const char *OPT_TEXT_AREA[] = {"Top", "Bottom", "None"};
+inline constexpr const char *OPT_STYLE[] = {"Single Color", "Gradient", "Time Segments", "Rainbow"};
+inline constexpr const char *SHORT_STYLE[] = {"Singl", "Gradt", "TmSeg", "Rainb"};
+inline constexpr const char *OPT_GRADIENT[] = {"Red-Blue", "Green-Yellow", "Cyan-Magenta", "Purple-Orange", "Blue-Yellow"};
+inline constexpr const char *SHORT_GRADIENT[] = {"RedBl", "GrnYl", "CynMg", "PurOr", "BluYl"};
+inline constexpr const char *OPT_FILL_DIRECTION[] = {"Bottom to Top", "Top to Bottom"};
+inline constexpr const char *SHORT_FILL_DIRECTION[] = {"BotT", "TopB"};
+inline constexpr const char *OPT_MARKER_STYLE[] = {"None", "Single Dot", "Gradient Peak"};
+inline constexpr const char *SHORT_MARKER_STYLE[] = {"None", "Dot", "Peak"};
+inline constexpr const char *OPT_MARKER_COLOR[] = {"Blue", "White", "Yellow", "Red", "Green", "Cyan", "Magenta"};
+inline constexpr const char *SHORT_MARKER_COLOR[] = {"Blue", "White", "Yellw", "Red", "Green", "Cyan", "Magnt"};
+inline constexpr const char *OPT_DAY_FILL[] = {"Fixed", "Flat", "Shaded"};
+inline constexpr const char *SHORT_DAY_FILL[] = {"Fixed", "Flat", "Shade"};
+inline constexpr const char *OPT_YEAR_EVENTS[] = {"None", "Pulse", "Markers"};
+inline constexpr const char *SHORT_YEAR_EVENTS[] = {"None", "Pulse", "Marks"};
+inline constexpr const char *OPT_GOL_SPEED[] = {"Fast (50ms)", "Normal (200ms)", "Slow (1000ms)"};
+inline constexpr const char *SHORT_GOL_SPEED[] = {"Fast", "Norml", "Slow"};
+inline constexpr const char *OPT_POMO_PRESET[] = {"Classic (25/5)", "Deep Work (50/10)", "Ultradian (90/20)"};
+inline constexpr const char *SHORT_POMO_PRESET[] = {"25-5", "50-10", "90-20"};
+inline constexpr const char *SHORT_ON_OFF[] = {"Off", "On"};
+
+inline constexpr SettingDesc SETTING_TABLE[SET_COUNT] = {
+  {SET_BRIGHTNESS, SETTING_NUMBER, "Brite", "display_brightness", "81EFF278", 1, 100, 5, false, nullptr, nullptr, "%d%%"},
+  {SET_CYCLE_TIME, SETTING_NUMBER, "Cycle", "cycle_time_s", "9FD1145C", 1, 60, 1, false, nullptr, nullptr, "%ds"},
+  {SET_TEXT_AREA, SETTING_SELECT, "Text", "text_area_position", "9C74E0C1", 0, 2, 1, true, OPT_TEXT_AREA, OPT_TEXT_AREA, nullptr},
+  {SET_STYLE, SETTING_SELECT, "Style", "style", "4A531A93", 0, 3, 1, true, OPT_STYLE, SHORT_STYLE, nullptr},
+  {SET_GRADIENT, SETTING_SELECT, "Grad", "gradient_type", "4D21C047", 0, 4, 1, true, OPT_GRADIENT, SHORT_GRADIENT, nullptr},
+  {SET_FILL_DIRECTION, SETTING_SELECT, "Fill", "fill_direction", "0ED454EF", 0, 1, 1, true, OPT_FILL_DIRECTION, SHORT_FILL_DIRECTION, nullptr},
+  {SET_MARKER_STYLE, SETTING_SELECT, "Mark", "marker_style", "867B5DFA", 0, 2, 1, true, OPT_MARKER_STYLE, SHORT_MARKER_STYLE, nullptr},
+  {SET_MARKER_COLOR, SETTING_SELECT, "MkClr", "marker_color", "FBC64780", 0, 6, 1, true, OPT_MARKER_COLOR, SHORT_MARKER_COLOR, nullptr},
+  {SET_DAY_FILL, SETTING_SELECT, "DFill", "day_fill", "27678AE4", 0, 2, 1, true, OPT_DAY_FILL, SHORT_DAY_FILL, nullptr},
+  {SET_YEAR_EVENTS, SETTING_SELECT, "Event", "year_event_style", "56907C6A", 0, 2, 1, true, OPT_YEAR_EVENTS, SHORT_YEAR_EVENTS, nullptr},
+  {SET_BED_HOUR, SETTING_NUMBER, "Bed", "bed_time_hour", "F9C623B6", 0, 23, 1, true, nullptr, nullptr, "%dh"},
+  {SET_WAKE_HOUR, SETTING_NUMBER, "Wake", "wake_time_hour", "B9A82B1D", 0, 23, 1, true, nullptr, nullptr, "%dh"},
+  {SET_WORK_START, SETTING_NUMBER, "WkBeg", "work_start_hour", "7656CD29", 0, 23, 1, true, nullptr, nullptr, "%dh"},
+  {SET_WORK_END, SETTING_NUMBER, "WkEnd", "work_end_hour", "C240D4BC", 0, 23, 1, true, nullptr, nullptr, "%dh"},
+  {SET_GOL_SPEED, SETTING_SELECT, "Speed", "conway_speed", "B062A07F", 0, 2, 1, true, OPT_GOL_SPEED, SHORT_GOL_SPEED, nullptr},
+  {SET_GOL_COMPLEX, SETTING_SWITCH, "Cmplx", "gol_complex_patterns", "C9628CD1", 0, 1, 1, true, nullptr, SHORT_ON_OFF, nullptr},
+  {SET_POMO_PRESET, SETTING_SELECT, "Prset", "pomodoro_preset", "C75A06C9", 0, 2, 1, true, OPT_POMO_PRESET, SHORT_POMO_PRESET, nullptr},
+  {SET_POMO_ROUNDS, SETTING_NUMBER, "Rnds", "pomodoro_rounds", "9D324C95", 2, 8, 1, true, nullptr, nullptr, "%d"},
+  {SET_EXERCISE_SNACKS, SETTING_SWITCH, "ExSnc", "exercise_snacks", "0A71AE78", 0, 1, 1, true, nullptr, SHORT_ON_OFF, nullptr},
+  {SET_SHOW_FUTURE, SETTING_SWITCH, "Futur", "show_future", "B9CB21B3", 0, 1, 1, true, nullptr, SHORT_ON_OFF, nullptr},
+  {SET_NIGHT_MODE, SETTING_NUMBER, "Night", "night_mode_level", "30F4618B", 0, 3, 1, false, nullptr, nullptr, "L%d"},
+  {SET_SLEEP_SCHEDULE, SETTING_SWITCH, "Sched", "sleep_schedule", "67680591", 0, 1, 1, true, nullptr, SHORT_ON_OFF, nullptr},
+  {SET_SLEEP_NOW, SETTING_SWITCH, "Sleep", "sleep_now", "3FDBD708", 0, 1, 1, true, nullptr, SHORT_ON_OFF, nullptr},
+};
+
+}  // namespace life_matrix
+}  // namespace esphome
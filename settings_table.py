@@ -0,0 +1,206 @@
+"""Settings rows shared by the firmware and __init__.py.
+
+One row per user setting, in SettingID order. settings_table.h (SettingID, the option
+strings, ranges, menu text and NVS keys as a constexpr table) is generated from SETTINGS;
+__init__.py reads the same rows for the HA entities and the option validators. After
+editing a row run
+
+    python3 settings_table.py
+
+and commit both files; to_code() stops the build while the header is stale.
+"""
+
+import os
+from typing import NamedTuple, Optional, Tuple
+
+HEADER = os.path.join(os.path.dirname(os.path.abspath(__file__)), "settings_table.h")
+
+SELECT = "SETTING_SELECT"
+SWITCH = "SETTING_SWITCH"
+NUMBER = "SETTING_NUMBER"
+
+# XORed into the object id hash for the entity's NVS key, as LMSelect / LMSwitch /
+# LMNumber do for entities without a settings row
+NVS_SALT = {SELECT: 0x4C53, SWITCH: 0x5753, NUMBER: 0x4E4D}
+
+ON_OFF = ("Off", "On")
+
+
+class Setting(NamedTuple):
+    id: str                       # SettingID enumerator
+    kind: str
+    label: str                    # menu label, 5 glyphs max
+    object_id: str                # HA object id
+    min_value: int
+    max_value: int
+    step: int                     # per encoder detent
+    wrap: bool
+    options: Tuple[str, ...] = ()      # SELECT: HA option strings
+    short_names: Tuple[str, ...] = ()  # SELECT / SWITCH: menu value text
+    value_fmt: str = ""                # NUMBER: menu value format
+    nvs_key: Optional[str] = None      # pinned NVS key; None = derived from object_id
+
+    @property
+    def key(self):
+        """NVS key of the row's value. Pin nvs_key to the old key when renaming object_id."""
+        if self.nvs_key is not None:
+            return self.nvs_key
+        h = 2166136261
+        for c in self.object_id.encode():
+            h = ((h * 16777619) & 0xFFFFFFFF) ^ c
+        return f"{h ^ NVS_SALT[self.kind]:08X}"
+
+
+def _select(id_, label, object_id, options, short_names=None):
+    return Setting(id_, SELECT, label, object_id, 0, len(options) - 1, 1, True,
+                   tuple(options), tuple(short_names or options))
+
+
+def _switch(id_, label, object_id):
+    return Setting(id_, SWITCH, label, object_id, 0, 1, 1, True, short_names=ON_OFF)
+
+
+def _number(id_, label, object_id, min_value, max_value, value_fmt, step=1, wrap=True):
+    return Setting(id_, NUMBER, label, object_id, min_value, max_value, step, wrap, value_fmt=value_fmt)
+
+
+SETTINGS = [
+    _number("SET_BRIGHTNESS", "Brite", "display_brightness", 1, 100, "%d%%", step=5, wrap=False),
+    _number("SET_CYCLE_TIME", "Cycle", "cycle_time_s", 1, 60, "%ds", wrap=False),
+    _select("SET_TEXT_AREA", "Text", "text_area_position", ["Top", "Bottom", "None"]),
+    _select("SET_STYLE", "Style", "style",
+            ["Single Color", "Gradient", "Time Segments", "Rainbow"],
+            ["Singl", "Gradt", "TmSeg", "Rainb"]),
+    _select("SET_GRADIENT", "Grad", "gradient_type",
+            ["Red-Blue", "Green-Yellow", "Cyan-Magenta", "Purple-Orange", "Blue-Yellow"],
+            ["RedBl", "GrnYl", "CynMg", "PurOr", "BluYl"]),
+    _select("SET_FILL_DIRECTION", "Fill", "fill_direction",
+            ["Bottom to Top", "Top to Bottom"], ["BotT", "TopB"]),
+    _select("SET_MARKER_STYLE", "Mark", "marker_style",
+            ["None", "Single Dot", "Gradient Peak"], ["None", "Dot", "Peak"]),
+    _select("SET_MARKER_COLOR", "MkClr", "marker_color",
+            ["Blue", "White", "Yellow", "Red", "Green", "Cyan", "Magenta"],
+            ["Blue", "White", "Yellw", "Red", "Green", "Cyan", "Magnt"]),
+    _select("SET_DAY_FILL", "DFill", "day_fill", ["Fixed", "Flat", "Shaded"], ["Fixed", "Flat", "Shade"]),
+    _select("SET_YEAR_EVENTS", "Event", "year_event_style",
+            ["None", "Pulse", "Markers"], ["None", "Pulse", "Marks"]),
+    _number("SET_BED_HOUR", "Bed", "bed_time_hour", 0, 23, "%dh"),
+    _number("SET_WAKE_HOUR", "Wake", "wake_time_hour", 0, 23, "%dh"),
+    _number("SET_WORK_START", "WkBeg", "work_start_hour", 0, 23, "%dh"),
+    _number("SET_WORK_END", "WkEnd", "work_end_hour", 0, 23, "%dh"),
+    _select("SET_GOL_SPEED", "Speed", "conway_speed",
+            ["Fast (50ms)", "Normal (200ms)", "Slow (1000ms)"], ["Fast", "Norml", "Slow"]),
+    _switch("SET_GOL_COMPLEX", "Cmplx", "gol_complex_patterns"),
+    _select("SET_POMO_PRESET", "Prset", "pomodoro_preset",
+            ["Classic (25/5)", "Deep Work (50/10)", "Ultradian (90/20)"], ["25-5", "50-10", "90-20"]),
+    _number("SET_POMO_ROUNDS", "Rnds", "pomodoro_rounds", 2, 8, "%d"),
+    _switch("SET_EXERCISE_SNACKS", "ExSnc", "exercise_snacks"),
+    _switch("SET_SHOW_FUTURE", "Futur", "show_future"),         # HA only, not in the menu
+    _number("SET_NIGHT_MODE", "Night", "night_mode_level", 0, 3, "L%d", wrap=False),  # HA only
+    _switch("SET_SLEEP_SCHEDULE", "Sched", "sleep_schedule"),   # HA only
+    _switch("SET_SLEEP_NOW", "Sleep", "sleep_now"),             # HA only
+]
+
+SETTINGS_BY_ID = {s.id: s for s in SETTINGS}
+
+
+def _check():
+    for attr in ("id", "object_id"):
+        values = [getattr(s, attr) for s in SETTINGS]
+        dup = {v for v in values if values.count(v) > 1}
+        assert not dup, f"duplicate {attr}: {sorted(dup)}"
+    keys = [s.key for s in SETTINGS]
+    assert len(set(keys)) == len(keys), "duplicate NVS key"
+    for s in SETTINGS:
+        assert len(s.label) <= 5, f"{s.id}: menu label '{s.label}' is longer than 5 glyphs"
+        assert 0 < len(s.key) <= 15, f"{s.id}: NVS key '{s.key}' must be 1..15 characters"
+        assert s.min_value <= s.max_value and -32768 <= s.min_value and s.max_value <= 32767, s.id
+        if s.kind == SELECT:
+            assert len(s.options) == len(s.short_names) == s.max_value + 1, s.id
+
+
+def _c_str(s):
+    return '"' + s.replace("\\", "\\\\").replace('"', '\\"') + '"'
+
+
+def _array_name(prefix, s):
+    return prefix + s.id[len("SET_"):]
+
+
+def render_header():
+    """Text of settings_table.h for the current SETTINGS."""
+    _check()
+    out = [
+        "// Generated by settings_table.py from its SETTINGS rows; edit those and rerun it.",
+        "#pragma once",
+        "",
+        "#include <cstdint>",
+        "",
+        "namespace esphome {",
+        "namespace life_matrix {",
+        "",
+        "enum SettingID : uint8_t {",
+    ]
+    for i, s in enumerate(SETTINGS):
+        out.append(f"  {s.id}{' = 0' if i == 0 else ''},")
+    out += ["  SET_COUNT", "};", ""]
+    out += [
+        "enum SettingKind : uint8_t {",
+        "  SETTING_SELECT = 0,  // value = option index",
+        "  SETTING_SWITCH = 1,  // value = 0 / 1",
+        "  SETTING_NUMBER = 2,  // value = integer in [min_value, max_value]",
+        "};",
+        "",
+        "struct SettingDesc {",
+        "  SettingID id;",
+        "  SettingKind kind;",
+        "  const char *label;               // menu label, 5 glyphs max",
+        "  const char *object_id;           // HA object id",
+        "  const char *nvs_key;             // NVS key of the bound entity's value",
+        "  int16_t min_value;",
+        "  int16_t max_value;",
+        "  int8_t step;                     // per encoder detent",
+        "  bool wrap;",
+        "  const char *const *options;      // SELECT: HA option strings, max_value + 1 of them",
+        "  const char *const *short_names;  // SELECT / SWITCH: menu value text",
+        "  const char *value_fmt;           // NUMBER: menu value format",
+        "};",
+        "",
+    ]
+    for s in SETTINGS:
+        if s.kind != SELECT:
+            continue
+        out.append(f"inline constexpr const char *{_array_name('OPT_', s)}[] = "
+                   f"{{{', '.join(_c_str(o) for o in s.options)}}};")
+        if s.short_names != s.options:
+            out.append(f"inline constexpr const char *{_array_name('SHORT_', s)}[] = "
+                       f"{{{', '.join(_c_str(o) for o in s.short_names)}}};")
+    out.append(f"inline constexpr const char *SHORT_ON_OFF[] = {{{', '.join(_c_str(o) for o in ON_OFF)}}};")
+    out += ["", "inline constexpr SettingDesc SETTING_TABLE[SET_COUNT] = {"]
+    for s in SETTINGS:
+        if s.kind == SELECT:
+            options = _array_name("OPT_", s)
+            short = _array_name("SHORT_", s) if s.short_names != s.options else options
+        else:
+            options = "nullptr"
+            short = "SHORT_ON_OFF" if s.kind == SWITCH else "nullptr"
+        fmt = _c_str(s.value_fmt) if s.kind == NUMBER else "nullptr"
+        out.append(f"  {{{s.id}, {s.kind}, {_c_str(s.label)}, {_c_str(s.object_id)}, {_c_str(s.key)}, "
+                   f"{s.min_value}, {s.max_value}, {s.step}, {'true' if s.wrap else 'false'}, "
+                   f"{options}, {short}, {fmt}}},")
+    out += ["};", "", "}  // namespace life_matrix", "}  // namespace esphome", ""]
+    return "\n".join(out)
+
+
+def header_is_current():
+    try:
+        with open(HEADER, encoding="utf-8") as f:
+            return f.read() == render_header()
+    except OSError:
+        return False
+
+
+if __name__ == "__main__":
+    with open(HEADER, "w", encoding="utf-8") as f:
+        f.write(render_header())
+    print(f"wrote {HEADER}")